@@ -0,0 +1,167 @@
+#ifndef __BasicUploadQueue
+#define __BasicUploadQueue
+
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <utility>
+#include <cstddef>
+
+namespace gfx {
+
+struct GFXUploadCounters {
+    std::size_t nStaged;    // writes staged
+    std::size_t nUpload;    // writes issued to the context, once merged
+    std::size_t nByte;      // bytes issued
+
+    GFXUploadCounters& operator+=(const GFXUploadCounters& rhs) noexcept {
+        nStaged += rhs.nStaged;
+        nUpload += rhs.nUpload;
+        nByte += rhs.nByte;
+        return *this;
+    }
+};
+
+// writes held until flushed, to be issued in as few writes as possible.
+// writes to a destination overlapping or adjacent to each other are merged,
+// the later winning, so a destination staged several times is written once.
+// Dest tells destinations apart, how a write is issued is up to flush,
+// so this doesn't depend on the device.
+template <class Dest>
+    requires std::equality_comparable<Dest> && std::default_initializable<Dest>
+class GFXBasicUploadQueue {
+public:
+    GFXBasicUploadQueue()
+        : ranges_(), nRange_(0u), scratch_(),
+        frameCounters_(), totalCounters_(), counters_() {}
+
+    // bytes are copied, the destination is held until flushed.
+    void stage( Dest dest, std::size_t offset,
+        std::span<const std::byte> bytes
+    ) {
+        ++counters_.nStaged;
+
+        const auto lo = offset;
+        const auto hi = offset + bytes.size();
+        const auto touches = [&](const Range& range) {
+            return range.dest == dest
+                && range.offset <= hi && lo <= range.offset + range.bytes.size();
+        };
+
+        // the write and the ranges it touches make one range,
+        // as the ranges don't touch each other.
+        auto mergedLo = lo;
+        auto mergedHi = hi;
+        for (std::size_t i = 0u; i < nRange_; ++i) {
+            if ( touches(ranges_[i]) ) {
+                mergedLo = std::min(mergedLo, ranges_[i].offset);
+                mergedHi = std::max( mergedHi,
+                    ranges_[i].offset + ranges_[i].bytes.size()
+                );
+            }
+        }
+
+        scratch_.resize(mergedHi - mergedLo);
+
+        // the first touched range takes the merged bytes, others are dropped.
+        auto merged = nRange_;
+        for (std::size_t i = 0u; i < nRange_; ) {
+            if ( !touches(ranges_[i]) ) {
+                ++i;
+                continue;
+            }
+
+            std::ranges::copy( ranges_[i].bytes,
+                scratch_.begin() + (ranges_[i].offset - mergedLo)
+            );
+
+            if (merged == nRange_) {
+                merged = i++;
+            }
+            else {
+                std::swap( ranges_[i], ranges_[nRange_ - 1u] );
+                ranges_[--nRange_].dest = Dest();
+            }
+        }
+
+        // the later write wins.
+        std::ranges::copy( bytes, scratch_.begin() + (lo - mergedLo) );
+
+        if (merged == nRange_) {
+            if ( nRange_ == ranges_.size() ) {
+                ranges_.emplace_back();
+            }
+            merged = nRange_++;
+        }
+
+        auto& range = ranges_[merged];
+        range.dest = std::move(dest);
+        range.offset = mergedLo;
+        // the storage given up is reused by the next merge.
+        range.bytes.swap(scratch_);
+    }
+
+    // write(dest, offset, bytes) issues each merged write.
+    // pending ranges are dropped even if a write fails.
+    template <class Write>
+        requires std::invocable< Write&, const Dest&, std::size_t,
+            std::span<const std::byte>
+        >
+    void flush(Write write) {
+        const auto nRange = std::exchange(nRange_, 0u);
+
+        for (std::size_t i = 0u; i < nRange; ++i) {
+            auto& range = ranges_[i];
+            const auto dest = std::exchange( range.dest, Dest() );
+
+            std::invoke( write, dest, range.offset,
+                std::span<const std::byte>(range.bytes)
+            );
+
+            ++counters_.nUpload;
+            counters_.nByte += range.bytes.size();
+        }
+    }
+
+    bool empty() const noexcept {
+        return nRange_ == 0u;
+    }
+
+    void advanceFrame() noexcept {
+        frameCounters_ = counters_;
+        totalCounters_ += counters_;
+        counters_ = {};
+    }
+
+    // counters of the last frame closed by advanceFrame.
+    GFXUploadCounters frameCounters() const noexcept {
+        return frameCounters_;
+    }
+
+    GFXUploadCounters totalCounters() const noexcept {
+        return totalCounters_;
+    }
+
+private:
+    // ranges of a destination are disjoint and apart from each other.
+    struct Range {
+        Dest dest;
+        std::size_t offset;
+        std::vector<std::byte> bytes;
+    };
+
+    // the first nRange_ are pending,
+    // the rest are kept for their storage to be reused.
+    std::vector<Range> ranges_;
+    std::size_t nRange_;
+    std::vector<std::byte> scratch_;
+    GFXUploadCounters frameCounters_;
+    GFXUploadCounters totalCounters_;
+    GFXUploadCounters counters_;
+};
+
+}   // namespace gfx
+
+#endif  // __BasicUploadQueue
@@ -151,7 +151,9 @@ private:
 
         template <class Rep>
         Rep countTotal(const void* pSource, std::size_t nFrame) const {
-            return count(GFXCMDType::Create | GFXCMDType::Bind | GFXCMDType::Draw);
+            return count<Rep>( GFXCMDType::Create | GFXCMDType::Bind | GFXCMDType::Draw,
+                pSource, nFrame
+            );
         }
 
         template <class Rep>
@@ -162,7 +164,9 @@ private:
 
         template <class Rep>
         Rep averageCountTotal(const void* pSource, std::size_t nFrame) const {
-            return averageCount(GFXCMDType::Create | GFXCMDType::Bind | GFXCMDType::Draw);
+            return averageCount<Rep>( GFXCMDType::Create | GFXCMDType::Bind | GFXCMDType::Draw,
+                pSource, nFrame
+            );
         }
 
         void advance() {
@@ -0,0 +1,144 @@
+#ifndef __CommandBuffer
+#define __CommandBuffer
+
+#include "SlotMap.hpp"
+
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace gfx {
+
+namespace po {
+class BasicDrawCaller;
+}   // namespace gfx::po
+
+enum class GFXCommandType : std::uint8_t {
+    Bind, Draw, DrawInstanced
+};
+
+// one recorded command, resources referred by storage ID.
+// payload bytes, if any, live in the command buffer's arena.
+struct GFXCommand {
+    GFXCommandType type;
+    std::uint32_t nInstance = 0u;   // DrawInstanced
+    std::uint32_t payloadOffset = 0u;
+    std::uint32_t payloadSize = 0u;
+    SlotMapKey id = {};             // Bind
+    const po::BasicDrawCaller* pDrawCaller = nullptr;   // Draw, DrawInstanced
+};
+
+static_assert( std::is_trivially_copyable_v<GFXCommand> );
+
+// what recorded commands are replayed onto.
+class IGFXCommandBackend {
+public:
+    virtual ~IGFXCommandBackend() {}
+
+    virtual void bind(SlotMapKey id) = 0;
+    virtual void draw(const po::BasicDrawCaller& drawCaller) = 0;
+    // instances are handed over as packed by the recorder.
+    virtual void drawInstanced( const po::BasicDrawCaller& drawCaller,
+        std::uint32_t nInstance, std::span<const std::byte> instances
+    ) = 0;
+};
+
+// stream of commands recorded without touching a device context,
+// so several threads can each record one into its own buffer.
+// draw callers are referred by address,
+// they must outlive the buffer's replay.
+class GFXCommandBuffer {
+public:
+    GFXCommandBuffer()
+        : commands_(), payload_() {}
+
+    void bind(SlotMapKey id) {
+        commands_.push_back( GFXCommand{
+            .type = GFXCommandType::Bind,
+            .id = id
+        } );
+    }
+
+    void draw(const po::BasicDrawCaller& drawCaller) {
+        commands_.push_back( GFXCommand{
+            .type = GFXCommandType::Draw,
+            .pDrawCaller = &drawCaller
+        } );
+    }
+
+    template <class InstanceT>
+        requires std::is_trivially_copyable_v<InstanceT>
+    void drawInstanced( const po::BasicDrawCaller& drawCaller,
+        std::span<const InstanceT> instances
+    ) {
+        const auto bytes = std::as_bytes(instances);
+        commands_.push_back( GFXCommand{
+            .type = GFXCommandType::DrawInstanced,
+            .nInstance = static_cast<std::uint32_t>( instances.size() ),
+            .payloadOffset = store(bytes),
+            .payloadSize = static_cast<std::uint32_t>( bytes.size() ),
+            .pDrawCaller = &drawCaller
+        } );
+    }
+
+    void replay(IGFXCommandBackend& backend) const;
+
+    // keeps the capacity, so recording the next frame won't allocate.
+    void clear() noexcept {
+        commands_.clear();
+        payload_.clear();
+    }
+
+    bool empty() const noexcept {
+        return commands_.empty();
+    }
+
+    std::span<const GFXCommand> commands() const noexcept {
+        return commands_;
+    }
+
+private:
+    static constexpr std::size_t payloadAlign = 16u;
+
+    // payloads are aligned, so backends may read them in place.
+    std::uint32_t store(std::span<const std::byte> bytes);
+
+    std::vector<GFXCommand> commands_;
+    std::vector<std::byte> payload_;
+};
+
+// keeps what is replayed instead of submitting it,
+// e.g. to inspect a frame where no device is available.
+class GFXRecordingBackend : public IGFXCommandBackend {
+public:
+    struct Entry {
+        GFXCommandType type;
+        SlotMapKey id = {};
+        const po::BasicDrawCaller* pDrawCaller = nullptr;
+        std::uint32_t nInstance = 0u;
+        std::vector<std::byte> bytes = {};
+    };
+
+    void bind(SlotMapKey id) override;
+    void draw(const po::BasicDrawCaller& drawCaller) override;
+    void drawInstanced( const po::BasicDrawCaller& drawCaller,
+        std::uint32_t nInstance, std::span<const std::byte> instances
+    ) override;
+
+    const std::vector<Entry>& entries() const noexcept {
+        return entries_;
+    }
+
+    void clear() noexcept {
+        entries_.clear();
+    }
+
+private:
+    std::vector<Entry> entries_;
+};
+
+}   // namespace gfx
+
+#endif  // __CommandBuffer
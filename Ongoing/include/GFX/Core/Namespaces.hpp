@@ -2,12 +2,17 @@
 #define __GraphicsNamespaces
 
 #include <DirectXMath.h>
-#include <wrl.h>
 
 #define VCALL XM_CALLCONV
 
+namespace dx = DirectX;
+
+// the math alone builds elsewhere, e.g. for tests on linux.
+#ifdef _WIN32
+#include <wrl.h>
+
 // for ComPtrs resides in Microsoft::WRL
 namespace wrl = Microsoft::WRL;
-namespace dx = DirectX;
+#endif
 
 #endif  // __GraphicsNamespaces
\ No newline at end of file
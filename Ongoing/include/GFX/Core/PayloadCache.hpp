@@ -0,0 +1,136 @@
+#ifndef __GFXPayloadCache
+#define __GFXPayloadCache
+
+#include "Storage.hpp"
+
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <string>
+#include <span>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
+#include <ranges>
+
+#define GFXPAYLOADCACHE gfx::getGFXPayloadCache()
+
+namespace gfx {
+
+// persistent cache of CPU-side payloads, such as generated vertices,
+// keyed by GFXContentKey, found by its stableHash().
+// open() memory-maps the file written by the last save(),
+// so payloads found there are handed out without regeneration.
+// entries failing the integrity check are dropped and regenerated.
+// bump formatVersion whenever generated payloads change.
+class GFXPayloadCache {
+public:
+    static constexpr std::uint32_t formatVersion = 2u;
+
+    GFXPayloadCache();
+    ~GFXPayloadCache();
+
+    GFXPayloadCache(const GFXPayloadCache&) = delete;
+    GFXPayloadCache& operator=(const GFXPayloadCache&) = delete;
+
+    // a missing, stale or corrupted file leaves the cache empty,
+    // to be rewritten on save().
+    void open(const std::filesystem::path& path);
+
+    // writes the cache back if anything was generated since open().
+    // invalidates every span handed out before,
+    // so call it while no payload is being fetched.
+    [[maybe_unused]] bool save();
+
+    // payload cached under the key, or generate()'s result cached from now.
+    // the span stays valid until the next open() or save().
+    template <class T, class Generate>
+        requires std::is_trivially_copyable_v<T>
+            && std::ranges::contiguous_range< std::invoke_result_t<Generate> >
+    std::span<const T> fetch(const GFXContentKey& key, Generate&& generate) {
+        if ( auto bytes = find(key, sizeof(T)) ) [[likely]] {
+            return asSpan<T>( bytes.value() );
+        }
+
+        // generate unlocked, workers may fetch other payloads meanwhile.
+        const auto generated = std::invoke( std::forward<Generate>(generate) );
+        const auto bytes = std::as_bytes( std::span( std::data(generated),
+            std::size(generated)
+        ) );
+
+        return asSpan<T>( insert( key, sizeof(T), bytes ) );
+    }
+
+    std::size_t nHit() const noexcept {
+        return nHit_.load(std::memory_order_relaxed);
+    }
+
+    std::size_t nMiss() const noexcept {
+        return nMiss_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // the hash only narrows the search,
+    // an entry is told by the whole key and the element size,
+    // so a colliding key never gets another's payload.
+    struct Entry {
+        std::string typeName = {};
+        std::array<std::uint64_t, GFXContentKey::maxParams> params = {};
+        std::uint32_t nParams = 0u;
+        std::uint32_t elemSize = 0u;
+        std::span<const std::byte> bytes = {};
+        // empty while bytes points into the mapped file.
+        std::vector<std::byte> owned = {};
+
+        bool matches(const GFXContentKey& key, std::size_t size) const noexcept {
+            return elemSize == size && typeName == key.typeName()
+                && std::ranges::equal( std::span( params.data(), nParams ),
+                    key.params()
+                );
+        }
+    };
+
+    template <class T>
+    static std::span<const T> asSpan(std::span<const std::byte> bytes) noexcept {
+        return std::span<const T>( reinterpret_cast<const T*>( bytes.data() ),
+            bytes.size() / sizeof(T)
+        );
+    }
+
+    std::optional< std::span<const std::byte> > find( const GFXContentKey& key,
+        std::size_t elemSize
+    );
+    std::span<const std::byte> insert( const GFXContentKey& key,
+        std::size_t elemSize, std::span<const std::byte> bytes
+    );
+    Entry* search( std::uint64_t hash, const GFXContentKey& key,
+        std::size_t elemSize
+    ) noexcept;
+
+    bool map(const std::filesystem::path& path);
+    void unmap() noexcept;
+    bool validate();
+
+    std::filesystem::path path_;
+    std::unordered_multimap< std::uint64_t, Entry > entries_;
+    std::mutex mutex_;
+    void* hFile_;
+    void* hMapping_;
+    const std::byte* view_;
+    std::size_t viewSize_;
+    bool bDirty_;
+    std::atomic<std::size_t> nHit_;
+    std::atomic<std::size_t> nMiss_;
+};
+
+GFXPayloadCache& getGFXPayloadCache();
+
+}   // namespace gfx
+
+#endif  // __GFXPayloadCache
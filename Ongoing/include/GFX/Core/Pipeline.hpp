@@ -3,19 +3,30 @@
 
 #include "GFX/PipelineObjects/PipelineObject.hpp"
 #include "GFX/PipelineObjects/DrawCaller.hpp"
+#include "PipelineState.hpp"
+#include "UploadQueue.hpp"
+#include "UploadRing.hpp"
 
 #include <d3d11.h>
 #include "Namespaces.hpp"
 #include "Exception.hpp"
 
+#include <memory>
+#include <utility>
+
 namespace gfx {
+
+// copies drive the same context, so they share it along with
+// its state shadow, upload queue and upload ring.
+// they are changed in place, for every copy to see the change.
 class GFXPipeline {
 public:
-    GFXPipeline() = default;
+    GFXPipeline()
+        : pShared_( std::make_shared<Shared>() ) {}
 
     GFXPipeline(wrl::ComPtr<ID3D11DeviceContext> pContext)
-        : pContext_(pContext) {
-
+        : pShared_( std::make_shared<Shared>() ) {
+        pShared_->pContext = std::move(pContext);
     }
 
     void bind(po::IPipelineObject* bindable) {
@@ -24,24 +35,95 @@ public:
 
     void drawCall(const po::BasicDrawCaller& drawCaller) {
         drawCaller.beforeDrawCall(*this);
+        flushUploads();
         drawCaller.drawCall(*this);
         drawCaller.afterDrawCall(*this);
     }
 
+    // draw contexts run without drawing,
+    // for them to stage their constants into the upload ring.
+    void stageDrawCall(const po::BasicDrawCaller& drawCaller) {
+        drawCaller.beforeDrawCall(*this);
+        drawCaller.afterDrawCall(*this);
+    }
+
+    // draw contexts are skipped,
+    // per-instance state comes from the bound instance buffer.
+    void drawCallInstanced( const po::BasicDrawCaller& drawCaller,
+        UINT nInstance
+    ) {
+        flushUploads();
+        drawCaller.drawCallInstanced(*this, nInstance);
+    }
+
+    // staged writes are issued before the draw reading them.
+    void flushUploads() {
+        auto& shared = *pShared_;
+        if ( !shared.uploadQueue.empty() ) {
+            shared.uploadQueue.flush( shared.pContext.Get() );
+        }
+    }
+
+    // every copy moves to the new context,
+    // nothing shadowed or staged for the old one is kept.
     void setContext(wrl::ComPtr<ID3D11DeviceContext> pContext) {
-        pContext_ = pContext;
+        auto& shared = *pShared_;
+        shared.pContext = std::move(pContext);
+        shared.state = GFXPipelineState();
+        shared.uploadQueue = GFXUploadQueue();
+
+        // what the ring has in flight belongs to the old context.
+        if (shared.pUploadRing) {
+            shared.pUploadRing = std::make_shared<GFXUploadRing>(
+                shared.pUploadRing->factory(), shared.pUploadRing->capacity()
+            );
+        }
+    }
+
+    GFXPipelineState& state() noexcept {
+        return pShared_->state;
+    }
+
+    const GFXPipelineState& state() const noexcept {
+        return pShared_->state;
+    }
+
+    GFXUploadQueue& uploadQueue() noexcept {
+        return pShared_->uploadQueue;
+    }
+
+    const GFXUploadQueue& uploadQueue() const noexcept {
+        return pShared_->uploadQueue;
+    }
+
+    // null if the device can't bind constant buffers at offsets,
+    // then draw contexts map their own buffers.
+    GFXUploadRing* uploadRing() const noexcept {
+        return pShared_->pUploadRing.get();
+    }
+
+    void setUploadRing(std::shared_ptr<GFXUploadRing> pUploadRing) noexcept {
+        pShared_->pUploadRing = std::move(pUploadRing);
+    }
+
+    // closes the frame of bind counters.
+    void advanceFrame() noexcept {
+        pShared_->state.advanceFrame();
+        pShared_->uploadQueue.advanceFrame();
     }
 
     wrl::ComPtr<ID3D11DeviceContext> context() const noexcept {
-        return pContext_;
+        return pShared_->pContext;
     }
 
+    // the context set through this is shared too,
+    // but the shadow isn't reset, so set it on a fresh pipeline.
     decltype(auto) operator&() {
-        return &pContext_;
+        return &pShared_->pContext;
     }
 
     decltype(auto) operator&() const {
-        return &pContext_;
+        return &std::as_const(pShared_->pContext);
     }
 
     GFXPipeline* address() noexcept {
@@ -53,9 +135,20 @@ public:
     }
 
 private:
-    wrl::ComPtr<ID3D11DeviceContext> pContext_;
+    struct Shared {
+        wrl::ComPtr<ID3D11DeviceContext> pContext;
+        GFXPipelineState state;
+        GFXUploadQueue uploadQueue;
+        std::shared_ptr<GFXUploadRing> pUploadRing;
+    };
+
+    std::shared_ptr<Shared> pShared_;
 };
 
+inline GFXPipelineState& pipelineState(GFXPipeline& pipeline) noexcept {
+    return pipeline.state();
+}
+
 }   // namespace gfx
 
 #endif  // __Pipeline
\ No newline at end of file
@@ -0,0 +1,166 @@
+#ifndef __PipelineState
+#define __PipelineState
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace gfx {
+
+// every state GFXPipeline tracks, slotted ones take a slot per point.
+// PipelineState stands for the parts a pipeline state object binds,
+// from VertexShader to DepthStencil.
+enum class GFXBindPoint : std::size_t {
+    VertexShader, PixelShader, Topology, Viewport,
+    Rasterizer, Blend, DepthStencil, PipelineState, RenderTarget,
+    VertexBuffer, IndexBuffer, VSCBuffer, PSCBuffer,
+    PSShaderResource, PSSampler, Count
+};
+
+// what a bind point refers to.
+// D3D objects are identified by address, which can't be reused while bound
+// since the context holds a reference to them.
+class GFXBindKey {
+public:
+    static constexpr std::size_t nWord = 3u;
+
+    GFXBindKey() = default;
+
+    template <class ... Ts>
+        requires (sizeof...(Ts) <= nWord)
+    explicit GFXBindKey(Ts ... vals) noexcept
+        : words_{ toWord(vals)... } {}
+
+    // two floats in one word, for states made of plain values.
+    static std::uint64_t pack(float lo, float hi) noexcept {
+        return static_cast<std::uint64_t>( std::bit_cast<std::uint32_t>(lo) )
+            | ( static_cast<std::uint64_t>( std::bit_cast<std::uint32_t>(hi) )
+                << 32u );
+    }
+
+    bool operator==(const GFXBindKey&) const = default;
+
+private:
+    template <class T>
+    static std::uint64_t toWord(T val) noexcept {
+        if constexpr ( std::is_pointer_v<T> ) {
+            return static_cast<std::uint64_t>(
+                reinterpret_cast<std::uintptr_t>(val)
+            );
+        }
+        else {
+            return static_cast<std::uint64_t>(val);
+        }
+    }
+
+    std::array<std::uint64_t, nWord> words_ = {};
+};
+
+struct GFXPipelineCounters {
+    std::size_t nBind;      // binds issued to the context
+    std::size_t nElided;    // binds dropped as the state was already there
+    std::size_t nUpload;    // shadowed buffers written to
+    std::size_t nUploadSkipped;     // those unchanged since the last write
+
+    GFXPipelineCounters& operator+=(const GFXPipelineCounters& rhs) noexcept {
+        nBind += rhs.nBind;
+        nElided += rhs.nElided;
+        nUpload += rhs.nUpload;
+        nUploadSkipped += rhs.nUploadSkipped;
+        return *this;
+    }
+};
+
+// shadow of the state bound to a device context.
+// binders diff against it and only issue actual changes.
+// a context is driven by one thread at a time, so is this.
+class GFXPipelineState {
+public:
+    // if shader utilizes slots over than nSlot,
+    // update nSlot with higher value.
+    static constexpr std::size_t nSlot = 32u;
+
+    GFXPipelineState() noexcept
+        : bound_(), frameCounters_(), totalCounters_(), counters_() {}
+
+    bool isBound( GFXBindPoint point, std::size_t slot,
+        const GFXBindKey& key
+    ) const noexcept {
+        const auto& entry = bound_[index(point)][slot];
+        return entry.bValid && entry.key == key;
+    }
+
+    // call after the bind was issued, so a failed bind isn't recorded.
+    void record( GFXBindPoint point, std::size_t slot,
+        const GFXBindKey& key
+    ) noexcept {
+        dropPipelineState(point);
+        bound_[index(point)][slot] = Entry{ .key = key, .bValid = true };
+        ++counters_.nBind;
+    }
+
+    void elide() noexcept {
+        ++counters_.nElided;
+    }
+
+    void countUpload(bool bSkipped) noexcept {
+        ++( bSkipped ? counters_.nUploadSkipped : counters_.nUpload );
+    }
+
+    // forget what is bound, after the context was touched
+    // by code bypassing GFXPipeline.
+    void invalidate() noexcept {
+        bound_ = {};
+    }
+
+    void invalidate(GFXBindPoint point) noexcept {
+        dropPipelineState(point);
+        bound_[index(point)] = {};
+    }
+
+    void advanceFrame() noexcept {
+        frameCounters_ = counters_;
+        totalCounters_ += counters_;
+        counters_ = {};
+    }
+
+    // counters of the last frame closed by advanceFrame.
+    GFXPipelineCounters frameCounters() const noexcept {
+        return frameCounters_;
+    }
+
+    // counters accumulated over every closed frame.
+    GFXPipelineCounters totalCounters() const noexcept {
+        return totalCounters_;
+    }
+
+private:
+    struct Entry {
+        GFXBindKey key;
+        bool bValid = false;
+    };
+
+    static constexpr std::size_t index(GFXBindPoint point) noexcept {
+        return static_cast<std::size_t>(point);
+    }
+
+    // a part bound on its own may differ from the bound state object.
+    void dropPipelineState(GFXBindPoint point) noexcept {
+        if ( index(point) < index(GFXBindPoint::PipelineState) ) {
+            bound_[index(GFXBindPoint::PipelineState)][0].bValid = false;
+        }
+    }
+
+    std::array< std::array<Entry, nSlot>,
+        static_cast<std::size_t>(GFXBindPoint::Count)
+    > bound_;
+    GFXPipelineCounters frameCounters_;
+    GFXPipelineCounters totalCounters_;
+    GFXPipelineCounters counters_;
+};
+
+}   // namespace gfx
+
+#endif  // __PipelineState
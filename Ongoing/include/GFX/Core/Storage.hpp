@@ -3,22 +3,35 @@
 
 #include "GFX/PipelineObjects/PipelineObject.hpp"
 
-#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <future>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <tuple>
 #include <typeindex>
 #include <optional>
+#include <string_view>
+#include <span>
 #include <cassert>
 #include <ranges>
 #include <algorithm>
-#include <coroutine>
 #include <optional>
 #include <functional>
 #include <type_traits>
 #include <utility>
 #include <concepts>
 
-#include "LRUCache.hpp"
-#include "Generator.hpp"
+#include "SlotMap.hpp"
+#include "ThreadPool.hpp"
 
 namespace gfx {
 
@@ -60,6 +73,133 @@ private:
     TRes* res_;
 };
 
+// type-erased nullary factory of Result.
+// callables up to BUFFER_SIZE bytes are stored inline, without allocation.
+template <class Result>
+class GFXResFactory {
+public:
+    static constexpr std::size_t BUFFER_SIZE = 0x40u;
+    static constexpr std::size_t BUFFER_ALIGN = alignof(void*);
+
+    GFXResFactory() noexcept
+        : buffer_(), vtable_(nullptr) {}
+
+    template <class Fn>
+        requires (!std::is_same_v<std::remove_cvref_t<Fn>, GFXResFactory>)
+            && std::is_invocable_r_v<Result, std::decay_t<Fn>&>
+    GFXResFactory(Fn&& fn)
+        : buffer_(), vtable_( &vtableOf< std::decay_t<Fn> > ) {
+        using Stored = std::decay_t<Fn>;
+
+        if constexpr ( storedInline<Stored>() ) {
+            ::new (static_cast<void*>(buffer_)) Stored( std::forward<Fn>(fn) );
+        }
+        else {
+            ::new (static_cast<void*>(buffer_)) Stored*(
+                new Stored( std::forward<Fn>(fn) )
+            );
+        }
+    }
+
+    ~GFXResFactory() {
+        reset();
+    }
+
+    GFXResFactory(const GFXResFactory&) = delete;
+    GFXResFactory& operator=(const GFXResFactory&) = delete;
+
+    GFXResFactory(GFXResFactory&& other) noexcept
+        : buffer_(), vtable_( std::exchange(other.vtable_, nullptr) ) {
+        if (vtable_) {
+            vtable_->move(buffer_, other.buffer_);
+        }
+    }
+
+    GFXResFactory& operator=(GFXResFactory&& other) noexcept {
+        if (this == &other) [[unlikely]] {
+            return *this;
+        }
+
+        reset();
+        vtable_ = std::exchange(other.vtable_, nullptr);
+        if (vtable_) {
+            vtable_->move(buffer_, other.buffer_);
+        }
+
+        return *this;
+    }
+
+    Result operator()() {
+        assert(vtable_ != nullptr);
+        return vtable_->invoke(buffer_);
+    }
+
+    explicit operator bool() const noexcept {
+        return vtable_ != nullptr;
+    }
+
+private:
+    struct VTable {
+        Result (*invoke)(std::byte*);
+        // move-constructs into dst and destroys src.
+        void (*move)(std::byte* dst, std::byte* src) noexcept;
+        void (*destroy)(std::byte*) noexcept;
+    };
+
+    template <class Fn>
+    static constexpr bool storedInline() noexcept {
+        return sizeof(Fn) <= BUFFER_SIZE
+            && alignof(Fn) <= BUFFER_ALIGN
+            && std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <class Fn>
+    static Fn& target(std::byte* buffer) noexcept {
+        if constexpr ( storedInline<Fn>() ) {
+            return *std::launder( reinterpret_cast<Fn*>(buffer) );
+        }
+        else {
+            return **std::launder( reinterpret_cast<Fn**>(buffer) );
+        }
+    }
+
+    template <class Fn>
+    static constexpr VTable vtableOf = {
+        .invoke = [](std::byte* buffer) -> Result {
+            return std::invoke( target<Fn>(buffer) );
+        },
+        .move = [](std::byte* dst, std::byte* src) noexcept {
+            if constexpr ( storedInline<Fn>() ) {
+                auto& from = target<Fn>(src);
+                ::new (static_cast<void*>(dst)) Fn( std::move(from) );
+                std::destroy_at(&from);
+            }
+            else {
+                ::new (static_cast<void*>(dst)) Fn*(
+                    *std::launder( reinterpret_cast<Fn**>(src) )
+                );
+            }
+        },
+        .destroy = [](std::byte* buffer) noexcept {
+            if constexpr ( storedInline<Fn>() ) {
+                std::destroy_at( &target<Fn>(buffer) );
+            }
+            else {
+                delete &target<Fn>(buffer);
+            }
+        }
+    };
+
+    void reset() noexcept {
+        if ( auto vtable = std::exchange(vtable_, nullptr) ) {
+            vtable->destroy(buffer_);
+        }
+    }
+
+    alignas(BUFFER_ALIGN) std::byte buffer_[BUFFER_SIZE];
+    const VTable* vtable_;
+};
+
 }   // namespace gfx::detail
 
 class GFXResView : public detail::GFXResViewBase<GFXRes> {
@@ -78,6 +218,75 @@ public:
 
 class GFXStorage;
 
+// identifies a resource by what it contains rather than by who made it,
+// e.g. a sphere vertex buffer and its tesselation factors.
+// resources shared under equal keys are created once per storage.
+class GFXContentKey {
+public:
+    // as many as a pipeline state object is made of.
+    static constexpr std::size_t maxParams = 9u;
+
+    struct Hash {
+        std::size_t operator()(const GFXContentKey& key) const noexcept {
+            auto ret = std::hash<std::type_index>{}(key.type_);
+            for (std::size_t i = 0u; i < key.nParams_; ++i) {
+                ret ^= std::hash<std::uint64_t>{}(key.params_[i])
+                    + 0x9e3779b97f4a7c15ull + (ret << 6) + (ret >> 2);
+            }
+            return ret;
+        }
+    };
+
+    template <class T, std::integral ... Params>
+        requires (sizeof...(Params) <= maxParams)
+    static GFXContentKey make(Params ... params) noexcept {
+        return GFXContentKey( typeid(T), sizeof...(Params),
+            { static_cast<std::uint64_t>(params)... }
+        );
+    }
+
+    // what identifies the key across runs of one build, with params().
+    std::string_view typeName() const noexcept {
+        return type_.name();
+    }
+
+    std::span<const std::uint64_t> params() const noexcept {
+        return std::span( params_.data(), nParams_ );
+    }
+
+    // unlike Hash, stays the same across runs of one build,
+    // so that it can identify payloads persisted on disk.
+    std::uint64_t stableHash() const noexcept {
+        // FNV-1a
+        auto ret = 0xcbf29ce484222325ull;
+        const auto mix = [&ret](const void* data, std::size_t size) {
+            for ( auto p = static_cast<const unsigned char*>(data);
+                size--; ++p
+            ) {
+                ret = (ret ^ *p) * 0x100000001b3ull;
+            }
+        };
+
+        const auto name = std::string_view( type_.name() );
+        mix( name.data(), name.size() );
+        mix( params_.data(), nParams_ * sizeof(std::uint64_t) );
+
+        return ret;
+    }
+
+    friend bool operator==(const GFXContentKey& lhs,
+        const GFXContentKey& rhs) noexcept = default;
+
+private:
+    GFXContentKey(std::type_index type, std::size_t nParams,
+        std::array<std::uint64_t, maxParams> params
+    ) : type_(type), nParams_(nParams), params_(params) {}
+
+    std::type_index type_;
+    std::size_t nParams_;
+    std::array<std::uint64_t, maxParams> params_;
+};
+
 class GFXRes {
 private:
     template <class T>
@@ -87,13 +296,13 @@ private:
     static std::optional<Dummy> nullTag;
     
     enum class GenMode {
-        StandAlone, Load, Cache
+        StandAlone, Load, Cache, Share
     };
 
 public:
     friend class GFXStorage;
 
-    using ID = int;
+    using ID = SlotMapKey;
 
     struct Pair {
         ID id;
@@ -101,12 +310,11 @@ public:
     };
 
     GFXRes()
-        : gen_(), stored_(), genMode_(GenMode::StandAlone) {}
+        : factory_(), stored_(), genMode_(GenMode::StandAlone),
+        pStorage_(nullptr) {}
 
     ~GFXRes() {
-        if (genMode_ == GenMode::StandAlone && valid()) {
-            delete stored_.value().bindee;
-        }
+        destroy();
     }
 
     GFXRes(const GFXRes& other) = delete;
@@ -135,6 +343,15 @@ public:
         );
     }
 
+    template <class T, class ... Args>
+    static GFXRes makeShared(GFXStorage& storage, const GFXContentKey& key,
+        Args&& ... args
+    ) {
+        return GFXRes( Type<T>{}, GenMode::Share, storage,
+            std::optional<GFXContentKey>(key), std::forward<Args>(args)...
+        );
+    }
+
     ID id() const {
         if (!valid()) [[unlikely]] {
             reconstruct();
@@ -189,13 +406,19 @@ public:
         return GFXResCView(*this);
     }
 
-    bool valid() const noexcept {
-        return stored_.has_value();
-    }
+    // false once the resource is unloaded or evicted,
+    // the next access rebuilds it.
+    bool valid() const noexcept;
 
-    void destroy() {
-        // to be implemented
-    }
+    // releases the resource; the next access rebuilds it.
+    // cached and shared resources are left to their storage,
+    // which evicts them over the budget like any other.
+    void destroy();
+
+    // pinned resources are never evicted by the storage budget.
+    // pin what holds state that rebuilding would lose.
+    void pin();
+    void unpin();
 
 private:
     template <class T, class Tag, class ... Args>
@@ -205,50 +428,56 @@ private:
         Args&& ... args
     );
 
+    using Factory = detail::GFXResFactory<Pair>;
+
     template <class T, class ... Args>
         requires std::is_base_of_v<po::IPipelineObject, T>
-    Generator<Pair> makeGenStandAlone(Args ... args);
+    static Factory makeFactoryStandAlone(Args ... args);
 
     template <class T, class ... Args>
         requires std::is_base_of_v<po::IPipelineObject, T>
-    Generator<Pair> makeGenStorageLoad(GFXStorage& storage, Args ... args);
+    static Factory makeFactoryStorageLoad(GFXStorage& storage, Args ... args);
 
     template <class T, class Tag, class ... Args>
         requires std::is_base_of_v<po::IPipelineObject, T>
-    Generator<Pair> makeGenStorageCache(GFXStorage& storage, Tag tag, Args ... args);
+    static Factory makeFactoryStorageCache(GFXStorage& storage, Tag tag, Args ... args);
 
+    template <class T, class ... Args>
+        requires std::is_base_of_v<po::IPipelineObject, T>
+    static Factory makeFactoryStorageShare(GFXStorage& storage,
+        GFXContentKey key, Args ... args);
+
+    // arguments are kept by value, as a rebuild may outlive them.
+    // wrap one in std::ref to keep a reference instead.
     template <class Arg>
-    auto packArg(Arg&& arg) {
-        if constexpr (std::is_lvalue_reference_v<Arg>) {
-            return std::ref(arg);
-        }
-        else {
-            return std::move(arg);
-        }
+    static std::decay_t<Arg> packArg(Arg&& arg) {
+        return std::forward<Arg>(arg);
     }
 
     template <class Arg>
-    decltype(auto) unpackArg(std::reference_wrapper<Arg>& arg) {
+    static decltype(auto) unpackArg(std::reference_wrapper<Arg>& arg) {
         return arg.get();
     }
 
     template <class Arg>
-    decltype(auto) unpackArg(Arg& arg) {
+    static decltype(auto) unpackArg(Arg& arg) {
         return arg;
     }
 
-    void invalidate() noexcept {
+    void invalidate() const noexcept {
         stored_.reset();
     }
 
-    void reconstruct() const {
-        gen_.resume();
-        stored_ = gen_.value();
-    }
+    void reconstruct() const;
 
-    mutable Generator<Pair> gen_;
+    // tells the storage which object to invalidate on eviction.
+    // the factory can't, as it outlives moves of this object.
+    void adopt() const;
+
+    mutable Factory factory_;
     mutable std::optional<Pair> stored_;
     GenMode genMode_;
+    GFXStorage* pStorage_;
 };
 
 template <class T, class Tag, class ... Args>
@@ -256,17 +485,18 @@ GFXRes::GFXRes( Type<T>, GenMode gmod,
     std::optional<std::reference_wrapper<GFXStorage>> storage,
     std::optional<Tag> tag,
     Args&& ... args
-) : gen_(), stored_(), genMode_(gmod) {
+) : factory_(), stored_(), genMode_(gmod),
+    pStorage_( storage.has_value() ? &storage.value().get() : nullptr ) {
     switch (gmod) {
     case GenMode::StandAlone:
-        gen_ = makeGenStandAlone<T>( 
+        factory_ = makeFactoryStandAlone<T>( 
             packArg(std::forward<Args>(args))...
         );
         break; 
 
     case GenMode::Load:
         assert(storage.has_value());
-        gen_ = makeGenStorageLoad<T>( 
+        factory_ = makeFactoryStorageLoad<T>( 
             storage.value().get(),
             packArg(std::forward<Args>(args))...
         );
@@ -275,18 +505,30 @@ GFXRes::GFXRes( Type<T>, GenMode gmod,
     case GenMode::Cache:
         assert(storage.has_value());
         assert(tag.has_value());
-        gen_ = makeGenStorageCache<T>(
+        factory_ = makeFactoryStorageCache<T>(
             storage.value().get(), tag.value(),
             packArg(std::forward<Args>(args))...
         );
         break; 
 
+    case GenMode::Share:
+        if constexpr ( std::is_same_v<Tag, GFXContentKey> ) {
+            assert(storage.has_value());
+            assert(tag.has_value());
+            factory_ = makeFactoryStorageShare<T>(
+                storage.value().get(), tag.value(),
+                packArg(std::forward<Args>(args))...
+            );
+        }
+        break;
+
     default:
         // do proper error handling
         break;
     }
 
-    stored_ = gen_.value();
+    stored_ = factory_();
+    adopt();
 }
 
 template <class T>
@@ -296,33 +538,398 @@ concept GFXResRepresentable = std::is_base_of_v<GFXRes, std::remove_cvref_t<T>>
 
 namespace detail {
 
-inline const GFXRes::ID makeGFXResID() noexcept {
-    static auto IDDistribution = 0;
-    // maybe occur overflow.
-    // subsitute this with robust algorithm later.
-    return IDDistribution++;
+// stand-alone resources never live in a GFXStorage.
+// their IDs carry the null slot index, so no storage resolves them,
+// and the generation is merely a serial number, wrapping safely.
+inline const GFXRes::ID makeStandAloneID() noexcept {
+    static auto serial = std::atomic<SlotMapKey::Generation>(0u);
+    return GFXRes::ID( SlotMapKey::nullIndex,
+        serial.fetch_add(1u, std::memory_order_relaxed)
+    );
+}
+
+// entries in pages which are allocated once and never move,
+// so readers find them without locks while a writer adds pages.
+// value-initialized entries read as empty.
+template <class Entry, std::size_t PageSize, std::size_t MaxPages>
+class GFXPages {
+public:
+    GFXPages()
+        : pages_() {}
+
+    ~GFXPages() {
+        for (auto& page : pages_) {
+            delete[] page.load(std::memory_order_relaxed);
+        }
+    }
+
+    GFXPages(const GFXPages&) = delete;
+    GFXPages& operator=(const GFXPages&) = delete;
+
+    Entry* find(std::size_t idx) const noexcept {
+        const auto idxPage = idx / PageSize;
+        if (idxPage >= MaxPages) [[unlikely]] {
+            return nullptr;
+        }
+
+        auto page = pages_[idxPage].load(std::memory_order_acquire);
+        return page ? &page[idx % PageSize] : nullptr;
+    }
+
+    // writer only. null past the last page.
+    Entry* reserve(std::size_t idx) {
+        const auto idxPage = idx / PageSize;
+        if (idxPage >= MaxPages) [[unlikely]] {
+            return nullptr;
+        }
+
+        auto page = pages_[idxPage].load(std::memory_order_relaxed);
+        if (!page) {
+            page = new Entry[PageSize]();
+            pages_[idxPage].store(page, std::memory_order_release);
+        }
+
+        return &page[idx % PageSize];
+    }
+
+private:
+    std::array< std::atomic<Entry*>, MaxPages > pages_;
+};
+
+// read side of GFXStorage, indexed like its slot map.
+// readers go without locks while a writer publishes and retracts.
+class GFXReadTable {
+public:
+    using Index = SlotMapKey::Index;
+    using Generation = SlotMapKey::Generation;
+
+    static constexpr std::size_t PAGE_SIZE = 0x400u;
+    static constexpr std::size_t MAX_PAGES = 0x400u;
+
+    struct Entry {
+        std::atomic<Generation> generation;
+        std::atomic<po::IPipelineObject*> bindee;
+        std::atomic<std::uint64_t> lastUsed;
+    };
+
+    GFXReadTable()
+        : pages_() {}
+
+    // wait-free. stamps the entry with the frame it was read in.
+    po::IPipelineObject* get(const SlotMapKey& key,
+        std::uint64_t frame
+    ) const noexcept {
+        auto pEntry = find(key.index);
+        if ( !pEntry || pEntry->generation.load(std::memory_order_acquire)
+            != key.generation
+        ) {
+            return nullptr;
+        }
+
+        // the slot may be retracted and published again in between,
+        // a bindee published after the check comes with a newer generation.
+        auto bindee = pEntry->bindee.load(std::memory_order_acquire);
+        if ( pEntry->generation.load(std::memory_order_acquire)
+            != key.generation
+        ) [[unlikely]] {
+            return nullptr;
+        }
+
+        // skip the store when possible, not to bounce the cache line.
+        if ( pEntry->lastUsed.load(std::memory_order_relaxed) != frame ) {
+            pEntry->lastUsed.store(frame, std::memory_order_relaxed);
+        }
+
+        return bindee;
+    }
+
+    bool contains(const SlotMapKey& key) const noexcept {
+        auto pEntry = find(key.index);
+        return pEntry
+            && pEntry->generation.load(std::memory_order_acquire) == key.generation
+            && pEntry->bindee.load(std::memory_order_acquire) != nullptr;
+    }
+
+    std::uint64_t lastUsed(Index idx) const noexcept {
+        auto pEntry = find(idx);
+        return pEntry ? pEntry->lastUsed.load(std::memory_order_relaxed) : 0u;
+    }
+
+    // writer only.
+    void publish(const SlotMapKey& key, po::IPipelineObject* bindee,
+        std::uint64_t frame
+    ) {
+        auto pEntry = pages_.reserve(key.index);
+        if (!pEntry) [[unlikely]] {
+            throw std::length_error("GFXStorage can't hold more resources.");
+        }
+
+        // value-initialized: generation 0 with no bindee reads as empty.
+        auto& entry = *pEntry;
+        entry.lastUsed.store(frame, std::memory_order_relaxed);
+        entry.bindee.store(bindee, std::memory_order_release);
+        entry.generation.store(key.generation, std::memory_order_release);
+    }
+
+    // writer only. readers may still hold the bindee until the frame ends.
+    void retract(const SlotMapKey& key) noexcept {
+        if ( auto pEntry = find(key.index) ) {
+            pEntry->generation.store(key.generation + 1u, std::memory_order_release);
+            pEntry->bindee.store(nullptr, std::memory_order_release);
+        }
+    }
+
+private:
+    Entry* find(Index idx) const noexcept {
+        return pages_.find(idx);
+    }
+
+    GFXPages<Entry, PAGE_SIZE, MAX_PAGES> pages_;
+};
+
+inline std::size_t makeGFXTagIndex() noexcept {
+    static auto IDDistribution = std::atomic<std::size_t>(0u);
+    return IDDistribution.fetch_add(1u, std::memory_order_relaxed);
 }
 
+// dense index of a cache tag type, assigned once on first use.
+// GFXStorage looks cached resources up by it, without any hashing.
+template <class Tag>
+std::size_t GFXTagIndex() noexcept {
+    static const auto idx = makeGFXTagIndex();
+    return idx;
+}
+
+// IDs of cached resources, indexed by GFXTagIndex.
+// read without locks, like GFXReadTable.
+class GFXTagTable {
+public:
+    static constexpr std::size_t PAGE_SIZE = 0x100u;
+    static constexpr std::size_t MAX_PAGES = 0x100u;
+
+    GFXTagTable()
+        : pages_() {}
+
+    // wait-free.
+    std::optional<SlotMapKey> get(std::size_t idxTag) const noexcept {
+        auto pEntry = pages_.find(idxTag);
+        if (!pEntry) {
+            return std::nullopt;
+        }
+
+        const auto packed = pEntry->load(std::memory_order_acquire);
+        if (packed == 0u) {
+            return std::nullopt;
+        }
+        return unpack(packed);
+    }
+
+    // writer only.
+    void set(std::size_t idxTag, const SlotMapKey& key) {
+        auto pEntry = pages_.reserve(idxTag);
+        if (!pEntry) [[unlikely]] {
+            throw std::length_error("GFXStorage can't hold more cache tags.");
+        }
+        pEntry->store( pack(key), std::memory_order_release );
+    }
+
+private:
+    // the key in one word, so it is read whole.
+    // the index is stored plus one, which leaves 0 for no key,
+    // as the null index is never stored.
+    static std::uint64_t pack(const SlotMapKey& key) noexcept {
+        return ( std::uint64_t(key.generation) << 32u )
+            | std::uint64_t(key.index + 1u);
+    }
+
+    static SlotMapKey unpack(std::uint64_t packed) noexcept {
+        return SlotMapKey(
+            static_cast<SlotMapKey::Index>(packed) - 1u,
+            static_cast<SlotMapKey::Generation>(packed >> 32u)
+        );
+    }
+
+    GFXPages<std::atomic<std::uint64_t>, PAGE_SIZE, MAX_PAGES> pages_;
+};
+
+struct GFXAsyncState {
+    std::optional<GFXRes::ID> id;
+};
+
+class GFXPendingLoadBase {
+public:
+    virtual ~GFXPendingLoadBase() {}
+    virtual bool ready() const = 0;
+    virtual void wait() const = 0;
+    virtual void finalize(GFXStorage& storage) = 0;
+};
+
+template <class T, class Prepared, class ... Args>
+class GFXPendingLoad : public GFXPendingLoadBase {
+public:
+    template <class ... ArgsFwd>
+    GFXPendingLoad( const GFXContentKey& key, std::future<Prepared> prepared,
+        std::shared_ptr<GFXAsyncState> state, ArgsFwd&& ... args
+    ) : key_(key), prepared_( std::move(prepared) ),
+        state_( std::move(state) ), args_( std::forward<ArgsFwd>(args)... ) {}
+
+    bool ready() const override {
+        return prepared_.wait_for( std::chrono::seconds(0) )
+            == std::future_status::ready;
+    }
+
+    void wait() const override {
+        prepared_.wait();
+    }
+
+    void finalize(GFXStorage& storage) override;
+
+private:
+    GFXContentKey key_;
+    std::future<Prepared> prepared_;
+    std::shared_ptr<GFXAsyncState> state_;
+    std::tuple<Args...> args_;
+};
+
+class GFXPoolBase {
+public:
+    virtual ~GFXPoolBase() {}
+    virtual void release(po::IPipelineObject* bindee) noexcept = 0;
+};
+
+// chunked free-list allocator for one pipeline object type.
+// objects of a type stay contiguous within a chunk,
+// and released nodes are reused before a new chunk is allocated.
+template <class T>
+class GFXPool : public GFXPoolBase {
+public:
+    GFXPool()
+        : chunks_(), freeList_(nullptr), nUsedInChunk_(CHUNK_SIZE) {}
+
+    GFXPool(const GFXPool&) = delete;
+    GFXPool& operator=(const GFXPool&) = delete;
+
+    template <class ... Args>
+    T* create(Args&& ... args) {
+        auto node = allocate();
+        try {
+            return ::new (static_cast<void*>(node->storage))
+                T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            deallocate(node);
+            throw;
+        }
+    }
+
+    void release(po::IPipelineObject* bindee) noexcept override {
+        auto pObj = static_cast<T*>(bindee);
+        std::destroy_at(pObj);
+        deallocate( reinterpret_cast<Node*>(pObj) );
+    }
+
+private:
+    static constexpr std::size_t CHUNK_SIZE = 0x40u;
+
+    union Node {
+        Node* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    Node* allocate() {
+        if (freeList_) {
+            return std::exchange(freeList_, freeList_->next);
+        }
+
+        if (nUsedInChunk_ == CHUNK_SIZE) {
+            chunks_.push_back( std::make_unique<Node[]>(CHUNK_SIZE) );
+            nUsedInChunk_ = 0u;
+        }
+
+        return &chunks_.back()[nUsedInChunk_++];
+    }
+
+    void deallocate(Node* node) noexcept {
+        node->next = freeList_;
+        freeList_ = node;
+    }
+
+    std::vector< std::unique_ptr<Node[]> > chunks_;
+    Node* freeList_;
+    std::size_t nUsedInChunk_;
+};
+
 }   // namespace detail
 
+// resource traffic of a GFXStorage within a frame.
+struct GFXStorageCounters {
+    std::size_t nHit;           // cache or share found the resource loaded
+    std::size_t nMiss;          // cache or share had to load it
+    std::size_t nLoad;          // resources loaded, misses included
+    std::size_t nReconstruct;   // resources rebuilt by GFXRes after unloaded
+    std::size_t nEvict;         // resources evicted over the budget
+
+    GFXStorageCounters& operator+=(const GFXStorageCounters& rhs) noexcept {
+        nHit += rhs.nHit;
+        nMiss += rhs.nMiss;
+        nLoad += rhs.nLoad;
+        nReconstruct += rhs.nReconstruct;
+        nEvict += rhs.nEvict;
+        return *this;
+    }
+};
+
+struct GFXStorageFootprint {
+    std::size_t nResource;
+    std::size_t bytes;
+};
+
+// handle of a resource requested by GFXStorage::loadAsync.
+// it becomes ready when the storage finalizes the resource,
+// on GFXStorage::syncAsync or GFXStorage::waitAsync.
+class GFXAsyncLoad {
+public:
+    explicit GFXAsyncLoad(std::shared_ptr<const detail::GFXAsyncState> state)
+        : state_( std::move(state) ) {}
+
+    bool ready() const noexcept {
+        return state_->id.has_value();
+    }
+
+    GFXRes::ID id() const {
+        assert(ready());
+        return state_->id.value();
+    }
+
+private:
+    std::shared_ptr<const detail::GFXAsyncState> state_;
+};
+
 class GFXStorage {
 public:
+    friend class GFXRes;
+
     using ID = GFXRes::ID;
     using Pair = GFXRes::Pair;
+    using FootprintCategory = po::FootprintCategory;
+    using CategoryFootprints = std::array< GFXStorageFootprint,
+        static_cast<std::size_t>(FootprintCategory::Count)
+    >;
 
     class ManagedBindable {
     public:
         ManagedBindable()
-            : bindee_(nullptr), owner_(nullptr) {}
+            : bindee_(nullptr), owner_(nullptr), pool_(nullptr),
+            footprint_(0u), bPinned_(false) {}
 
-        ManagedBindable(po::IPipelineObject* bindee, GFXRes* owner)
-            : bindee_(bindee), owner_(owner) {}
+        ManagedBindable(po::IPipelineObject* bindee, const GFXRes* owner,
+            detail::GFXPoolBase* pool = nullptr
+        ) : bindee_(bindee), owner_(owner), pool_(pool),
+            footprint_( bindee ? bindee->footprint() : 0u ),
+            bPinned_(false) {}
 
         ~ManagedBindable() {
-            delete bindee_;
-            if (owner_) {
-                owner_->invalidate();
-            }
+            release();
         }
 
         ManagedBindable(const ManagedBindable&) = delete;
@@ -330,126 +937,428 @@ public:
 
         ManagedBindable(ManagedBindable&& other) noexcept
             : bindee_( std::exchange(other.bindee_, nullptr) ),
-            owner_( std::exchange(other.owner_, nullptr) ) {}
+            owner_( std::exchange(other.owner_, nullptr) ),
+            pool_( std::exchange(other.pool_, nullptr) ),
+            footprint_(other.footprint_), bPinned_(other.bPinned_) {}
 
-        ManagedBindable& operator=(ManagedBindable&& other) {
+        ManagedBindable& operator=(ManagedBindable&& other) noexcept {
             if (this == &other) [[unlikely]] {
                 return *this;
             }
 
+            release();
             bindee_ = std::exchange(other.bindee_, nullptr);
             owner_ = std::exchange(other.owner_, nullptr);
+            pool_ = std::exchange(other.pool_, nullptr);
+            footprint_ = other.footprint_;
+            bPinned_ = other.bPinned_;
+
+            return *this;
         }
-        
 
         po::IPipelineObject* get() const noexcept {
             return bindee_;
         }
 
+        void setOwner(const GFXRes* owner) noexcept {
+            owner_ = owner;
+        }
+
+        std::size_t footprint() const noexcept {
+            return footprint_;
+        }
+
+        bool pinned() const noexcept {
+            return bPinned_;
+        }
+
+        void setPinned(bool val) noexcept {
+            bPinned_ = val;
+        }
+
+        // invalidates the owner now, while the bindee lives on
+        // until no reader can be holding it.
+        void retire() noexcept {
+            if (auto owner = std::exchange(owner_, nullptr)) {
+                owner->invalidate();
+            }
+        }
+
     private:
+        void release() noexcept {
+            if (auto bindee = std::exchange(bindee_, nullptr)) {
+                if (pool_) {
+                    pool_->release(bindee);
+                }
+                else {
+                    delete bindee;
+                }
+            }
+            retire();
+        }
+
         po::IPipelineObject* bindee_;
-        GFXRes* owner_;
+        const GFXRes* owner_;
+        detail::GFXPoolBase* pool_;
+        std::size_t footprint_;
+        bool bPinned_;
     };
 
     GFXStorage()
-        : IDCache_(IDCACHE_CACHELINE_SIZE, IDCACHE_NUM_CACHELINE),
-        resources_() {}
+        : mutex_(), lookupMutex_(), tagIDs_(), sharedIDs_(), pools_(),
+        readTable_(), resources_(), retired_(), budget_(), usage_(0u),
+        frame_(0u), evictCandidates_(), nHit_(0u), nMiss_(0u), nLoad_(0u),
+        nReconstruct_(0u), nEvict_(0u), frameCounters_(), totalCounters_(),
+        typeFootprints_(), categoryFootprints_(), pending_(), workers_() {}
 
     template <class T, class ... Args>
     [[nodiscard("ignoring return value of GFXStorage::load lead to memory leak")]]
-    const Pair load(GFXRes* owner, Args&& ... args) {
-        auto bindee = new T(std::forward<Args>(args)...);
-        auto id = detail::makeGFXResID();
-        resources_.try_emplace(id, ManagedBindable(bindee, owner));
-
-        return Pair{id, bindee};
+    const Pair load(const GFXRes* owner, Args&& ... args) {
+        std::lock_guard lock(mutex_);
+        return loadUnlocked<T>( owner, std::forward<Args>(args)... );
     }
 
     template <class T, class Tag, class ... Args>
     [[nodiscard("ignoring return value of GFXStorage::cache lead to memory leak")]]
-    const Pair cache(GFXRes* owner, Tag, Args&& ... args) {
-        if ( auto cache_res = IDCache_.at( std::type_index( typeid(Tag) ) ); cache_res.hit() ) {
-            const auto& id = cache_res.value();
-            const auto& bindee = resources_.at(id).get();
-            return Pair{id, bindee};
+    const Pair cache(const GFXRes* owner, Tag, Args&& ... args) {
+        std::lock_guard lock(mutex_);
+        const auto idxTag = detail::GFXTagIndex<Tag>();
+
+        if ( auto id = taggedID(idxTag) ) {
+            // the cached resource might have been unloaded since.
+            if ( auto pManaged = resources_.find(id.value()) ) {
+                nHit_.fetch_add(1u, std::memory_order_relaxed);
+                return Pair{id.value(), pManaged->get()};
+            }
+        }
+
+        nMiss_.fetch_add(1u, std::memory_order_relaxed);
+        const auto ret = loadUnlocked<T>( owner, std::forward<Args>(args)... );
+        tagIDs_.set(idxTag, ret.id);
+
+        return ret;
+    }
+
+    template <class T, class ... Args>
+    [[nodiscard("ignoring return value of GFXStorage::share lead to memory leak")]]
+    const Pair share(const GFXRes* owner, const GFXContentKey& key, Args&& ... args) {
+        std::lock_guard lock(mutex_);
+
+        if ( auto id = sharedID(key) ) {
+            if ( auto pManaged = resources_.find(id.value()) ) {
+                nHit_.fetch_add(1u, std::memory_order_relaxed);
+                return Pair{id.value(), pManaged->get()};
+            }
         }
 
-        const auto ret = load<T>( owner, std::forward<Args>(args)... );
-        IDCache_.try_emplace( std::type_index( typeid(Tag) ), ret.id );
+        nMiss_.fetch_add(1u, std::memory_order_relaxed);
+        const auto ret = loadUnlocked<T>( owner, std::forward<Args>(args)... );
+        {
+            std::unique_lock lookupLock(lookupMutex_);
+            sharedIDs_.insert_or_assign( key, ret.id );
+        }
 
         return ret;
     }
 
+    // prepares CPU-side data on a worker thread by prepare(),
+    // then constructs T(args..., prepared) on the thread calling
+    // syncAsync or waitAsync, shared under the given key.
+    // GFXRes::makeShared with the same key picks the result up.
+    template <class T, class Prepare, class ... Args>
+    GFXAsyncLoad loadAsync(const GFXContentKey& key, Prepare&& prepare,
+        Args&& ... args
+    ) {
+        using Prepared = std::invoke_result_t< std::decay_t<Prepare> >;
+        using Pending = detail::GFXPendingLoad< T, Prepared, std::decay_t<Args>... >;
+
+        std::lock_guard lock(mutex_);
+        auto state = std::make_shared<detail::GFXAsyncState>();
+
+        if ( auto id = sharedID(key); id && search(id.value()) ) {
+            state->id = id;
+            return GFXAsyncLoad(state);
+        }
+
+        if (!workers_) {
+            workers_ = std::make_unique<ThreadPool>();
+        }
+
+        pending_.push_back( std::make_unique<Pending>( key,
+            workers_->submit( std::forward<Prepare>(prepare) ),
+            state, std::forward<Args>(args)...
+        ) );
+
+        return GFXAsyncLoad(state);
+    }
+
+    // finalizes prepared asynchronous loads without blocking.
+    void syncAsync();
+
+    // finalizes every asynchronous load, blocking until prepared.
+    void waitAsync();
+
+    // wait-free, safe to call from any thread during a frame.
     std::optional<po::IPipelineObject*> get(const ID& id) const noexcept {
-        if ( auto it = resources_.find(id); it != resources_.end() ) {
-            return it->second.get();
+        if ( auto bindee = readTable_.get( id, frame_.load(std::memory_order_relaxed) ) )
+            [[likely]] {
+            return bindee;
         }
         return std::nullopt;
     }
 
     template <class Tag>
     std::optional<po::IPipelineObject*> get() const noexcept {
-        return get( typeid(Tag) );
-    }
-
-    std::optional<po::IPipelineObject*> get(std::type_index tagID) const noexcept {
-        if ( auto cache_res = IDCache_.at( tagID ); cache_res.hit() ) {
-            assert( resources_.contains( cache_res.value() ) );
-            return resources_.at( cache_res.value() ).get();
+        if ( auto id = taggedID( detail::GFXTagIndex<Tag>() ) ) {
+            return get( id.value() );
         }
         return std::nullopt;
     }
 
     bool search(const ID& id) const noexcept {
-        return resources_.contains(id);
+        return readTable_.contains(id);
     }
 
     template <class Tag>
     bool search() const noexcept {
-        return search( typeid(Tag) );
+        auto id = taggedID( detail::GFXTagIndex<Tag>() );
+        return id && search( id.value() );
+    }
+
+    bool search(const GFXContentKey& key) const noexcept {
+        auto id = sharedID(key);
+        return id && search( id.value() );
     }
 
-    bool search(std::type_index tagID) const noexcept {
-        return IDCache_.contains(tagID);
+    // invalidates the resource and its owner at once.
+    // every copy of the ID goes stale, the owner reloads on its next access.
+    // memory is reclaimed on the next advanceFrame.
+    [[maybe_unused]] bool unload(const ID& id) {
+        std::lock_guard lock(mutex_);
+        return unloadUnlocked(id);
     }
 
+    void adopt(const ID& id, const GFXRes* owner) {
+        std::lock_guard lock(mutex_);
+        if ( auto pManaged = resources_.find(id) ) {
+            pManaged->setOwner(owner);
+        }
+    }
+
+    void pin(const ID& id) {
+        std::lock_guard lock(mutex_);
+        if ( auto pManaged = resources_.find(id) ) {
+            pManaged->setPinned(true);
+        }
+    }
+
+    void unpin(const ID& id) {
+        std::lock_guard lock(mutex_);
+        if ( auto pManaged = resources_.find(id) ) {
+            pManaged->setPinned(false);
+        }
+    }
+
+    // bytes of loaded resources the storage tries to stay within.
+    // std::nullopt, the default, never evicts.
+    void setBudget(std::optional<std::size_t> bytes) {
+        std::lock_guard lock(mutex_);
+        budget_ = bytes;
+    }
+
+    std::optional<std::size_t> budget() const {
+        std::lock_guard lock(mutex_);
+        return budget_;
+    }
+
+    std::size_t usage() const noexcept {
+        return usage_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t frame() const noexcept {
+        return frame_.load(std::memory_order_relaxed);
+    }
+
+    // counters of the last frame closed by advanceFrame.
+    GFXStorageCounters frameCounters() const {
+        std::lock_guard lock(mutex_);
+        return frameCounters_;
+    }
+
+    // counters accumulated over every closed frame.
+    GFXStorageCounters totalCounters() const {
+        std::lock_guard lock(mutex_);
+        return totalCounters_;
+    }
+
+    // loaded resources by dynamic type, sorted by bytes in descending order.
+    std::vector< std::pair<std::type_index, GFXStorageFootprint> >
+        typeFootprints() const;
+
+    CategoryFootprints categoryFootprints() const {
+        std::lock_guard lock(mutex_);
+        return categoryFootprints_;
+    }
+
+    // closes a frame, must be called while no thread is inside get().
+    // frees resources unloaded before, then while over budget,
+    // unpinned resources not bound during the closed frame
+    // are evicted coldest first. their owners rebuild them on next access.
+    // IDs are valid within the frame they are taken from GFXRes,
+    // so take them again each frame rather than keeping them.
+    void advanceFrame();
+
 private:
-    static constexpr std::size_t IDCACHE_CACHELINE_SIZE = 0x08u;
-    static constexpr std::size_t IDCACHE_NUM_CACHELINE = 0x40u;
-    
-    LRUCache< std::type_index, ID > IDCache_;
-    std::map< ID, ManagedBindable > resources_;
+    template <class T, class ... Args>
+    const Pair loadUnlocked(const GFXRes* owner, Args&& ... args) {
+        auto& pool = this->pool<T>();
+        auto bindee = pool.create(std::forward<Args>(args)...);
+        auto id = resources_.emplace( ManagedBindable(bindee, owner, &pool) );
+
+        try {
+            readTable_.publish( id, bindee, frame_.load(std::memory_order_relaxed) );
+        }
+        catch (...) {
+            resources_.erase(id);
+            throw;
+        }
+        usage_.fetch_add( resources_.at(id).footprint(), std::memory_order_relaxed );
+        nLoad_.fetch_add(1u, std::memory_order_relaxed);
+        account( *bindee, resources_.at(id).footprint(), true );
+
+        return Pair{id, bindee};
+    }
+
+    bool unloadUnlocked(const ID& id);
+    // unloads unpinned resources unused since the closed frame,
+    // coldest first, until the usage is within the budget.
+    void evict(std::uint64_t closed);
+
+    void account( const po::IPipelineObject& bindee, std::size_t footprint,
+        bool bLoaded
+    );
+
+    template <class T>
+    detail::GFXPool<T>& pool() {
+        auto& pPool = pools_[ std::type_index( typeid(T) ) ];
+        if (!pPool) {
+            pPool = std::make_unique< detail::GFXPool<T> >();
+        }
+        return static_cast< detail::GFXPool<T>& >(*pPool);
+    }
+
+    std::optional<ID> taggedID(std::size_t idxTag) const noexcept {
+        return tagIDs_.get(idxTag);
+    }
+
+    std::optional<ID> sharedID(const GFXContentKey& key) const {
+        std::shared_lock lookupLock(lookupMutex_);
+        if ( auto it = sharedIDs_.find(key); it != sharedIDs_.end() ) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    // serializes writers. recursive, as releasing a bindee
+    // may destroy GFXRes which unload through this storage again.
+    mutable std::recursive_mutex mutex_;
+    // guards the content key table against readers.
+    mutable std::shared_mutex lookupMutex_;
+    detail::GFXTagTable tagIDs_;
+    std::unordered_map< GFXContentKey, ID, GFXContentKey::Hash > sharedIDs_;
+    // pools must outlive resources, which release into them.
+    std::unordered_map< std::type_index,
+        std::unique_ptr<detail::GFXPoolBase> > pools_;
+    detail::GFXReadTable readTable_;
+    SlotMap< ManagedBindable > resources_;
+    std::vector< ManagedBindable > retired_;
+    std::optional<std::size_t> budget_;
+    std::atomic<std::size_t> usage_;
+    std::atomic<std::uint64_t> frame_;
+    std::vector< std::pair<std::uint64_t, ID> > evictCandidates_;
+    // counted during the current frame, may be bumped by readers.
+    std::atomic<std::size_t> nHit_;
+    std::atomic<std::size_t> nMiss_;
+    std::atomic<std::size_t> nLoad_;
+    std::atomic<std::size_t> nReconstruct_;
+    std::atomic<std::size_t> nEvict_;
+    GFXStorageCounters frameCounters_;
+    GFXStorageCounters totalCounters_;
+    std::unordered_map< std::type_index, GFXStorageFootprint > typeFootprints_;
+    CategoryFootprints categoryFootprints_;
+    std::vector< std::unique_ptr<detail::GFXPendingLoadBase> > pending_;
+    // destroyed first, joining workers before anything they may touch.
+    std::unique_ptr<ThreadPool> workers_;
 };
 
+template <class T, class Prepared, class ... Args>
+void detail::GFXPendingLoad<T, Prepared, Args...>::finalize(GFXStorage& storage) {
+    // rethrows on this thread if the preparation failed.
+    auto prepared = prepared_.get();
+
+    state_->id = std::apply( [&](auto& ... args) {
+        return storage.share<T>( nullptr, key_, args..., std::move(prepared) ).id;
+    }, args_ );
+}
+
+// cached and shared resources have no single owner to be invalidated,
+// so they are looked up instead.
+inline bool GFXRes::valid() const noexcept {
+    if ( !stored_.has_value() ) {
+        return false;
+    }
+
+    switch (genMode_) {
+    case GenMode::Cache:
+    case GenMode::Share:
+        return pStorage_->search( stored_.value().id );
+
+    default:
+        return true;
+    }
+}
+
+// factories capture packed arguments by value,
+// and pass them as lvalues on every (re)construction.
 template <class T, class ... Args>
     requires std::is_base_of_v<po::IPipelineObject, T>
-Generator<GFXRes::Pair> GFXRes::makeGenStandAlone(Args ... args) {
-    for (;;) {
-        co_yield Pair{
-            .id = detail::makeGFXResID(),
+GFXRes::Factory GFXRes::makeFactoryStandAlone(Args ... args) {
+    return Factory( [...args = std::move(args)]() mutable {
+        return Pair{
+            .id = detail::makeStandAloneID(),
             .bindee = new T(unpackArg(args)...)
         };
-    }
+    } );
 }
 
 template <class T, class ... Args>
     requires std::is_base_of_v<po::IPipelineObject, T>
-Generator<GFXRes::Pair> GFXRes::makeGenStorageLoad(
+GFXRes::Factory GFXRes::makeFactoryStorageLoad(
     GFXStorage& storage, Args ... args
 ) {
-    for (;;) {
-        co_yield storage.load<T>(this, unpackArg(args)...);
-    }
+    return Factory( [&storage, ...args = std::move(args)]() mutable {
+        return storage.load<T>(nullptr, unpackArg(args)...);
+    } );
 }
 
 template <class T, class Tag, class ... Args>
     requires std::is_base_of_v<po::IPipelineObject, T>
-Generator<GFXRes::Pair> GFXRes::makeGenStorageCache(
+GFXRes::Factory GFXRes::makeFactoryStorageCache(
     GFXStorage& storage, Tag tag, Args ... args
 ) {
-    for (;;) {
-        co_yield storage.cache<T>(this, tag, unpackArg(args)...);
-    }
+    return Factory( [&storage, tag, ...args = std::move(args)]() mutable {
+        return storage.cache<T>(nullptr, tag, unpackArg(args)...);
+    } );
+}
+
+template <class T, class ... Args>
+    requires std::is_base_of_v<po::IPipelineObject, T>
+GFXRes::Factory GFXRes::makeFactoryStorageShare(
+    GFXStorage& storage, GFXContentKey key, Args ... args
+) {
+    return Factory( [&storage, key, ...args = std::move(args)]() mutable {
+        return storage.share<T>(nullptr, key, unpackArg(args)...);
+    } );
 }
 
 }   // namespace gfx
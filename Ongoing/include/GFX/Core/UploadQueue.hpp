@@ -0,0 +1,22 @@
+#ifndef __UploadQueue
+#define __UploadQueue
+
+#include "BasicUploadQueue.hpp"
+
+#include <d3d11.h>
+#include "Namespaces.hpp"
+
+namespace gfx {
+
+// writes to default usage buffers, held until the next draw
+// to be issued in as few UpdateSubresource calls as possible.
+// constant buffers can't be written in part, stage them whole.
+class GFXUploadQueue
+    : public GFXBasicUploadQueue< wrl::ComPtr<ID3D11Buffer> > {
+public:
+    void flush(ID3D11DeviceContext* pContext);
+};
+
+}   // namespace gfx
+
+#endif  // __UploadQueue
@@ -0,0 +1,121 @@
+#ifndef __UploadRing
+#define __UploadRing
+
+#include "Factory.hpp"
+#include "GFX/PipelineObjects/PipelineObject.hpp"
+
+#include <d3d11_1.h>
+#include "Namespaces.hpp"
+
+#include <vector>
+#include <span>
+#include <optional>
+#include <cstddef>
+
+namespace gfx {
+
+class GFXPipeline;
+
+class GFXUploadRingBinder
+    : public po::SlotBinderInterface<GFXUploadRingBinder> {
+public:
+    friend class po::SlotBinderInterface<GFXUploadRingBinder>;
+
+private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::VSCBuffer;
+
+    // the offset is a part of what is bound.
+    static GFXBindKey bindKey( ID3D11DeviceContext1*, ID3D11Buffer* pBuffer,
+        UINT firstConstant, UINT nConstant
+    ) noexcept {
+        return GFXBindKey(pBuffer, firstConstant, nConstant);
+    }
+
+    void doBind( GFXPipeline& pipeline, UINT slot,
+        ID3D11DeviceContext1* pContext, ID3D11Buffer* pBuffer,
+        UINT firstConstant, UINT nConstant
+    );
+};
+
+// one dynamic constant buffer per-draw constants are packed into,
+// bound at offsets instead of mapping a buffer per draw.
+// a frame's draws are staged first, writing their constants to memory,
+// which is uploaded with one map.
+// then they are replayed in the same order, each taking what it staged.
+// uploads are appended without overwrite, ahead of what was drawn,
+// and the buffer is discarded only when they wrap around.
+class GFXUploadRing {
+public:
+    // offsets are counted in 16 constants of 16 bytes.
+    static constexpr std::size_t alignment = 256u;
+
+    struct Allocation {
+        UINT firstConstant;
+        UINT nConstant;
+    };
+
+    // false if the device can't bind constant buffers at offsets.
+    static bool supported(GFXFactory factory);
+
+    // grows if a frame stages more than the capacity.
+    explicit GFXUploadRing( GFXFactory factory,
+        std::size_t capacity = 1u << 20u
+    );
+
+    // drops what was staged or left untaken before.
+    void beginStaging();
+    void stage(std::span<const std::byte> bytes);
+    // one map for everything staged, taken back in the staged order.
+    void upload(GFXPipeline& pipeline);
+
+    bool staging() const noexcept {
+        return bStaging_;
+    }
+
+    // none once every upload is taken.
+    std::optional<Allocation> take() noexcept;
+
+    void bindVS(GFXPipeline& pipeline, UINT slot, const Allocation& alloc);
+
+    GFXFactory factory() const noexcept {
+        return factory_;
+    }
+
+    std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    // maps issued so far.
+    std::size_t nMap() const noexcept {
+        return nMap_;
+    }
+
+private:
+    struct Staged {
+        std::size_t offset;     // from the beginning of the stage
+        std::size_t size;
+    };
+
+    void create(std::size_t capacity);
+
+    GFXFactory factory_;
+    wrl::ComPtr<ID3D11Buffer> pBuffer_;
+    wrl::ComPtr<ID3D11DeviceContext1> pContext_;
+    GFXUploadRingBinder binder_;
+    std::size_t capacity_;
+    // where the next upload goes, all before is in flight.
+    std::size_t head_;
+    // where the last upload went.
+    std::size_t base_;
+    // drivers may only discard dynamic constant buffers.
+    bool bNoOverwrite_;
+    bool bStaging_;
+    std::vector<std::byte> stage_;
+    std::vector<Staged> staged_;
+    std::size_t nTaken_;
+    std::size_t nMap_;
+};
+
+}   // namespace gfx
+
+#endif  // __UploadRing
@@ -16,6 +16,9 @@
 #include <algorithm>
 #include <concepts>
 #include <functional>
+#include <span>
+#include <cstring>
+#include <cassert>
 
 namespace gfx {
 namespace po {
@@ -33,9 +36,19 @@ public:
         );
     }
 
+    // contents are left undefined, for buffers written before use.
+    Buffer( GFXFactory factory,
+        const D3D11_BUFFER_DESC& bufferDesc
+    ) : desc_(bufferDesc), data_() {
+        GFX_THROW_FAILED(
+            factory.device()->CreateBuffer(&bufferDesc, nullptr, &data_)
+        );
+    }
+
     // https://learn.microsoft.com/en-us/windows/win32/direct3d11/how-to--use-dynamic-resources
-    // there's a room for enhancing performance
-    // by using D3D11_MAP_WRITE_NO_OVERWRITE and D3D11_MAP_WRITE_DISCARD interleaved.
+    // renames the buffer on every call.
+    // per-draw constants go through GFXUploadRing instead,
+    // which writes with D3D11_MAP_WRITE_NO_OVERWRITE.
     template <class BufferGetter>
         requires std::convertible_to< std::invoke_result_t<BufferGetter>, void* >
             || std::convertible_to< std::invoke_result_t<BufferGetter>, const void* >
@@ -61,17 +74,20 @@ public:
         );
     }
 
+    // written whole before the next draw, merged with other staged writes.
     template <class BufferGetter>
         requires std::convertible_to< std::invoke_result_t<BufferGetter>, void* >
             || std::convertible_to< std::invoke_result_t<BufferGetter>, const void* >
     void stage(GFXPipeline& pipeline, BufferGetter&& getter) {
         const void* updated = std::invoke( std::forward<BufferGetter>(getter) );
 
-        GFX_THROW_FAILED_VOID(
-            pipeline.context()->UpdateSubresource(
-                data().Get(), 0, nullptr, updated, 0, 0
-            )
-        );
+        pipeline.uploadQueue().stage( data(), 0u, std::span(
+            static_cast<const std::byte*>(updated), desc_.ByteWidth
+        ) );
+    }
+
+    D3D11_USAGE usage() const noexcept {
+        return desc_.Usage;
     }
 
     const wrl::ComPtr<ID3D11Buffer> data() const {
@@ -82,6 +98,14 @@ public:
         return data_;
     }
 
+    std::size_t footprint() const noexcept override {
+        return desc_.ByteWidth;
+    }
+
+    FootprintCategory footprintCategory() const noexcept override {
+        return FootprintCategory::Buffer;
+    }
+
 private:
     virtual void bind(GFXPipeline& pipeline) = 0;
 
@@ -94,6 +118,14 @@ public:
     friend class SlotBinderInterface<VertexBufferBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::VertexBuffer;
+
+    static GFXBindKey bindKey( ID3D11Buffer** pBuffers,
+        const UINT* strides, const UINT* offsets
+    ) noexcept {
+        return GFXBindKey(*pBuffers, *strides, *offsets);
+    }
+
     void doBind(GFXPipeline& pipeline, UINT slot, ID3D11Buffer** pBuffers,
         const UINT* strides, const UINT* offsets
     );
@@ -155,7 +187,7 @@ private:
         const auto stride = static_cast<UINT>( sizeof(MyVertex) );
         const auto offset = static_cast<UINT>( 0u );
 
-        [[maybe_unused]] auto bBindOccured = binder_.bind( slot_,
+        [[maybe_unused]] auto bBindOccured = binder_.bind(
             pipeline, slot_, data().GetAddressOf(), &stride, &offset
         );
 
@@ -174,11 +206,114 @@ private:
     UINT slot_;
 };
 
+// per-instance vertex data, rewritten every frame.
+// holds up to capacity() instances, recreate it to grow.
+template <class InstanceT>
+class InstanceBuffer : public Buffer,
+    public SlotLocalRebindInterface< InstanceBuffer<InstanceT> > {
+public:
+    using MyInstance = InstanceT;
+    friend class SlotLocalRebindInterface< InstanceBuffer<InstanceT> >;
+
+    InstanceBuffer( GFXFactory factory, std::size_t capacity
+    #ifdef ACTIVATE_BINDABLE_LOG
+        , bool enableLogOnCreation = true
+    #endif
+    ) : Buffer( std::move(factory),
+            D3D11_BUFFER_DESC{
+                .ByteWidth = static_cast<UINT>(
+                    capacity * sizeof(MyInstance)
+                ),
+                .Usage = D3D11_USAGE_DYNAMIC,
+                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+                .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+                .MiscFlags = 0,
+                .StructureByteStride = sizeof(MyInstance)
+            }
+        ),
+    #ifdef ACTIVATE_BINDABLE_LOG
+        logComponent_( this, GFXCMDSourceCategory("InstanceBuffer") ),
+    #endif
+        binder_(), slot_(), capacity_(capacity) {
+    #ifdef ACTIVATE_BINDABLE_LOG
+        if (enableLogOnCreation) {
+            logComponent_.enableLog();
+        }
+        logComponent_.logCreate();
+    #endif
+    }
+
+    // the buffer is renamed on update, so it needn't be bound again.
+    void update( GFXPipeline& pipeline,
+        std::span<const MyInstance> instances
+    ) {
+        assert( instances.size() <= capacity_ );
+
+        auto mapped = D3D11_MAPPED_SUBRESOURCE{};
+        GFX_THROW_FAILED(
+            pipeline.context()->Map( data().Get(), 0u,
+                D3D11_MAP_WRITE_DISCARD, 0, &mapped
+            )
+        );
+
+        std::ranges::copy( instances,
+            static_cast<MyInstance*>(mapped.pData)
+        );
+
+        GFX_THROW_FAILED_VOID(
+            pipeline.context()->Unmap( data().Get(), 0 )
+        );
+    }
+
+    std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    UINT slot() const noexcept {
+        return slot_;
+    }
+
+    void setSlot(UINT val) noexcept {
+        slot_ = val;
+    }
+
+private:
+    void bind(GFXPipeline& pipeline) override final {
+        const auto stride = static_cast<UINT>( sizeof(MyInstance) );
+        const auto offset = static_cast<UINT>( 0u );
+
+        [[maybe_unused]] auto bBindOccured = binder_.bind(
+            pipeline, slot_, data().GetAddressOf(), &stride, &offset
+        );
+
+    #ifdef ACTIVATE_BINDABLE_LOG
+        if (bBindOccured) {
+            logComponent_.logBind();
+        }
+    #endif
+    }
+
+#ifdef ACTIVATE_BINDABLE_LOG
+    IPipelineObject::LogComponent logComponent_;
+#endif
+    VertexBufferBinder binder_;
+    UINT slot_;
+    std::size_t capacity_;
+};
+
 class IndexBufferBinder : public BinderInterface<IndexBufferBinder> {
 public:
     friend class BinderInterface<IndexBufferBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::IndexBuffer;
+
+    static GFXBindKey bindKey( ID3D11Buffer* pBuffer,
+        DXGI_FORMAT indexFormat
+    ) noexcept {
+        return GFXBindKey(pBuffer, indexFormat);
+    }
+
     void doBind(GFXPipeline& pipeline, ID3D11Buffer* pBuffer,
         DXGI_FORMAT indexFormat
     );
@@ -304,6 +439,13 @@ public:
     friend class SlotBinderInterface<VSCBufferBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::VSCBuffer;
+
+    // a buffer rewritten by dynamicUpdate stays bound, so it keeps its key.
+    static GFXBindKey bindKey(ID3D11Buffer** pBuffers) noexcept {
+        return GFXBindKey(*pBuffers);
+    }
+
     void doBind(GFXPipeline& pipeline, UINT slot, ID3D11Buffer** pBuffers);
 };
 
@@ -346,7 +488,7 @@ public:
 
 private:
     void bind(GFXPipeline& pipeline) override final {
-        [[maybe_unused]] auto bBindOccured = binder_.bind( slot_,
+        [[maybe_unused]] auto bBindOccured = binder_.bind(
             pipeline, slot_, data().GetAddressOf()
         );
 
@@ -369,6 +511,12 @@ public:
     friend class SlotBinderInterface<PSCBufferBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::PSCBuffer;
+
+    static GFXBindKey bindKey(ID3D11Buffer** pBuffers) noexcept {
+        return GFXBindKey(*pBuffers);
+    }
+
     void doBind(GFXPipeline& pipeline, UINT slot, ID3D11Buffer** pBuffers);
 };
 
@@ -411,7 +559,7 @@ public:
 
 private:
     void bind(GFXPipeline& pipeline) override final {
-        [[maybe_unused]] auto bBindOccured = binder_.bind( slot_,
+        [[maybe_unused]] auto bBindOccured = binder_.bind(
             pipeline, slot_, data().GetAddressOf()
         );
 
@@ -429,6 +577,50 @@ private:
     PSCBufferBinder binder_;
 };
 
+// a constant buffer of one value, with a copy of what it last uploaded,
+// so that values written unchanged aren't uploaded again.
+// values are compared bytewise, spurious differences only cost an upload.
+template <class CBufT>
+    requires std::is_trivially_copyable_v<typename CBufT::MyValue>
+class ShadowedCBuffer : public CBufT {
+public:
+    using MyValue = typename CBufT::MyValue;
+
+    // uploaded is what the buffer was created with.
+    template <class ... Args>
+    ShadowedCBuffer(const MyValue& uploaded, Args&& ... args)
+        : CBufT( std::forward<Args>(args)... ), uploaded_() {
+        std::memcpy( &uploaded_, &uploaded, sizeof(MyValue) );
+    }
+
+    void update(GFXPipeline& pipeline, const MyValue& value) {
+        const auto bSkipped = std::memcmp(
+            &uploaded_, &value, sizeof(MyValue)
+        ) == 0;
+        pipelineState(pipeline).countUpload(bSkipped);
+
+        if (bSkipped) {
+            return;
+        }
+
+        const auto getter = [&value]() {
+            return static_cast<const void*>(&value);
+        };
+
+        if (this->usage() == D3D11_USAGE_DYNAMIC) {
+            this->dynamicUpdate(pipeline, getter);
+        }
+        else {
+            this->stage(pipeline, getter);
+        }
+
+        std::memcpy( &uploaded_, &value, sizeof(MyValue) );
+    }
+
+private:
+    MyValue uploaded_;
+};
+
 }   // namespace gfx::po
 }   // namespace gfx
 
@@ -103,6 +103,11 @@ protected:
 
 private:
     virtual void drawCall(GFXPipeline& pipeline) const = 0;
+    // the same geometry nInstance times, instance data read from
+    // an instance buffer rather than from draw contexts.
+    virtual void drawCallInstanced( GFXPipeline& pipeline,
+        UINT nInstance
+    ) const = 0;
 
     std::vector<IDrawContext*> drawContexts_;
 };
@@ -147,6 +152,9 @@ protected:
 
 private:
     void drawCall(GFXPipeline& pipeline) const override;
+    void drawCallInstanced( GFXPipeline& pipeline,
+        UINT nInstance
+    ) const override;
 
 #ifdef ACTIVATE_DRAWCALLER_LOG
     BasicDrawCaller::LogComponent logComponent_;
@@ -205,6 +213,9 @@ protected:
 
 private:
     void drawCall(GFXPipeline& pipeline) const override;
+    void drawCallInstanced( GFXPipeline& pipeline,
+        UINT nInstance
+    ) const override;
 
 #ifdef ACTIVATE_DRAWCALLER_LOG
     BasicDrawCaller::LogComponent logComponent_;
@@ -4,8 +4,10 @@
 #define ACTIVATE_BINDABLE_LOG
 
 #include "GFX/Core/CMDLogger.hpp"
+#include "GFX/Core/PipelineState.hpp"
 
 #include <utility>
+#include <cstddef>
 #include <array>
 #include <ranges>
 #include <algorithm>
@@ -14,13 +16,31 @@ namespace gfx {
 
 class GFXPipeline;
 
+// shadow of the context the pipeline drives, defined in Pipeline.hpp.
+inline GFXPipelineState& pipelineState(GFXPipeline& pipeline) noexcept;
+
 namespace po {
 
+// what a pipeline object's footprint is spent on.
+enum class FootprintCategory {
+    Buffer, Texture, Shader, Other, Count
+};
+
 class IPipelineObject {
 public:
     friend class GFXPipeline;
 
-    virtual ~IPipelineObject() = 0 {}
+    virtual ~IPipelineObject() = 0;
+
+    // approximate bytes of memory held by the object,
+    // used by GFXStorage to keep loaded resources within a budget.
+    virtual std::size_t footprint() const noexcept {
+        return 0u;
+    }
+
+    virtual FootprintCategory footprintCategory() const noexcept {
+        return FootprintCategory::Other;
+    }
 
 #ifdef ACTIVATE_BINDABLE_LOG
 protected:
@@ -32,6 +52,8 @@ private:
     virtual void bind(GFXPipeline& pipeline) = 0;
 };
 
+inline IPipelineObject::~IPipelineObject() {}
+
 #ifdef ACTIVATE_BINDABLE_LOG
 class IPipelineObject::LogComponent {
 public:
@@ -127,17 +149,22 @@ public:
         bGlobalRebindTemporary = false;
     }
 
+    // T provides bindPoint, bindKey(args...) and doBind(pipeline, args...).
+    // the bind is elided when the pipeline already holds the same key.
     template <class ... Args>
-    [[maybe_unused]] bool bind(Args&& ... args) {
-        if (pLastBinder == this) {
-            if ( !(localRebindEnabled() || globalRebindEnabled()) ) {
-                return false;
-            }
-        }
+    [[maybe_unused]] bool bind(GFXPipeline& pipeline, Args&& ... args) {
+        auto& state = pipelineState(pipeline);
+        const auto key = T::bindKey(args...);
 
-        pLastBinder = this;
+        if ( state.isBound(T::bindPoint, 0u, key)
+            && !(localRebindEnabled() || globalRebindEnabled())
+        ) {
+            state.elide();
+            return false;
+        }
 
-        static_cast<T*>(this)->doBind( std::forward<Args>(args)... );
+        static_cast<T*>(this)->doBind( pipeline, std::forward<Args>(args)... );
+        state.record(T::bindPoint, 0u, key);
 
         bGlobalRebindTemporary = false;
         bLocalRebindTemporary_ = false;
@@ -146,16 +173,12 @@ public:
     }
 
 private:
-    static const BinderInterface* pLastBinder;
     static bool bGlobalRebindEnabled;
     static bool bGlobalRebindTemporary;
     bool bLocalRebindEnabled_;
     bool bLocalRebindTemporary_;
 };
 
-template <class T>
-const BinderInterface<T>* BinderInterface<T>::pLastBinder;
-
 template <class T>
 bool BinderInterface<T>::bGlobalRebindEnabled = false;
 
@@ -164,9 +187,9 @@ bool BinderInterface<T>::bGlobalRebindTemporary = false;
 
 namespace detail {
 // if shader utilizes slots over than gMaximumSlots,
-// update gMaximumSlots with higher value,
+// update GFXPipelineState::nSlot with higher value,
 // or SEGFAULT will take place.
-inline constexpr std::size_t gMaximumSlots = 32u;
+inline constexpr std::size_t gMaximumSlots = GFXPipelineState::nSlot;
 }
 
 template <class T>
@@ -210,17 +233,26 @@ public:
         bGlobalRebindTemporary[slot] = false;
     }
 
+    // T provides bindPoint, bindKey(args...)
+    // and doBind(pipeline, slot, args...).
     template <class ... Args>
-    [[maybe_unused]] bool bind(std::size_t slot, Args&& ... args) {
-        if ( pLastBinder[slot] == this &&
-            !(localRebindEnabled(slot) || globalRebindEnabled(slot))
+    [[maybe_unused]] bool bind( GFXPipeline& pipeline, std::size_t slot,
+        Args&& ... args
+    ) {
+        auto& state = pipelineState(pipeline);
+        const auto key = T::bindKey(args...);
+
+        if ( state.isBound(T::bindPoint, slot, key)
+            && !(localRebindEnabled(slot) || globalRebindEnabled(slot))
         ) {
+            state.elide();
             return false;
         }
 
-        pLastBinder[slot] = this;
-
-        static_cast<T*>(this)->doBind( std::forward<Args>(args)... );
+        static_cast<T*>(this)->doBind( pipeline,
+            static_cast<unsigned int>(slot), std::forward<Args>(args)...
+        );
+        state.record(T::bindPoint, slot, key);
         
         bGlobalRebindTemporary[slot] = false;
         bLocalRebindTemporary_[slot] = false;
@@ -229,19 +261,12 @@ public:
     }
 
 private:
-    static std::array< const SlotBinderInterface<T>*,
-        detail::gMaximumSlots
-    > pLastBinder;
     static std::array<bool, detail::gMaximumSlots> bGlobalRebindEnabled;
     static std::array<bool, detail::gMaximumSlots> bGlobalRebindTemporary;
     std::array<bool, detail::gMaximumSlots> bLocalRebindEnabled_;
     std::array<bool, detail::gMaximumSlots> bLocalRebindTemporary_;
 };
 
-template <class T>
-std::array< const SlotBinderInterface<T>*, detail::gMaximumSlots >
-SlotBinderInterface<T>::pLastBinder { nullptr };
-
 template <class T>
 std::array<bool, detail::gMaximumSlots>
 SlotBinderInterface<T>::bGlobalRebindEnabled { false };
@@ -0,0 +1,146 @@
+#ifndef __PipelineStateObject
+#define __PipelineStateObject
+
+#include "PipelineObject.hpp"
+#include "Shader.hpp"
+#include "Topology.hpp"
+#include "Viewport.hpp"
+#include "GFX/Core/Pipeline.hpp"
+
+#include <d3d11.h>
+#include "GFX/Core/Namespaces.hpp"
+#include "GFX/Core/Exception.hpp"
+
+#include <cstdint>
+
+namespace gfx {
+namespace po {
+
+class RasterizerStateBinder : public BinderInterface<RasterizerStateBinder> {
+public:
+    friend class BinderInterface<RasterizerStateBinder>;
+
+private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::Rasterizer;
+
+    static GFXBindKey bindKey(ID3D11RasterizerState* pState) noexcept {
+        return GFXBindKey(pState);
+    }
+
+    void doBind(GFXPipeline& pipeline, ID3D11RasterizerState* pState) {
+        GFX_THROW_FAILED_VOID(
+            pipeline.context()->RSSetState(pState)
+        );
+    }
+};
+
+class BlendStateBinder : public BinderInterface<BlendStateBinder> {
+public:
+    friend class BinderInterface<BlendStateBinder>;
+
+private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::Blend;
+
+    static GFXBindKey bindKey(ID3D11BlendState* pState) noexcept {
+        return GFXBindKey(pState);
+    }
+
+    void doBind(GFXPipeline& pipeline, ID3D11BlendState* pState) {
+        GFX_THROW_FAILED_VOID(
+            pipeline.context()->OMSetBlendState(pState, nullptr, 0xffffffffu)
+        );
+    }
+};
+
+class DepthStencilStateBinder
+    : public BinderInterface<DepthStencilStateBinder> {
+public:
+    friend class BinderInterface<DepthStencilStateBinder>;
+
+private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::DepthStencil;
+
+    static GFXBindKey bindKey(ID3D11DepthStencilState* pState) noexcept {
+        return GFXBindKey(pState);
+    }
+
+    // stencil isn't used, so the reference is left 0.
+    void doBind(GFXPipeline& pipeline, ID3D11DepthStencilState* pState) {
+        GFX_THROW_FAILED_VOID(
+            pipeline.context()->OMSetDepthStencilState(pState, 0u)
+        );
+    }
+};
+
+class PipelineStateObject;
+
+class PipelineStateBinder : public BinderInterface<PipelineStateBinder> {
+public:
+    friend class BinderInterface<PipelineStateBinder>;
+
+private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::PipelineState;
+
+    static GFXBindKey bindKey(PipelineStateObject* pPSO) noexcept;
+
+    void doBind(GFXPipeline& pipeline, PipelineStateObject* pPSO);
+};
+
+// what a pipeline state object binds besides its shaders.
+// null states stand for the defaults of D3D11.
+struct PipelineStateDesc {
+    D3D11_PRIMITIVE_TOPOLOGY topology;
+    D3D11_VIEWPORT viewport;
+    wrl::ComPtr<ID3D11RasterizerState> pRasterizerState = nullptr;
+    wrl::ComPtr<ID3D11BlendState> pBlendState = nullptr;
+    wrl::ComPtr<ID3D11DepthStencilState> pDepthStencilState = nullptr;
+};
+
+// shaders, input layout, topology, viewport and
+// rasterizer, blend and depth stencil states, never changed once made.
+// binding it again is one comparison,
+// binding another pushes only the parts that differ.
+class PipelineStateObject : public IPipelineObject,
+    public LocalRebindInterface<PipelineStateObject> {
+public:
+    friend class LocalRebindInterface<PipelineStateObject>;
+    friend class PipelineStateBinder;
+
+    PipelineStateObject( const VertexShader& vertexShader,
+        const PixelShader& pixelShader, const PipelineStateDesc& desc
+    #ifdef ACTIVATE_BINDABLE_LOG
+        , bool enableLogOnCreation = true
+    #endif
+    );
+
+    const PipelineStateDesc& desc() const noexcept {
+        return desc_;
+    }
+
+private:
+    void bind(GFXPipeline& pipeline) override final;
+    void bindParts(GFXPipeline& pipeline);
+
+#ifdef ACTIVATE_BINDABLE_LOG
+    IPipelineObject::LogComponent logComponent_;
+#endif
+    // identifies it while bound, as addresses are reused.
+    std::uint64_t serial_;
+    wrl::ComPtr<ID3D11VertexShader> pVertexShader_;
+    wrl::ComPtr<ID3D11InputLayout> pInputLayout_;
+    wrl::ComPtr<ID3D11PixelShader> pPixelShader_;
+    PipelineStateDesc desc_;
+    PipelineStateBinder binder_;
+    VertexShaderBinder vertexShaderBinder_;
+    PixelShaderBinder pixelShaderBinder_;
+    TopologyBinder topologyBinder_;
+    ViewportBinder viewportBinder_;
+    RasterizerStateBinder rasterizerStateBinder_;
+    BlendStateBinder blendStateBinder_;
+    DepthStencilStateBinder depthStencilStateBinder_;
+};
+
+}   // namespace gfx::po
+}   // namespace gfx
+
+#endif  // __PipelineStateObject
@@ -16,6 +16,14 @@ public:
     friend class BinderInterface<RenderTargetBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::RenderTarget;
+
+    static GFXBindKey bindKey( ID3D11RenderTargetView** pRTVs,
+        ID3D11DepthStencilView* pDSV
+    ) noexcept {
+        return GFXBindKey(*pRTVs, pDSV);
+    }
+
     void doBind(GFXPipeline& pipeline, ID3D11RenderTargetView** pRTVs,
         ID3D11DepthStencilView* pDSV
     );
@@ -17,6 +17,12 @@ public:
     friend class SlotBinderInterface<SamplerBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::PSSampler;
+
+    static GFXBindKey bindKey(ID3D11SamplerState* pSampler) noexcept {
+        return GFXBindKey(pSampler);
+    }
+
     void doBind( GFXPipeline& pipeline, UINT slot, 
         ID3D11SamplerState* pSampler
     );
@@ -21,6 +21,14 @@ public:
     friend class BinderInterface<VertexShaderBinder>; 
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::VertexShader;
+
+    static GFXBindKey bindKey( ID3D11VertexShader* pShader,
+        ID3D11InputLayout* pIA
+    ) noexcept {
+        return GFXBindKey(pShader, pIA);
+    }
+
     void doBind(GFXPipeline& pipeline, ID3D11VertexShader* pShader,
         ID3D11InputLayout* pIA
     );
@@ -82,6 +90,22 @@ public:
         return byteCodeBlob()->GetBufferSize();
     }
 
+    std::size_t footprint() const noexcept override {
+        return byteCodeLength();
+    }
+
+    ID3D11VertexShader* shader() const noexcept {
+        return pVertexShader_.Get();
+    }
+
+    ID3D11InputLayout* inputLayout() const noexcept {
+        return pInputLayout_.Get();
+    }
+
+    FootprintCategory footprintCategory() const noexcept override {
+        return FootprintCategory::Shader;
+    }
+
 private:
     void bind(GFXPipeline& pipeline) override final;
 
@@ -99,6 +123,12 @@ public:
     friend class BinderInterface<PixelShaderBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::PixelShader;
+
+    static GFXBindKey bindKey(ID3D11PixelShader* pShader) noexcept {
+        return GFXBindKey(pShader);
+    }
+
     void doBind(GFXPipeline& pipeline, ID3D11PixelShader* pShader);
 };
 
@@ -125,6 +155,19 @@ public:
     const SIZE_T byteCodeLength() const noexcept {
         return byteCodeBlob()->GetBufferSize();
     }
+
+    std::size_t footprint() const noexcept override {
+        return byteCodeLength();
+    }
+
+    ID3D11PixelShader* shader() const noexcept {
+        return pPixelShader_.Get();
+    }
+
+    FootprintCategory footprintCategory() const noexcept override {
+        return FootprintCategory::Shader;
+    }
+
 private:
     void bind(GFXPipeline& pipeline) override final;
 
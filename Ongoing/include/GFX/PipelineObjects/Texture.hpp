@@ -19,6 +19,12 @@ public:
     friend class SlotBinderInterface<TextureBinder>; 
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::PSShaderResource;
+
+    static GFXBindKey bindKey(ID3D11ShaderResourceView** srv) noexcept {
+        return GFXBindKey(*srv);
+    }
+
     void doBind( GFXPipeline& pipeline, UINT slot,
         ID3D11ShaderResourceView** srv
     );
@@ -43,6 +49,14 @@ public:
         slot_ = val;
     }
 
+    std::size_t footprint() const noexcept override {
+        return footprint_;
+    }
+
+    FootprintCategory footprintCategory() const noexcept override {
+        return FootprintCategory::Texture;
+    }
+
 private:
     void bind(GFXPipeline& pipeline) override final;
 
@@ -51,6 +65,7 @@ private:
 #endif
     wrl::ComPtr<ID3D11ShaderResourceView> pSRV_;
     UINT slot_;
+    std::size_t footprint_;
     TextureBinder binder_;
 };
 
@@ -16,6 +16,12 @@ public:
     friend class BinderInterface<TopologyBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::Topology;
+
+    static GFXBindKey bindKey(D3D11_PRIMITIVE_TOPOLOGY topology) noexcept {
+        return GFXBindKey(topology);
+    }
+
     void doBind(GFXPipeline& pipeline, D3D11_PRIMITIVE_TOPOLOGY topology) {
         GFX_THROW_FAILED_VOID(
             pipeline.context()->IASetPrimitiveTopology(topology)
@@ -16,6 +16,17 @@ public:
     friend class BinderInterface<ViewportBinder>;
 
 private:
+    static constexpr GFXBindPoint bindPoint = GFXBindPoint::Viewport;
+
+    // keyed by value, so the viewport can be modified through data().
+    static GFXBindKey bindKey(D3D11_VIEWPORT* pViewport) noexcept {
+        return GFXBindKey(
+            GFXBindKey::pack(pViewport->TopLeftX, pViewport->TopLeftY),
+            GFXBindKey::pack(pViewport->Width, pViewport->Height),
+            GFXBindKey::pack(pViewport->MinDepth, pViewport->MaxDepth)
+        );
+    }
+
     void doBind(GFXPipeline& pipeline, D3D11_VIEWPORT* pViewport) {
         GFX_THROW_FAILED_VOID(
             pipeline.context()->RSSetViewports(1u, pViewport)
@@ -2,6 +2,7 @@
 #define __PCone
 
 #include "GFX/Core/Factory.hpp"
+#include "GFX/Core/PayloadCache.hpp"
 #include "GFX/PipelineObjects/IA.hpp"
 #include "GFX/PipelineObjects/Buffer.hpp"
 
@@ -30,7 +31,14 @@ struct Cone {
         ConeVertexBuffer( GFXFactory factory,
             std::size_t nTesselation = defNTesselation
         ) : po::VertexBuffer<MyVertex>( factory,
-                Cone::modelPositions< std::vector<MyVertex> >(nTesselation)
+                GFXPAYLOADCACHE.fetch<MyVertex>(
+                    GFXContentKey::make<ConeVertexBuffer>(nTesselation),
+                    [=]() {
+                        return Cone::modelPositions< std::vector<MyVertex> >(
+                            nTesselation
+                        );
+                    }
+                )
             ) {}
             
         static constexpr std::size_t size(
@@ -46,7 +54,14 @@ struct Cone {
         ConeIndexBuffer( GFXFactory factory,
             std::size_t nTesselation = defNTesselation
         ) : po::IndexBuffer<MyIndex>( factory,
-                Cone::modelIndices< std::vector<MyIndex> >(nTesselation)
+                GFXPAYLOADCACHE.fetch<MyIndex>(
+                    GFXContentKey::make<ConeIndexBuffer>(nTesselation),
+                    [=]() {
+                        return Cone::modelIndices< std::vector<MyIndex> >(
+                            nTesselation
+                        );
+                    }
+                )
             ) {}
 
         static constexpr std::size_t size(
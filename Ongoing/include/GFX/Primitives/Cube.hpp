@@ -2,6 +2,7 @@
 #define __PCube
 
 #include "GFX/Core/Factory.hpp"
+#include "GFX/Core/PayloadCache.hpp"
 #include "GFX/PipelineObjects/IA.hpp"
 #include "GFX/PipelineObjects/Buffer.hpp"
 
@@ -25,7 +26,12 @@ struct Cube {
         CubeVertexBuffer() = default;
         CubeVertexBuffer(GFXFactory factory)
             : po::VertexBuffer<MyVertex>( factory,
-                Cube::modelPositions< std::vector<MyVertex> >()
+                GFXPAYLOADCACHE.fetch<MyVertex>(
+                    GFXContentKey::make<CubeVertexBuffer>(),
+                    [=]() {
+                        return Cube::modelPositions< std::vector<MyVertex> >();
+                    }
+                )
             ) {}
 
         static constexpr std::size_t size() {
@@ -38,7 +44,12 @@ struct Cube {
         CubeVertexBufferIndependent() = default;
         CubeVertexBufferIndependent(GFXFactory factory)
             : po::VertexBuffer<MyVertex>( factory,
-                Cube::modelPositionsIndependent< std::vector<MyVertex> >()
+                GFXPAYLOADCACHE.fetch<MyVertex>(
+                    GFXContentKey::make<CubeVertexBufferIndependent>(),
+                    [=]() {
+                        return Cube::modelPositionsIndependent< std::vector<MyVertex> >();
+                    }
+                )
             ) {}
 
         static constexpr std::size_t size() {
@@ -51,7 +62,12 @@ struct Cube {
         CubeNormalBufferIndependent() = default;
         CubeNormalBufferIndependent(GFXFactory factory)
             : po::VertexBuffer<MyNormal>( factory,
-                Cube::modelNormalsIndependent< std::vector<MyNormal> >()
+                GFXPAYLOADCACHE.fetch<MyNormal>(
+                    GFXContentKey::make<CubeNormalBufferIndependent>(),
+                    [=]() {
+                        return Cube::modelNormalsIndependent< std::vector<MyNormal> >();
+                    }
+                )
             ) {}
 
         static constexpr std::size_t size() {
@@ -64,7 +80,12 @@ struct Cube {
         CubeIndexBuffer() = default;
         CubeIndexBuffer(GFXFactory factory)
             : po::IndexBuffer<MyIndex>( factory,
-                Cube::modelIndices< std::vector<MyIndex> >()
+                GFXPAYLOADCACHE.fetch<MyIndex>(
+                    GFXContentKey::make<CubeIndexBuffer>(),
+                    [=]() {
+                        return Cube::modelIndices< std::vector<MyIndex> >();
+                    }
+                )
             ) {}
 
         static constexpr std::size_t size() {
@@ -2,6 +2,7 @@
 #define __PPlain
 
 #include "GFX/Core/Factory.hpp"
+#include "GFX/Core/PayloadCache.hpp"
 #include "GFX/PipelineObjects/IA.hpp"
 #include "GFX/PipelineObjects/Buffer.hpp"
 
@@ -25,8 +26,15 @@ struct Plane {
             std::size_t nTesselationX = defNTesselation,
             std::size_t nTesselationY = defNTesselation
         ) : po::VertexBuffer<MyVertex>( factory,
-                Plane::modelPositions< std::vector<MyVertex> >(
-                    nTesselationX, nTesselationY
+                GFXPAYLOADCACHE.fetch<MyVertex>(
+                    GFXContentKey::make<PlaneVertexBuffer>(
+                        nTesselationX, nTesselationY
+                    ),
+                    [=]() {
+                        return Plane::modelPositions< std::vector<MyVertex> >(
+                            nTesselationX, nTesselationY
+                        );
+                    }
                 )
             ) {}
             
@@ -45,8 +53,15 @@ struct Plane {
             std::size_t nTesselationX = defNTesselation,
             std::size_t nTesselationY = defNTesselation
         ) : po::IndexBuffer<MyIndex>( factory,
-                Plane::modelIndices< std::vector<MyIndex> >(
-                    nTesselationX, nTesselationY
+                GFXPAYLOADCACHE.fetch<MyIndex>(
+                    GFXContentKey::make<PlaneIndexBuffer>(
+                        nTesselationX, nTesselationY
+                    ),
+                    [=]() {
+                        return Plane::modelIndices< std::vector<MyIndex> >(
+                            nTesselationX, nTesselationY
+                        );
+                    }
                 )
             ) {}
 
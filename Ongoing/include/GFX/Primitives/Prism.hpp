@@ -2,6 +2,7 @@
 #define __PPrism
 
 #include "GFX/Core/Factory.hpp"
+#include "GFX/Core/PayloadCache.hpp"
 #include "GFX/PipelineObjects/IA.hpp"
 #include "GFX/PipelineObjects/Buffer.hpp"
 
@@ -27,7 +28,14 @@ struct Prism {
         PrismVertexBuffer( GFXFactory factory,
             std::size_t nTesselation = defNTesselation
         ) : po::VertexBuffer<MyVertex>( factory,
-                Prism::modelPositions< std::vector<MyVertex> >( nTesselation )
+                GFXPAYLOADCACHE.fetch<MyVertex>(
+                    GFXContentKey::make<PrismVertexBuffer>(nTesselation),
+                    [=]() {
+                        return Prism::modelPositions< std::vector<MyVertex> >(
+                            nTesselation
+                        );
+                    }
+                )
             ) {}
             
         static constexpr std::size_t size(
@@ -43,7 +51,14 @@ struct Prism {
         PrismIndexBuffer( GFXFactory factory,
             std::size_t nTesselation = defNTesselation
         ) : po::IndexBuffer<MyIndex>( factory,
-                Prism::modelIndices< std::vector<MyIndex> >(nTesselation)
+                GFXPAYLOADCACHE.fetch<MyIndex>(
+                    GFXContentKey::make<PrismIndexBuffer>(nTesselation),
+                    [=]() {
+                        return Prism::modelIndices< std::vector<MyIndex> >(
+                            nTesselation
+                        );
+                    }
+                )
             ) {}
 
         static constexpr std::size_t size(
@@ -2,6 +2,7 @@
 #define __PSphere
 
 #include "GFX/Core/Factory.hpp"
+#include "GFX/Core/PayloadCache.hpp"
 #include "GFX/PipelineObjects/IA.hpp"
 #include "GFX/PipelineObjects/Buffer.hpp"
 
@@ -11,6 +12,7 @@
 #include <ranges>
 #include <iterator>
 #include <algorithm>
+#include <span>
 
 namespace gfx {
 namespace Primitives {
@@ -28,10 +30,23 @@ struct Sphere {
             std::size_t nTesselationLat = defNTesselation,
             std::size_t nTesselationLong = defNTesselation
         ) : po::VertexBuffer<MyVertex>( factory,
-                Sphere::modelPositions< std::vector<MyVertex> >(
-                    nTesselationLat, nTesselationLong
+                GFXPAYLOADCACHE.fetch<MyVertex>(
+                    GFXContentKey::make<SphereVertexBuffer>(
+                        nTesselationLat, nTesselationLong
+                    ),
+                    [=]() {
+                        return Sphere::modelPositions< std::vector<MyVertex> >(
+                            nTesselationLat, nTesselationLong
+                        );
+                    }
                 )
             ) {}
+
+        // constructs from positions prepared in advance,
+        // e.g. by GFXStorage::loadAsync on a worker thread.
+        SphereVertexBuffer( GFXFactory factory,
+            std::span<const MyVertex> prepared
+        ) : po::VertexBuffer<MyVertex>(factory, prepared) {}
             
         static constexpr std::size_t size(
             std::size_t nTesselationLat = defNTesselation,
@@ -48,11 +63,22 @@ struct Sphere {
             std::size_t nTesselationLat = defNTesselation,
             std::size_t nTesselationLong = defNTesselation
         ) : po::IndexBuffer<MyIndex>( factory,
-                Sphere::modelIndices< std::vector<MyIndex> >(
-                    nTesselationLat, nTesselationLong
+                GFXPAYLOADCACHE.fetch<MyIndex>(
+                    GFXContentKey::make<SphereIndexBuffer>(
+                        nTesselationLat, nTesselationLong
+                    ),
+                    [=]() {
+                        return Sphere::modelIndices< std::vector<MyIndex> >(
+                            nTesselationLat, nTesselationLong
+                        );
+                    }
                 )
             ) {}
 
+        SphereIndexBuffer( GFXFactory factory,
+            std::span<const MyIndex> prepared
+        ) : po::IndexBuffer<MyIndex>(factory, prepared) {}
+
         static constexpr std::size_t size(
             std::size_t nTesselationLat = defNTesselation,
             std::size_t nTesselationLong = defNTesselation
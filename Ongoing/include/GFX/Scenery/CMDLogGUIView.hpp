@@ -2,6 +2,10 @@
 #define __GFXCMDLogGUIView
 
 #include "CMDSummarizer.hpp"
+#include "GFX/Core/Storage.hpp"
+#include "GFX/Core/Pipeline.hpp"
+
+#include <optional>
 
 #define GFXCMDLOG_GUIVIEW gfx::scenery::getGFXCMDLogGuiView()
 
@@ -18,9 +22,24 @@ public:
 
     void render();
 
+    // reports memory and traffic of the storage alongside the commands.
+    void watch(const GFXStorage& storage) noexcept {
+        pStorage_ = &storage;
+    }
+
+    // reports binds issued and elided on the pipeline's context.
+    void watch(GFXPipeline pipeline) noexcept {
+        pipeline_ = std::move(pipeline);
+    }
+
 private:
+    void renderStorage();
+    void renderPipeline();
+
     std::size_t nFrameSample_;
     std::size_t frameID_;
+    const GFXStorage* pStorage_;
+    std::optional<GFXPipeline> pipeline_;
     bool willShow_;
 };
 
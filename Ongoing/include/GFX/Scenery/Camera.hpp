@@ -35,10 +35,6 @@ public:
     CameraVision();
     CameraVision(const CameraVisionDesc& cvDesc);
 
-    auto& viewTrans() noexcept {
-        return viewTrans_;
-    }
-
     const auto& viewTrans() const noexcept {
         return viewTrans_;
     }
@@ -47,9 +43,16 @@ public:
         return projTrans_;
     }
 
+    // kept along with the view and the projection,
+    // so it's multiplied once per change rather than per object.
+    const auto& viewProjTrans() const noexcept {
+        return viewProjTrans_;
+    }
+
 private:
     void updateView(const CameraViewTransDesc& vtd);
     void updateProj(const CameraProjTransDesc& ptd);
+    void VCALL rotateView(dx::FXMMATRIX rotation);
 
     const CameraViewTransDesc& vtDesc() const noexcept {
         return viewTransDesc_;
@@ -69,6 +72,7 @@ private:
 
     Transform viewTrans_;
     Transform projTrans_;
+    Transform viewProjTrans_;
     CameraViewTransDesc viewTransDesc_;
     CameraProjTransDesc projTransDesc_;
 };
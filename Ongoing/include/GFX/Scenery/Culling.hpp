@@ -0,0 +1,128 @@
+#ifndef __Culling
+#define __Culling
+
+#include "GFX/Core/Namespaces.hpp"
+#include "GFX/Core/Transform.hpp"
+
+#include <vector>
+#include <array>
+#include <optional>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace gfx {
+namespace scenery {
+
+struct BoundingSphere {
+    dx::XMFLOAT3 center;
+    float radius;
+
+    // the largest axis scale is taken,
+    // so the result stays conservative under non-uniform scales.
+    BoundingSphere VCALL transformed(dx::FXMMATRIX trans) const noexcept;
+};
+
+struct BoundingBox {
+    dx::XMFLOAT3 lo;
+    dx::XMFLOAT3 hi;
+
+    static BoundingBox enclosing(const BoundingSphere& sphere) noexcept {
+        const auto& c = sphere.center;
+        const auto r = sphere.radius;
+        return BoundingBox{
+            .lo = dx::XMFLOAT3(c.x - r, c.y - r, c.z - r),
+            .hi = dx::XMFLOAT3(c.x + r, c.y + r, c.z + r)
+        };
+    }
+
+    BoundingBox merged(const BoundingBox& rhs) const noexcept {
+        return BoundingBox{
+            .lo = dx::XMFLOAT3( std::min(lo.x, rhs.lo.x),
+                std::min(lo.y, rhs.lo.y), std::min(lo.z, rhs.lo.z) ),
+            .hi = dx::XMFLOAT3( std::max(hi.x, rhs.hi.x),
+                std::max(hi.y, rhs.hi.y), std::max(hi.z, rhs.hi.z) )
+        };
+    }
+
+    BoundingBox expanded(float margin) const noexcept {
+        return BoundingBox{
+            .lo = dx::XMFLOAT3(lo.x - margin, lo.y - margin, lo.z - margin),
+            .hi = dx::XMFLOAT3(hi.x + margin, hi.y + margin, hi.z + margin)
+        };
+    }
+
+    bool contains(const BoundingBox& rhs) const noexcept {
+        return lo.x <= rhs.lo.x && lo.y <= rhs.lo.y && lo.z <= rhs.lo.z
+            && rhs.hi.x <= hi.x && rhs.hi.y <= hi.y && rhs.hi.z <= hi.z;
+    }
+
+    float surfaceArea() const noexcept {
+        const auto ex = hi.x - lo.x;
+        const auto ey = hi.y - lo.y;
+        const auto ez = hi.z - lo.z;
+        return 2.f * (ex * ey + ey * ez + ez * ex);
+    }
+
+    float center(std::size_t axis) const noexcept {
+        return 0.5f * ( (&lo.x)[axis] + (&hi.x)[axis] );
+    }
+};
+
+// direction needn't be normalized, distances are measured in its length.
+struct Ray {
+    dx::XMFLOAT3 origin;
+    dx::XMFLOAT3 direction;
+
+    // the ray through a point in normalized device coordinates,
+    // e.g. a mouse point, from the near plane towards the far plane.
+    static Ray unproject( const Transform& viewProj,
+        float ndcX, float ndcY
+    ) noexcept;
+
+    // distance to where the ray enters the box, if it does before tMax.
+    std::optional<float> intersect( const BoundingBox& box,
+        float tMax
+    ) const noexcept;
+
+    std::optional<float> intersect( const BoundingSphere& sphere,
+        float tMax
+    ) const noexcept;
+};
+
+// the six planes bounding what a camera sees, in world space.
+class Frustum {
+public:
+    enum class Containment {
+        Outside, Intersects, Inside
+    };
+
+    // from CameraVision's view * projection.
+    explicit Frustum(const Transform& viewProj) noexcept;
+
+    // conservative, a box near a corner may be told intersecting.
+    // tests four planes in one vector, as it runs per BVH node.
+    Containment classify(const BoundingBox& box) const noexcept;
+
+private:
+    static constexpr std::size_t nPlane = 6u;
+    static constexpr std::size_t batchSize = 4u;
+    static constexpr std::size_t nBatch = (nPlane + batchSize - 1u) / batchSize;
+
+    // plane components laid out per component, a plane per lane.
+    struct PlaneBatch {
+        dx::XMFLOAT4 xs;
+        dx::XMFLOAT4 ys;
+        dx::XMFLOAT4 zs;
+        dx::XMFLOAT4 ws;
+    };
+
+    // facing inward and normalized, so they give distances in world units.
+    // lanes past the last plane hold one every point lies in front of.
+    std::array<PlaneBatch, nBatch> planeBatches_;
+};
+
+}  // namespace gfx::scenery
+}  // namespace gfx
+
+#endif  // __Culling
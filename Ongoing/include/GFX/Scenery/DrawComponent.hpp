@@ -10,6 +10,8 @@
 
 #include <optional>
 #include <memory>
+#include <cstdint>
+#include <utility>
 
 namespace gfx {
 namespace po {
@@ -115,6 +117,16 @@ private:
 };
 #endif  // ACTIVATE_DRAWCOMPONENT_LOG
 
+class DynDrawCmpBase;
+
+// told when the sort key of a draw component changes,
+// e.g. by the layer keeping it in order.
+class SortKeyListener {
+public:
+    virtual ~SortKeyListener() {}
+    virtual void sortKeyChanged(DynDrawCmpBase& drawCmp) = 0;
+};
+
 class DynDrawCmpBase : public IDrawComponent {
 public:
     const RenderObjectDesc& renderObjectDesc() const final override {
@@ -124,6 +136,15 @@ public:
         return roDesc_.value();
     }
 
+    // non-virtual, read once per draw component when a layer is sorted.
+    std::uint64_t sortKey() const noexcept {
+        return sortKey_;
+    }
+
+    void setSortKeyListener(SortKeyListener* listener) noexcept {
+        pSortKeyListener_ = listener;
+    }
+
     po::BasicDrawCaller& drawCaller() final override {
         if (!drawCaller_.has_value()) {
             throw GFX_EXCEPT_CUSTOM(errMsgNoDrawCaller());
@@ -144,6 +165,13 @@ protected:
 #endif
 
     void setRODesc(const RenderObjectDesc& roDesc) {
+        // the key is packed once per change, not once per sort.
+        if ( !roDesc_.has_value() || roDesc_->header != roDesc.header ) {
+            const auto key = roDesc.sortKey();
+            if ( std::exchange(sortKey_, key) != key && pSortKeyListener_ ) {
+                pSortKeyListener_->sortKeyChanged(*this);
+            }
+        }
         roDesc_ = roDesc;
     }
 
@@ -172,6 +200,8 @@ private:
 
     std::optional< RenderObjectDesc > roDesc_;
     std::optional< std::unique_ptr<po::BasicDrawCaller> > drawCaller_;
+    std::uint64_t sortKey_ = 0u;
+    SortKeyListener* pSortKeyListener_ = nullptr;
 };
 
 /******** Deprecated ********/
@@ -0,0 +1,101 @@
+#ifndef __DrawRuns
+#define __DrawRuns
+
+#include "RenderObjectDesc.hpp"
+#include "RendererDesc.hpp"
+
+#include "GFX/Core/CommandBuffer.hpp"
+#include "GFX/Core/Storage.hpp"
+
+#include <vector>
+#include <span>
+#include <optional>
+#include <concepts>
+#include <cstddef>
+
+namespace gfx {
+namespace scenery {
+
+// what recordDrawRuns reads of a draw, as RCDrawCmp provides.
+template <class T>
+concept RunDrawable = requires (T& draw, InstanceTransforms& dst) {
+    { draw.renderObjectDesc() } -> std::convertible_to<const RenderObjectDesc&>;
+    { draw.drawCaller() } -> std::convertible_to<const po::BasicDrawCaller&>;
+    draw.writeInstance(dst);
+};
+
+namespace detail {
+
+inline void recordBinds( std::span<const GFXStorage::ID> IDs,
+    GFXCommandBuffer& cmds
+) {
+    for (const auto& id : IDs) {
+        cmds.bind(id);
+    }
+}
+
+}   // namespace gfx::scenery::detail
+
+// records draws in their order, runs of at least minInstanceRun draws
+// instancing with each other as one instanced draw, the rest one by one.
+// runs are adjacent as the sort key leads with type, material and buffer.
+// the renderer's plain and instanced binding sets are bound
+// only where the kind of draw changes.
+// instances is reused across calls, so recording won't allocate.
+template <RunDrawable Draw>
+void recordDrawRuns( const RendererDesc& desc, std::span<Draw* const> draws,
+    std::size_t minInstanceRun, std::vector<InstanceTransforms>& instances,
+    GFXCommandBuffer& cmds
+) {
+    const auto bInstancing = !desc.instancedIDs.empty();
+    // which of the renderer's binding sets is bound, none yet.
+    auto bInstancedBound = std::optional<bool>();
+
+    for (std::size_t first = 0u; first < draws.size(); ) {
+        const RenderObjectDesc& roDesc = draws[first]->renderObjectDesc();
+
+        auto last = first + 1u;
+        if (bInstancing) {
+            while ( last < draws.size()
+                && roDesc.instancesWith( draws[last]->renderObjectDesc() )
+            ) {
+                ++last;
+            }
+        }
+
+        if (bInstancing && last - first >= minInstanceRun) {
+            if ( bInstancedBound != true ) {
+                detail::recordBinds(desc.instancedIDs, cmds);
+                bInstancedBound = true;
+            }
+
+            instances.resize(last - first);
+            for (std::size_t i = first; i < last; ++i) {
+                draws[i]->writeInstance( instances[i - first] );
+            }
+
+            detail::recordBinds(roDesc.instancedIDs, cmds);
+            cmds.drawInstanced<InstanceTransforms>(
+                draws[first]->drawCaller(), instances
+            );
+        }
+        else {
+            if ( bInstancedBound != false ) {
+                detail::recordBinds(desc.IDs, cmds);
+                bInstancedBound = false;
+            }
+
+            for (std::size_t i = first; i < last; ++i) {
+                detail::recordBinds( draws[i]->renderObjectDesc().IDs, cmds );
+                cmds.draw( draws[i]->drawCaller() );
+            }
+        }
+
+        first = last;
+    }
+}
+
+}  // namespace gfx::scenery
+}  // namespace gfx
+
+#endif  // __DrawRuns
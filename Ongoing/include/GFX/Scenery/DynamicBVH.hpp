@@ -0,0 +1,547 @@
+#ifndef __DynamicBVH
+#define __DynamicBVH
+
+#include "Culling.hpp"
+
+#include <vector>
+#include <array>
+#include <span>
+#include <optional>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <cassert>
+
+namespace gfx {
+namespace scenery {
+
+// binary tree of boxes over values, for culling and picking
+// in time logarithmic to the number of values.
+// leaves hold fattened boxes, so small moves don't touch the tree.
+// moves beyond them refit the ancestors in place,
+// which degrades the tree over time, so it's rebuilt by SAH once due.
+// a tree never rebuilt is always due once refitted.
+// proxies stay valid across rebuilds.
+template <class T>
+    requires std::is_default_constructible_v<T> && std::copyable<T>
+class DynamicBVH {
+public:
+    using Proxy = std::uint32_t;
+    static constexpr Proxy nullProxy = std::numeric_limits<Proxy>::max();
+
+    struct RayHit {
+        Proxy proxy;
+        float distance;
+    };
+
+    explicit DynamicBVH(float margin = 0.1f)
+        : nodes_(), root_(nullProxy), freeList_(nullProxy),
+        nLeaf_(0u), nRefit_(0u), cost_(0.f), builtCost_(0.f), margin_(margin),
+        frustumStack_(), rayStack_() {}
+
+    Proxy insert(const BoundingBox& box, T value) {
+        const auto leaf = allocate();
+        nodes_[leaf] = Node{
+            .box = box.expanded(margin_),
+            .value = std::move(value)
+        };
+        ++nLeaf_;
+
+        insertLeaf(leaf);
+        return leaf;
+    }
+
+    void remove(Proxy proxy) {
+        assert( isLeaf(proxy) );
+        removeLeaf(proxy);
+        release(proxy);
+        --nLeaf_;
+    }
+
+    // returns whether the tree was touched.
+    bool move(Proxy proxy, const BoundingBox& box) {
+        assert( isLeaf(proxy) );
+        if ( nodes_[proxy].box.contains(box) ) [[likely]] {
+            return false;
+        }
+
+        nodes_[proxy].box = box.expanded(margin_);
+        refitAncestors( nodes_[proxy].parent );
+        ++nRefit_;
+        return true;
+    }
+
+    const T& value(Proxy proxy) const noexcept {
+        return nodes_[proxy].value;
+    }
+
+    const BoundingBox& fatBox(Proxy proxy) const noexcept {
+        return nodes_[proxy].box;
+    }
+
+    std::size_t size() const noexcept {
+        return nLeaf_;
+    }
+
+    // proxies are below this, for indexing side tables by them.
+    std::size_t capacity() const noexcept {
+        return nodes_.size();
+    }
+
+    // once refits made queries expected to cost half again as much
+    // as right after the last build.
+    bool rebuildDue() const noexcept {
+        return nRefit_ > 0u && cost_ > builtCost_ * rebuildRatio;
+    }
+
+    void rebuild() {
+        nRefit_ = 0u;
+        // recounted from scratch, dropping the drift of incremental updates.
+        cost_ = 0.f;
+        if (root_ == nullProxy) {
+            builtCost_ = 0.f;
+            return;
+        }
+
+        auto entries = std::vector<BuildEntry>();
+        entries.reserve(nLeaf_);
+        for (Proxy idx = 0u; idx < nodes_.size(); ++idx) {
+            if ( !nodes_[idx].bAllocated ) {
+                continue;
+            }
+
+            if ( isLeaf(idx) ) {
+                const auto& box = nodes_[idx].box;
+                entries.push_back( BuildEntry{
+                    .box = box,
+                    .centroid = { box.center(0u), box.center(1u), box.center(2u) },
+                    .proxy = idx
+                } );
+            }
+            else {
+                release(idx);
+            }
+        }
+
+        root_ = build(entries);
+        nodes_[root_].parent = nullProxy;
+        builtCost_ = cost_;
+    }
+
+    // fn(proxy, value) for every value whose box the frustum may see.
+    template <class Fn>
+        requires std::invocable<Fn&, Proxy, const T&>
+    void queryFrustum(const Frustum& frustum, Fn fn) const {
+        if (root_ == nullProxy) {
+            return;
+        }
+
+        auto& stack = frustumStack_;
+        stack.clear();
+        stack.emplace_back(root_, false);
+
+        while ( !stack.empty() ) {
+            const auto [idx, bInside] = stack.back();
+            stack.pop_back();
+            const auto& node = nodes_[idx];
+
+            // a node inside the frustum has its whole subtree inside.
+            auto bSubtreeInside = bInside;
+            if (!bInside) {
+                const auto containment = frustum.classify(node.box);
+                if (containment == Frustum::Containment::Outside) {
+                    continue;
+                }
+                bSubtreeInside = containment == Frustum::Containment::Inside;
+            }
+
+            if ( isLeaf(idx) ) {
+                std::invoke(fn, idx, node.value);
+            }
+            else {
+                stack.emplace_back(node.left, bSubtreeInside);
+                stack.emplace_back(node.right, bSubtreeInside);
+            }
+        }
+    }
+
+    // the nearest hit, where hit(value, tMax) refines a box hit
+    // into the distance to the value itself, if nearer than tMax.
+    template <class HitFn>
+        requires std::is_invocable_r_v< std::optional<float>, HitFn&,
+            const T&, float >
+    std::optional<RayHit> raycast( const Ray& ray, HitFn hit,
+        float tMax = std::numeric_limits<float>::infinity()
+    ) const {
+        if (root_ == nullProxy) {
+            return std::nullopt;
+        }
+
+        auto ret = std::optional<RayHit>();
+        auto& stack = rayStack_;
+        stack.clear();
+        if ( auto t = ray.intersect( nodes_[root_].box, tMax ) ) {
+            stack.emplace_back( root_, t.value() );
+        }
+
+        while ( !stack.empty() ) {
+            const auto [idx, tEnter] = stack.back();
+            stack.pop_back();
+
+            // a nearer hit was found since the node was pushed.
+            if (tEnter > tMax) {
+                continue;
+            }
+
+            const auto& node = nodes_[idx];
+            if ( isLeaf(idx) ) {
+                if ( auto t = std::invoke(hit, node.value, tMax);
+                    t.has_value() && t.value() <= tMax
+                ) {
+                    tMax = t.value();
+                    ret = RayHit{ .proxy = idx, .distance = tMax };
+                }
+                continue;
+            }
+
+            auto tLeft = ray.intersect( nodes_[node.left].box, tMax );
+            auto tRight = ray.intersect( nodes_[node.right].box, tMax );
+            auto first = std::make_pair(node.left, tLeft);
+            auto second = std::make_pair(node.right, tRight);
+
+            // the nearer child is pushed last, to be visited first.
+            if ( tLeft.has_value() && tRight.has_value()
+                && tLeft.value() < tRight.value()
+            ) {
+                std::swap(first, second);
+            }
+
+            for (const auto& [child, t] : { first, second }) {
+                if ( t.has_value() ) {
+                    stack.emplace_back( child, t.value() );
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    // walks the whole tree, for tests and debugging.
+    // parents link back, boxes enclose their children's,
+    // every leaf is reached once and the kept cost hasn't drifted far.
+    bool valid() const {
+        if (root_ == nullProxy) {
+            return nLeaf_ == 0u;
+        }
+        if (nodes_[root_].parent != nullProxy) {
+            return false;
+        }
+
+        auto nReached = std::size_t(0u);
+        auto area = 0.;
+        auto stack = std::vector<Proxy>{ root_ };
+        while ( !stack.empty() ) {
+            const auto idx = stack.back();
+            stack.pop_back();
+            const auto& node = nodes_[idx];
+            if (!node.bAllocated) {
+                return false;
+            }
+
+            if ( isLeaf(idx) ) {
+                ++nReached;
+                continue;
+            }
+
+            for (const auto child : { node.left, node.right }) {
+                if ( child >= nodes_.size() || nodes_[child].parent != idx
+                    || !node.box.contains( nodes_[child].box )
+                ) {
+                    return false;
+                }
+                stack.push_back(child);
+            }
+            area += node.box.surfaceArea();
+        }
+
+        return nReached == nLeaf_
+            && std::abs(area - cost_) <= 1e-2 * area + 1e-3;
+    }
+
+private:
+    static constexpr std::size_t nBin = 16u;
+    static constexpr float rebuildRatio = 1.5f;
+
+    struct Node {
+        BoundingBox box = {};
+        T value = {};
+        Proxy parent = nullProxy;
+        Proxy left = nullProxy;
+        Proxy right = nullProxy;
+        bool bAllocated = true;
+    };
+
+    bool isLeaf(Proxy idx) const noexcept {
+        return nodes_[idx].left == nullProxy;
+    }
+
+    Proxy allocate() {
+        if (freeList_ == nullProxy) {
+            nodes_.emplace_back();
+            return static_cast<Proxy>( nodes_.size() - 1u );
+        }
+
+        // free nodes are chained through their parent.
+        const auto idx = freeList_;
+        freeList_ = nodes_[idx].parent;
+        nodes_[idx] = Node{};
+        return idx;
+    }
+
+    void release(Proxy idx) noexcept {
+        nodes_[idx] = Node{
+            .parent = freeList_,
+            .bAllocated = false
+        };
+        freeList_ = idx;
+    }
+
+    // descends to the sibling adding the least surface area.
+    void insertLeaf(Proxy leaf) {
+        if (root_ == nullProxy) {
+            root_ = leaf;
+            nodes_[leaf].parent = nullProxy;
+            return;
+        }
+
+        const auto box = nodes_[leaf].box;
+        auto sibling = root_;
+
+        while ( !isLeaf(sibling) ) {
+            const auto& node = nodes_[sibling];
+            const auto area = node.box.surfaceArea();
+            const auto combinedArea = node.box.merged(box).surfaceArea();
+
+            // pairing here, or pushing the leaf down a child.
+            const auto cost = 2.f * combinedArea;
+            const auto inheritedCost = 2.f * (combinedArea - area);
+
+            const auto descendCost = [&](Proxy child) {
+                const auto& childBox = nodes_[child].box;
+                const auto enlarged = childBox.merged(box).surfaceArea();
+                return isLeaf(child) ? enlarged + inheritedCost
+                    : enlarged - childBox.surfaceArea() + inheritedCost;
+            };
+            const auto costLeft = descendCost(node.left);
+            const auto costRight = descendCost(node.right);
+
+            if (cost < costLeft && cost < costRight) {
+                break;
+            }
+            sibling = costLeft < costRight ? node.left : node.right;
+        }
+
+        const auto oldParent = nodes_[sibling].parent;
+        const auto newParent = allocate();
+        nodes_[newParent] = Node{
+            .box = nodes_[sibling].box.merged(box),
+            .parent = oldParent,
+            .left = sibling,
+            .right = leaf
+        };
+        cost_ += nodes_[newParent].box.surfaceArea();
+        nodes_[sibling].parent = newParent;
+        nodes_[leaf].parent = newParent;
+
+        if (oldParent == nullProxy) {
+            root_ = newParent;
+        }
+        else {
+            replaceChild(oldParent, sibling, newParent);
+            refitAncestors(oldParent);
+        }
+    }
+
+    // the leaf's sibling takes the place of their parent.
+    void removeLeaf(Proxy leaf) {
+        if (leaf == root_) {
+            root_ = nullProxy;
+            return;
+        }
+
+        const auto parent = nodes_[leaf].parent;
+        const auto grandParent = nodes_[parent].parent;
+        const auto sibling = nodes_[parent].left == leaf
+            ? nodes_[parent].right : nodes_[parent].left;
+
+        nodes_[sibling].parent = grandParent;
+        if (grandParent == nullProxy) {
+            root_ = sibling;
+        }
+        else {
+            replaceChild(grandParent, parent, sibling);
+            refitAncestors(grandParent);
+        }
+
+        cost_ -= nodes_[parent].box.surfaceArea();
+        release(parent);
+    }
+
+    void replaceChild(Proxy parent, Proxy oldChild, Proxy newChild) noexcept {
+        auto& node = nodes_[parent];
+        (node.left == oldChild ? node.left : node.right) = newChild;
+    }
+
+    void refitAncestors(Proxy idx) noexcept {
+        for (; idx != nullProxy; idx = nodes_[idx].parent) {
+            auto& node = nodes_[idx];
+            const auto oldArea = node.box.surfaceArea();
+            node.box = nodes_[node.left].box.merged( nodes_[node.right].box );
+            cost_ += node.box.surfaceArea() - oldArea;
+        }
+    }
+
+    // leaves are copied out with their centroids,
+    // so partitioning them doesn't chase proxies into nodes_.
+    struct BuildEntry {
+        BoundingBox box = {};
+        std::array<float, 3u> centroid;
+        Proxy proxy;
+    };
+
+    static BoundingBox emptyBox() noexcept {
+        constexpr auto max = std::numeric_limits<float>::max();
+        constexpr auto lowest = std::numeric_limits<float>::lowest();
+        return BoundingBox{
+            .lo = dx::XMFLOAT3(max, max, max),
+            .hi = dx::XMFLOAT3(lowest, lowest, lowest)
+        };
+    }
+
+    // top-down, splitting where binned SAH finds it cheapest.
+    Proxy build(std::span<BuildEntry> entries) {
+        if (entries.size() == 1u) {
+            return entries.front().proxy;
+        }
+
+        auto centroidLo = std::array<float, 3u>{};
+        auto centroidHi = std::array<float, 3u>{};
+        centroidLo.fill( std::numeric_limits<float>::max() );
+        centroidHi.fill( std::numeric_limits<float>::lowest() );
+        for (const auto& entry : entries) {
+            for (std::size_t axis = 0u; axis < 3u; ++axis) {
+                centroidLo[axis] = std::min(centroidLo[axis], entry.centroid[axis]);
+                centroidHi[axis] = std::max(centroidHi[axis], entry.centroid[axis]);
+            }
+        }
+
+        auto axis = std::size_t(0u);
+        for (std::size_t i = 1u; i < 3u; ++i) {
+            if ( centroidHi[i] - centroidLo[i]
+                > centroidHi[axis] - centroidLo[axis]
+            ) {
+                axis = i;
+            }
+        }
+
+        const auto extent = centroidHi[axis] - centroidLo[axis];
+        // coincident centroids can't be told apart, so just halved.
+        auto mid = entries.size() / 2u;
+
+        if (extent > 0.f) {
+            const auto scale = nBin / extent;
+            const auto binOf = [&](const BuildEntry& entry) {
+                const auto bin = static_cast<std::size_t>(
+                    (entry.centroid[axis] - centroidLo[axis]) * scale
+                );
+                return std::min(bin, nBin - 1u);
+            };
+
+            auto binBoxes = std::array<BoundingBox, nBin>{};
+            binBoxes.fill( emptyBox() );
+            auto binCounts = std::array<std::size_t, nBin>{};
+            for (const auto& entry : entries) {
+                const auto bin = binOf(entry);
+                binBoxes[bin] = binBoxes[bin].merged(entry.box);
+                ++binCounts[bin];
+            }
+
+            // area * count of what lies right of each split, swept from right.
+            auto rightCosts = std::array<float, nBin>{};
+            auto acc = emptyBox();
+            auto accCount = std::size_t(0u);
+            for (std::size_t bin = nBin - 1u; bin > 0u; --bin) {
+                acc = acc.merged( binBoxes[bin] );
+                accCount += binCounts[bin];
+                rightCosts[bin] = accCount ? acc.surfaceArea() * accCount : 0.f;
+            }
+
+            auto bestCost = std::numeric_limits<float>::max();
+            auto bestSplit = nBin;
+            acc = emptyBox();
+            accCount = 0u;
+            for (std::size_t split = 1u; split < nBin; ++split) {
+                acc = acc.merged( binBoxes[split - 1u] );
+                accCount += binCounts[split - 1u];
+
+                if (accCount == 0u || accCount == entries.size()) {
+                    continue;
+                }
+
+                const auto cost = acc.surfaceArea() * accCount + rightCosts[split];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = split;
+                }
+            }
+
+            if (bestSplit != nBin) {
+                const auto itMid = std::partition( entries.begin(), entries.end(),
+                    [&](const BuildEntry& entry) { return binOf(entry) < bestSplit; }
+                );
+                mid = static_cast<std::size_t>( itMid - entries.begin() );
+            }
+        }
+
+        const auto left = build( entries.first(mid) );
+        const auto right = build( entries.subspan(mid) );
+
+        const auto node = allocate();
+        nodes_[node] = Node{
+            .box = nodes_[left].box.merged( nodes_[right].box ),
+            .left = left,
+            .right = right
+        };
+        cost_ += nodes_[node].box.surfaceArea();
+        nodes_[left].parent = node;
+        nodes_[right].parent = node;
+
+        return node;
+    }
+
+    std::vector<Node> nodes_;
+    Proxy root_;
+    Proxy freeList_;
+    std::size_t nLeaf_;
+    std::size_t nRefit_;
+    // surface area summed over internal nodes, proportional to
+    // the expected cost of a query by SAH. kept as their boxes change.
+    float cost_;
+    float builtCost_;
+    float margin_;
+    // traversal stacks kept across queries, so they stop allocating
+    // once grown to the tree's depth. a tree isn't queried concurrently.
+    mutable std::vector< std::pair<Proxy, bool> > frustumStack_;
+    mutable std::vector< std::pair<Proxy, float> > rayStack_;
+};
+
+}  // namespace gfx::scenery
+}  // namespace gfx
+
+#endif  // __DynamicBVH
@@ -0,0 +1,105 @@
+#ifndef __LOD
+#define __LOD
+
+#include "Culling.hpp"
+
+#include "GFX/Core/Namespaces.hpp"
+#include "GFX/Core/Transform.hpp"
+
+#include <vector>
+#include <array>
+#include <span>
+#include <limits>
+#include <algorithm>
+#include <cstddef>
+
+namespace gfx {
+namespace scenery {
+
+// picks a level of detail from the size of bounds on the screen,
+// level 0 being the finest.
+// a level is left only once the size passes its threshold by a margin,
+// so that an object lingering around a threshold doesn't pop.
+class LODSelector {
+public:
+    LODSelector()
+        : minRadii_(), hysteresis_(0.f), level_(0u) {}
+
+    // minRadii[i] is the least projected radius level i is drawn at,
+    // descending. the last level has none, so there is one level more.
+    explicit LODSelector( std::span<const float> minRadii,
+        float hysteresis = 0.1f
+    ) : minRadii_( minRadii.begin(), minRadii.end() ),
+        hysteresis_(hysteresis), level_(0u) {}
+
+    std::size_t select(float projRadius) noexcept {
+        while ( level_ > 0u
+            && projRadius >= minRadii_[level_ - 1u] * (1.f + hysteresis_)
+        ) {
+            --level_;
+        }
+
+        while ( level_ < minRadii_.size()
+            && projRadius < minRadii_[level_] * (1.f - hysteresis_)
+        ) {
+            ++level_;
+        }
+
+        return level_;
+    }
+
+    std::size_t level() const noexcept {
+        return level_;
+    }
+
+    std::size_t nLevel() const noexcept {
+        return minRadii_.size() + 1u;
+    }
+
+    // radius of the sphere on the screen, in normalized device coordinates,
+    // so 1 spans half the screen height.
+    static float projectedRadius( const BoundingSphere& sphere,
+        const Transform& view, const Transform& proj
+    ) noexcept {
+        const auto depth = dx::XMVectorGetZ( dx::XMVector3TransformCoord(
+            dx::XMLoadFloat3(&sphere.center), view.get()
+        ) );
+
+        // the camera is within the sphere.
+        if (depth <= sphere.radius) {
+            return std::numeric_limits<float>::infinity();
+        }
+
+        // the projection's y scale, cot(fovY / 2).
+        return sphere.radius * dx::XMVectorGetY( proj.get().r[1] ) / depth;
+    }
+
+private:
+    std::vector<float> minRadii_;
+    float hysteresis_;
+    std::size_t level_;
+};
+
+// how many draws took each level of detail in a frame.
+struct LODStats {
+    static constexpr std::size_t maxLevel = 8u;
+
+    // levels beyond maxLevel are counted as the last.
+    void count(std::size_t level) noexcept {
+        ++nDraws[ std::min(level, maxLevel - 1u) ];
+    }
+
+    LODStats& operator+=(const LODStats& rhs) noexcept {
+        for (std::size_t i = 0u; i < maxLevel; ++i) {
+            nDraws[i] += rhs.nDraws[i];
+        }
+        return *this;
+    }
+
+    std::array<std::size_t, maxLevel> nDraws;
+};
+
+}  // namespace gfx::scenery
+}  // namespace gfx
+
+#endif  // __LOD
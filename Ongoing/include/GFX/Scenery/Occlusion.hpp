@@ -0,0 +1,86 @@
+#ifndef __Occlusion
+#define __Occlusion
+
+#include "Culling.hpp"
+
+#include "GFX/Core/Namespaces.hpp"
+#include "GFX/Core/Transform.hpp"
+
+#include <vector>
+#include <cstddef>
+
+namespace gfx {
+namespace scenery {
+
+// a small depth buffer the CPU rasterizes a few occluders into,
+// to tell which bounds are hidden behind them before drawing.
+// depths are those of normalized device coordinates, nearer is smaller.
+class OcclusionBuffer {
+public:
+    static constexpr std::size_t tileWidth = 8u;
+    static constexpr std::size_t tileHeight = 8u;
+
+    // rounded up to whole tiles.
+    explicit OcclusionBuffer( std::size_t width = 256u,
+        std::size_t height = 128u
+    );
+
+    // starts over with nothing occluding, seen through viewProj.
+    void clear(const Transform& viewProj);
+
+    // the cube [-1, 1]^3 placed by world.
+    // it must lie within what it stands for, or it hides what is seen.
+    // skipped if it crosses the near plane, which only occludes less.
+    void rasterizeBox(const Transform& world);
+
+    // false only if the box is behind occluders wherever it covers.
+    bool visible(const BoundingBox& box) const;
+
+    std::size_t width() const noexcept {
+        return width_;
+    }
+
+    std::size_t height() const noexcept {
+        return height_;
+    }
+
+private:
+    struct ScreenVertex {
+        float x;
+        float y;
+        float z;
+    };
+
+    // in pixels, left-top origin, max exclusive.
+    struct ScreenRect {
+        std::size_t x0;
+        std::size_t y0;
+        std::size_t x1;
+        std::size_t y1;
+    };
+
+    // corners projected to the screen, false if any is before the near plane.
+    bool project( dx::FXMMATRIX trans, const BoundingBox& box,
+        ScreenVertex (&corners)[8]
+    ) const noexcept;
+    ScreenRect rectOf(const ScreenVertex (&corners)[8]) const noexcept;
+
+    void rasterizeTriangle( ScreenVertex v0, ScreenVertex v1,
+        ScreenVertex v2
+    ) noexcept;
+    void refreshTiles(const ScreenRect& rect) noexcept;
+
+    std::size_t width_;
+    std::size_t height_;
+    std::size_t nTileX_;
+    Transform viewProj_;
+    // row major, one depth per pixel.
+    std::vector<float> depths_;
+    // the farthest depth in each tile, to pass over hidden tiles at once.
+    std::vector<float> tileMaxDepths_;
+};
+
+}  // namespace gfx::scenery
+}  // namespace gfx
+
+#endif  // __Occlusion
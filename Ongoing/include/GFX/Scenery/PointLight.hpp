@@ -37,7 +37,8 @@ namespace Basic {
 
 class BPDynPointLight : public po::IPipelineObject{
 private:
-    using MyPSCBuffer = po::PSCBuffer<BPPointLightDesc>;
+    // uploaded only once the light changed.
+    using MyPSCBuffer = po::ShadowedCBuffer< po::PSCBuffer<BPPointLightDesc> >;
 
 public:
     friend class Utilized::BPDynPointLight;
@@ -77,27 +78,22 @@ public:
 
     void VCALL setPos(dx::FXMVECTOR posVal) {
         dx::XMStoreFloat3A(&lightDesc_.pos, posVal);
-        dirty_ = true;
     }
 
     void VCALL setColor(dx::FXMVECTOR colorVal) {
         dx::XMStoreFloat3(&lightDesc_.color, colorVal);
-        dirty_ = true;
     }
 
     void setAttConst(float attConstVal) {
         lightDesc_.attConst = attConstVal;
-        dirty_ = true;
     }
 
     void setAttLin(float attLinVal) {
         lightDesc_.attLin = attLinVal;
-        dirty_ = true;
     }
 
     void setAttQuad(float attQuadVal) {
         lightDesc_.attQuad = attQuadVal;
-        dirty_ = true;
     }
 
     UINT slot() const {
@@ -115,7 +111,6 @@ private:
 
     BPPointLightDesc lightDesc_;
     MyPSCBuffer cbuf_;
-    bool dirty_;
 };
 
 } // namespace Basic
@@ -228,14 +223,14 @@ using namespace gfx::scenery::Utilized;
 #include "Renderer.hpp"
 #include "RCDrawComponent.hpp"
 #include "TransformDrawContexts.hpp"
+#include "LOD.hpp"
 
 #include "GFX/PipelineObjects/Buffer.hpp"
-#include "GFX/PipelineObjects/Viewport.hpp"
-#include "GFX/PipelineObjects/Topology.hpp"
 #include "GFX/PipelineObjects/DrawCaller.hpp"
 #include "GFX/Primitives/Sphere.hpp"
 
 #include <tuple>
+#include <array>
 
 namespace gfx {
 namespace scenery {
@@ -292,13 +287,15 @@ class LightViz : public IEntity {
 public:
     friend class Loader<LightViz>;
 
-    LightViz( GFXFactory factory, GFXStorage& storage,
-        const Win32::Client& client
-    );
+    LightViz(GFXFactory factory, GFXStorage& storage);
     LightViz( const Luminance& base, GFXFactory factory,
-        GFXStorage& storage, const Win32::Client& client
+        GFXStorage& storage
     );
 
+    // starts preparing shared resources of LightViz asynchronously.
+    // call GFXStorage::waitAsync before constructing to make use of them.
+    static void prefetch(GFXFactory factory, GFXStorage& storage);
+
     void setBase(const Luminance& base) {
         base_ = &base;
     }
@@ -321,24 +318,30 @@ private:
         struct {} tagColorCBuf;
         struct {} tagDynColorCBuf;
         struct {} tagTransformCBuf;
-        struct {} tagViewport;
-        struct {} tagTopology;
 
         class MyVertexBuffer;
         class MyIndexBuffer;
         class MyColorCBuf;
         class MyDynColorCBuf;
         class MyTransformCBuf;
-        class MyViewport;
-        class MyTopology;
         using MyDrawCaller = po::DrawCallerIndexed;
 
-        DrawComponentLViz( GFXFactory factory, GFXStorage& storage,
-            const Win32::Client& client
-        );
+        // sphere tesselations from the finest,
+        // and the least projected radius each is drawn at but the last.
+        static constexpr std::size_t nLOD = 4u;
+        static constexpr std::array<std::size_t, nLOD> lodTesselations = {
+            256u, 64u, 24u, 10u
+        };
+        static constexpr std::array<float, nLOD - 1u> lodMinRadii = {
+            0.5f, 0.15f, 0.04f
+        };
+
+        DrawComponentLViz(GFXFactory factory, GFXStorage& storage);
         DrawComponentLViz(DrawComponentLViz&& other) noexcept;
         DrawComponentLViz& operator=(DrawComponentLViz&& other) noexcept;
 
+        static void prefetch(GFXFactory factory, GFXStorage& storage);
+
         void VCALL updateTrans(const Transform transform);
         void VCALL updateColor(dx::FXMVECTOR color);
 
@@ -346,34 +349,40 @@ private:
         void sync(const SolidRenderer& renderer);
         void sync(const CameraVision& vision) override;
 
+        std::optional<BoundingSphere> bounds() const override;
+
+        std::optional<std::size_t> lodLevel() const override {
+            return lod_.level();
+        }
+
         auto reflect() noexcept {
-            return std::tie( transformGPUMapper_, transformApplyer_,
-                logComponent_, vBuf_, iBuf_, colorCBuf_, transCBuf_,
-                viewport_, topology_
+            return std::tie( transformGPUMapper_, logComponent_,
+                vBufs_, iBufs_, colorCBuf_, transCBuf_, lod_
             );
         }
 
         auto reflect() const noexcept {
-            return std::tie( transformGPUMapper_, transformApplyer_,
-                logComponent_, vBuf_, iBuf_, colorCBuf_, transCBuf_,
-                viewport_, topology_
+            return std::tie( transformGPUMapper_, logComponent_,
+                vBufs_, iBufs_, colorCBuf_, transCBuf_, lod_
             );
         }
 
         void swap(DrawComponentLViz& rhs);
 
     private:
+        // points the draw at the buffers of the chosen level.
+        void bindLOD();
+
         MapTransformGPU transformGPUMapper_;
-        ApplyTransform transformApplyer_;
     #ifdef ACTIVATE_DRAWCOMPONENT_LOG
         RCDrawCmp::LogComponent logComponent_;
     #endif
-        GFXRes vBuf_;
-        GFXRes iBuf_;
+        // shared through storage, per level of detail.
+        std::array<GFXRes, nLOD> vBufs_;
+        std::array<GFXRes, nLOD> iBufs_;
         GFXRes colorCBuf_;
         GFXRes transCBuf_;
-        GFXRes viewport_;
-        GFXRes topology_;
+        LODSelector lod_;
     };  // class DrawComponentLViz
 
     DrawComponentLViz& dc() noexcept {
@@ -428,16 +437,14 @@ public:
         }
     }
 
-    void ctViz( GFXFactory factory, GFXStorage& storage,
-        const Win32::Client& client
-    ) {
+    void ctViz(GFXFactory factory, GFXStorage& storage) {
         if (luminance_.has_value()) {
             viz_ = LightViz( luminance_.value(),
-                std::move(factory), storage, client
+                std::move(factory), storage
             );
         }
         else {
-            viz_ = LightViz(std::move(factory), storage, client);
+            viz_ = LightViz(std::move(factory), storage);
         }
     }
 
@@ -2,6 +2,11 @@
 #define __RCDrawComponent
 
 #include "DrawComponent.hpp"
+#include "Culling.hpp"
+#include "GFX/Core/Transform.hpp"
+
+#include <optional>
+#include <cstddef>
 
 namespace gfx {
 namespace scenery {
@@ -14,6 +19,27 @@ public:
     virtual void sync(const Renderer&) = 0;
     virtual void sync(const CameraVision&) = 0;
 
+    // called for components with RenderObjectDesc::instancedIDs,
+    // in place of the draw contexts mapping their transforms.
+    virtual void writeInstance(InstanceTransforms& dst) const {}
+
+    // world space bounds, checked against the camera before drawing.
+    // components without are never culled.
+    virtual std::optional<BoundingSphere> bounds() const {
+        return std::nullopt;
+    }
+
+    // world transform of the cube [-1, 1]^3, lying within the component,
+    // behind which others are hidden. components without hide nothing.
+    virtual std::optional<Transform> occluder() const {
+        return std::nullopt;
+    }
+
+    // the level of detail chosen on the last sync, for statistics.
+    virtual std::optional<std::size_t> lodLevel() const {
+        return std::nullopt;
+    }
+
 protected:
 #ifdef ACTIVATE_DRAWCOMPONENT_LOG
     using LogComponent = DynDrawCmpBase::LogComponent;
@@ -2,20 +2,84 @@
 #define __RenderObjectDesc
 
 #include "GFX/Core/Storage.hpp"
+#include "FixedVector.hpp"
+
+#include <DirectXMath.h>
+#include "GFX/Core/Namespaces.hpp"
 
 #include <typeindex>
 #include <tuple>
-#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
 
 namespace gfx {
 namespace scenery {
 
+namespace detail {
+
+inline std::uint32_t makeDenseTypeIndex() noexcept {
+    static auto next = std::atomic<std::uint32_t>(0u);
+    return next.fetch_add(1u, std::memory_order_relaxed);
+}
+
+}   // namespace gfx::scenery::detail
+
+// small dense number of a type, assigned on first use,
+// so that types fit in a few bits of a sort key.
+template <class T>
+std::uint32_t denseTypeIndex() noexcept {
+    static const auto idx = detail::makeDenseTypeIndex();
+    return idx;
+}
+
+// IDs bound for a draw, stored inline,
+// so descs are copied every frame without allocation.
+using GFXIDList = FixedVector<GFXStorage::ID, 16u>;
+
+// per-instance data of objects drawn by one instanced draw call,
+// row-major as read by instanced vertex shaders.
+// camera transforms are per frame, left to the renderer.
+struct InstanceTransforms {
+    dx::XMFLOAT4X4 world;
+};
+
 struct RenderObjectDesc {
     struct Header {
         GFXStorage::ID IDBuffer;
         std::type_index IDType;
+        // denseTypeIndex of IDType, read by sortKey.
+        std::uint32_t denseType;
+        GFXStorage::ID IDMaterial = {};
+
+        friend bool operator==(const Header& lhs,
+            const Header& rhs) noexcept = default;
     };
 
+    // packed draw order, most significant field first.
+    // | type 8 | material 20 | buffer 20 | unused 16 |
+    // the renderer and its shaders are fixed within a sort,
+    // as each renderer sorts its own scene.
+    // fields are truncated to their widths,
+    // which may only cost state changes, never correctness.
+    // depth changes whenever the camera moves, so it's left out,
+    // and the renderer orders equal keys by depth per frame.
+    std::uint64_t sortKey() const noexcept {
+        return bits( header.denseType, 8u ) << 56u
+            | bits( header.IDMaterial.index, 20u ) << 36u
+            | bits( header.IDBuffer.index, 20u ) << 16u;
+    }
+
+    // whether both can be drawn by one instanced draw call.
+    // depth is left out, as instances don't need to be in order.
+    bool instancesWith(const RenderObjectDesc& rhs) const noexcept {
+        return !instancedIDs.empty()
+            && header.IDType == rhs.header.IDType
+            && header.IDBuffer == rhs.header.IDBuffer
+            && header.IDMaterial == rhs.header.IDMaterial
+            && instancedIDs == rhs.instancedIDs;
+    }
+
     auto reflect() const noexcept {
         return std::tie(
             header.IDBuffer,
@@ -28,7 +92,17 @@ struct RenderObjectDesc {
     }
 
     Header header;
-    std::vector<GFXStorage::ID> IDs;
+    GFXIDList IDs;
+    // bound instead of IDs when drawn as an instance,
+    // per-instance state left out. empty if it can't be instanced.
+    GFXIDList instancedIDs = {};
+
+private:
+    static constexpr std::uint64_t bits(std::uint64_t val,
+        unsigned width
+    ) noexcept {
+        return val & ( (std::uint64_t(1u) << width) - 1u );
+    }
 };
 
 }   // namespace gfx::scenery
@@ -5,9 +5,15 @@
 
 #include "Scene.hpp"
 #include "RendererDesc.hpp"
+#include "Culling.hpp"
+#include "Occlusion.hpp"
+#include "LOD.hpp"
+#include "DrawRuns.hpp"
 
 #include "GFX/Core/Pipeline.hpp"
+#include "GFX/Core/CommandBuffer.hpp"
 #include "GFX/PipelineObjects/Shader.hpp"
+#include "GFX/PipelineObjects/PipelineStateObject.hpp"
 #include "GFX/Core/Storage.hpp"
 
 #include "GFX/PipelineObjects/Buffer.hpp"
@@ -15,7 +21,11 @@
 #include <d3d11.h>
 
 #include <vector>
+#include <span>
+#include <optional>
 #include <filesystem>
+#include <cstddef>
+#include <cstdint>
 
 namespace gfx {
 namespace scenery {
@@ -53,14 +63,20 @@ private:
 #endif  // ACTIVATE_RENDERER_LOG
 public:
     Renderer()
-        : pipeline_(), pStorage_(nullptr)
+        : pipeline_(), pStorage_(nullptr), factory_(), viewport_(),
+        vertexShader_(), pixelShader_(), pipelineState_(),
+        instancedPipelineState_(), slotInstanceBuffer_(0u), cameraCBuf_(),
+        updateCamera_(nullptr), instanceBuffer_(), layerRecordings_()
     #ifdef ACTIVATE_RENDERER_LOG
         ,logComponent_(this)
     #endif
         {}
 
     Renderer(GFXPipeline pipeline)
-        : pipeline_( std::move(pipeline) ), pStorage_(nullptr)
+        : pipeline_( std::move(pipeline) ), pStorage_(nullptr), factory_(),
+        viewport_(), vertexShader_(), pixelShader_(), pipelineState_(),
+        instancedPipelineState_(), slotInstanceBuffer_(0u), cameraCBuf_(),
+        updateCamera_(nullptr), instanceBuffer_(), layerRecordings_()
     #ifdef ACTIVATE_RENDERER_LOG
         ,logComponent_(this)
     #endif
@@ -78,8 +94,30 @@ public:
 
     void render(Scene& scene);
 
-    void sync(GFXStorage& storage, GFXFactory factory) {
+    // draws the last render found hidden behind occluders.
+    std::size_t nOccludedDraws() const noexcept {
+        auto ret = std::size_t(0u);
+        for (const auto& recording : layerRecordings_) {
+            ret += recording.nOccluded;
+        }
+        return ret;
+    }
+
+    // levels of detail the draws of the last render took.
+    LODStats lodStats() const noexcept {
+        auto ret = LODStats{};
+        for (const auto& recording : layerRecordings_) {
+            ret += recording.lods;
+        }
+        return ret;
+    }
+
+    void sync( GFXStorage& storage, GFXFactory factory,
+        const D3D11_VIEWPORT& viewport
+    ) {
         pStorage_ = &storage;
+        factory_ = factory;
+        viewport_ = viewport;
         loadBindables(std::move(factory));
     }
 
@@ -120,22 +158,153 @@ protected:
         return *pStorage_;
     }
 
+    GFXPipeline& pipeline() noexcept {
+        return pipeline_;
+    }
+
+    // where every draw of the renderer goes.
+    const D3D11_VIEWPORT& viewport() const noexcept {
+        return viewport_;
+    }
+
+    // what a renderer draws with, of the types it gives:
+    // its shaders in a state object made of them and desc,
+    // and a camera cbuffer updated once per frame, before the draws.
+    // the vertex shader's type tags the camera cbuffer in the cache,
+    // so renderers of the same camera cbuffer type don't share its slot.
+    template <class VertexShaderT, class PixelShaderT, class CameraCBufT>
+    void loadPipeline( GFXFactory factory, const po::PipelineStateDesc& desc,
+        UINT slotCameraCBuffer
+    ) {
+        vertexShader_ = GFXRes::makeCached<VertexShaderT>( mappedStorage(),
+            CacheTag<VertexShaderT>{}, factory
+        );
+        pixelShader_ = GFXRes::makeCached<PixelShaderT>( mappedStorage(),
+            CacheTag<PixelShaderT>{}, factory
+        );
+        pipelineState_ = makePipelineState( vertexShader_, pixelShader_, desc );
+        instancedPipelineState_.reset();
+
+        cameraCBuf_ = GFXRes::makeCached<CameraCBufT>( mappedStorage(),
+            CacheTag<VertexShaderT, CameraCBufT>{}, factory
+        );
+        // its slot is set only here.
+        cameraCBuf_.pin();
+        cameraCBuf_.as<CameraCBufT>().setSlot(slotCameraCBuffer);
+        updateCamera_ = []( GFXRes& cbuf, GFXPipeline& pipeline,
+            const CameraVision& vision
+        ) {
+            cbuf.as<CameraCBufT>().update(pipeline, vision);
+        };
+    }
+
+    // instanced draws bind a state object of their own vertex shader
+    // and what loadPipeline loaded, called after it.
+    template <class InstancedVertexShaderT>
+    void loadInstancedPipeline( GFXFactory factory,
+        const po::PipelineStateDesc& desc, UINT slotInstanceBuffer
+    ) {
+        auto vertexShader = GFXRes::makeCached<InstancedVertexShaderT>(
+            mappedStorage(), CacheTag<InstancedVertexShaderT>{}, factory
+        );
+        instancedPipelineState_ = makePipelineState( vertexShader,
+            pixelShader_, desc
+        );
+        slotInstanceBuffer_ = slotInstanceBuffer;
+    }
+
 private:
-    virtual const RendererDesc rendererDesc() const = 0;
+    template <class ... Ts>
+    struct CacheTag {};
+
+    // runs shorter than this are drawn one by one.
+    static constexpr std::size_t minInstanceRun = 2u;
+    // the largest on the screen are rasterized, others rarely hide much.
+    static constexpr std::size_t maxOccluders = 8u;
+
+    const RendererDesc rendererDesc() const;
+    // loads through loadPipeline.
     virtual void loadBindables(GFXFactory factory) = 0;
+    // updates what is shared by every draw of a frame, once before them.
+    void syncFrame(const CameraVision& vision);
+
+    // shared by renderers made of the same shaders and states.
+    // the shaders and the state object are pinned,
+    // as the renderer takes their IDs even in frames it draws nothing.
+    GFXRes makePipelineState( GFXRes& vertexShader,
+        GFXRes& pixelShader, po::PipelineStateDesc desc
+    );
+
+    class PipelineBackend;
+    class StagingBackend;
+
+    struct Occluder {
+        float extent;   // projected radius of the bounds
+        Transform world;
+    };
+
+    struct DepthEntry {
+        float viewDepth;    // w of the bounds' center in clip space
+        RCDrawCmp* drawCmp;
+    };
+
+    // per layer, reused across frames to record without allocation.
+    struct LayerRecording {
+        GFXCommandBuffer cmds;
+        std::vector<InstanceTransforms> instances;
+        std::vector<RCDrawCmp*> visibleCmps;
+        std::vector<Occluder> occluders;
+        std::vector<DepthEntry> depthEntries;
+        OcclusionBuffer occlusion;
+        std::size_t nOccluded;
+        LODStats lods;
+    };
+
+    // touches no device context, so layers are recorded concurrently.
+    // thus a draw component must not belong to several layers.
+    void record( const RendererDesc& desc, Layer& layer,
+        const CameraVision& vision, const Frustum& frustum,
+        LayerRecording& recording
+    ) const;
+    // drops visible components hidden behind others in the same layer.
+    static void occlude(const Transform& viewProj, LayerRecording& recording);
+    // orders visible components near to far within equal sort keys,
+    // as the layer sorts them regardless of the camera.
+    static void sortByDepth(const Transform& viewProj,
+        LayerRecording& recording
+    );
 
     GFXPipeline pipeline_;
     GFXStorage* pStorage_;
+    GFXFactory factory_;
+    D3D11_VIEWPORT viewport_;
+    GFXRes vertexShader_;
+    GFXRes pixelShader_;
+    GFXRes pipelineState_;
+    // bound for instanced draws, none if the renderer doesn't instance.
+    std::optional<GFXRes> instancedPipelineState_;
+    UINT slotInstanceBuffer_;
+    GFXRes cameraCBuf_;
+    // set by loadPipeline, which knows the camera cbuffer's type.
+    void (*updateCamera_)(GFXRes&, GFXPipeline&, const CameraVision&);
+    std::optional< po::InstanceBuffer<InstanceTransforms> > instanceBuffer_;
+    std::vector<LayerRecording> layerRecordings_;
 #ifdef ACTIVATE_RENDERER_LOG
     LogComponent logComponent_;
 #endif // ACTIVATE_RENDERER_LOG
 };
 
-class SolidRenderer : public Renderer {
+// view * projection of a frame, mapped once before its draws
+// by renderers whose shaders take nothing else from the camera.
+class ViewProjCBuf : public po::VSCBuffer<dx::XMMATRIX> {
 public:
-    struct {} tagVertexShader;
-    struct {} tagPixelShader;
+    ViewProjCBuf(GFXFactory factory);
+
+    void update(GFXPipeline& pipeline, const CameraVision& vision);
+};
 
+class SolidRenderer : public Renderer {
+public:
     class MyVertexShader : public po::VertexShader {
     public:
         MyVertexShader(GFXFactory factory);
@@ -157,10 +326,15 @@ public:
         return 0u;
     }
 
-    static consteval UINT slotTransCBuf() {
+    static consteval UINT slotCameraCBuffer() {
         return 0u;
     }
 
+    // world transform of each draw.
+    static consteval UINT slotObjectCBuffer() {
+        return 1u;
+    }
+
     static consteval UINT slotColorCBuf() {
         return 0u;
     }
@@ -170,20 +344,11 @@ public:
         : Renderer(std::move(pipeline)) {}
 
 private:
-    const RendererDesc rendererDesc() const override;
-
     void loadBindables(GFXFactory factory) override;
-
-    GFXStorage* pStorage_;
-    GFXRes vertexShader_;
-    GFXRes pixelShader_;
 };
 
 class IndexedRenderer : public Renderer {
 public:
-    struct {} tagVertexShader;
-    struct {} tagPixelShader;
-
     class MyVertexShader : public po::VertexShader {
     public:
         MyVertexShader(GFXFactory factory);
@@ -205,25 +370,25 @@ public:
         return 0u;
     }
 
+    static consteval UINT slotCameraCBuffer() {
+        return 0u;
+    }
+
+    // world transform of each draw.
+    static consteval UINT slotObjectCBuffer() {
+        return 1u;
+    }
+
     IndexedRenderer() = default;
     IndexedRenderer(GFXPipeline pipeline)
         : Renderer(std::move(pipeline)) {}
 
 private:
-    const RendererDesc rendererDesc() const override;
-
     void loadBindables(GFXFactory factory) override;
-
-    GFXStorage* pStorage_;
-    GFXRes vertexShader_;
-    GFXRes pixelShader_;
 };
 
 class BlendedRenderer : public Renderer {
 public:
-    struct {} tagVertexShader;
-    struct {} tagPixelShader;
-
     class MyVertexShader : public po::VertexShader {
     public:
         MyVertexShader(GFXFactory factory);
@@ -253,20 +418,21 @@ public:
         return 1u;
     }
 
+    static consteval UINT slotCameraCBuffer() {
+        return 0u;
+    }
+
+    // world transform of each draw.
+    static consteval UINT slotObjectCBuffer() {
+        return 1u;
+    }
+
 private:
-    const RendererDesc rendererDesc() const override;
     void loadBindables(GFXFactory factory) override;
-
-    GFXStorage* pStorage_;
-    GFXRes vertexShader_;
-    GFXRes pixelShader_;
 };
 
 class TexturedRenderer : public Renderer {
 public:
-    struct {} tagVertexShader;
-    struct {} tagPixelShader;
-
     class MyVertexShader : public po::VertexShader {
     public:
         MyVertexShader(GFXFactory factory);
@@ -304,20 +470,34 @@ public:
         return 0u;
     }
 
+    static consteval UINT slotCameraCBuffer() {
+        return 0u;
+    }
+
+    // world transform of each draw.
+    static consteval UINT slotObjectCBuffer() {
+        return 1u;
+    }
+
 private:
-    const RendererDesc rendererDesc() const override;
     void loadBindables(GFXFactory factory) override;
-
-    GFXStorage* pStorage_;
-    GFXRes vertexShader_;
-    GFXRes pixelShader_;
 };
 
 class BPhongRenderer : public Renderer {
 public:
-    struct {} tagVertexShader;
-    struct {} tagPixelShader;
-    
+    // transposed for the shaders.
+    struct CameraConstants {
+        dx::XMMATRIX view;
+        dx::XMMATRIX viewProj;
+    };
+
+    class MyCameraCBuf : public po::VSCBuffer<CameraConstants> {
+    public:
+        MyCameraCBuf(GFXFactory factory);
+
+        void update(GFXPipeline& pipeline, const CameraVision& vision);
+    };
+
     class MyVertexShader : public po::VertexShader {
     public:
         MyVertexShader(GFXFactory factory);
@@ -327,6 +507,17 @@ public:
         std::filesystem::path csoPath() const noexcept;
     };
 
+    // reads world transforms from InstanceTransforms
+    // instead of the object cbuffer.
+    class MyInstancedVertexShader : public po::VertexShader {
+    public:
+        MyInstancedVertexShader(GFXFactory factory);
+
+    private:
+        std::vector<D3D11_INPUT_ELEMENT_DESC> inputElemDescs() const noexcept;
+        std::filesystem::path csoPath() const noexcept;
+    };
+
     class MyPixelShader : public po::PixelShader {
     public:
         MyPixelShader(GFXFactory factory);
@@ -347,6 +538,19 @@ public:
         return 1u;
     }
 
+    static consteval UINT slotInstanceBuffer() {
+        return 2u;
+    }
+
+    static consteval UINT slotCameraCBuffer() {
+        return 0u;
+    }
+
+    // world transform of each non-instanced draw.
+    static consteval UINT slotObjectCBuffer() {
+        return 1u;
+    }
+
     static consteval UINT slotLightCBuffer() {
         return 0u;
     }
@@ -356,12 +560,7 @@ public:
     }
 
 private:
-    const RendererDesc rendererDesc() const override;
     void loadBindables(GFXFactory factory) override;
-
-    GFXStorage* pStorage_;
-    GFXRes vertexShader_;
-    GFXRes pixelShader_;
 };
 
 }  // namespace scenery
@@ -1,11 +1,12 @@
 #ifndef __RendererDesc
 #define __RendererDesc
 
+#include "RenderObjectDesc.hpp"
 #include "GFX/Core/Storage.hpp"
 
 #include <typeindex>
 #include <tuple>
-#include <vector>
+#include <cstdint>
 
 namespace gfx {
 namespace scenery {
@@ -30,7 +31,11 @@ struct RendererDesc {
     }
 
     Header header;
-    std::vector<GFXStorage::ID> IDs;
+    GFXIDList IDs;
+    // bound instead of IDs for instanced draw calls,
+    // empty if the renderer doesn't instance.
+    GFXIDList instancedIDs = {};
+    std::uint32_t slotInstanceBuffer = 0u;
 };
 
 }  // namespace gfx::scenery
@@ -7,6 +7,9 @@
 #include "GFX/Core/Storage.hpp"
 #include "GFX/Core/Factory.hpp"
 #include "GFX/Core/Pipeline.hpp"
+#include "App/ChiliWindow.hpp"
+
+#include <d3d11.h>
 
 #include <vector>
 #include <memory>
@@ -21,10 +24,20 @@ class RendererSystem {
 public:
     using Slot = std::size_t;
 
-    RendererSystem(GFXFactory factory, GFXPipeline pipeline)
-        : resourceStorage_(), pairs_(),
+    // renderers draw to the whole client area.
+    RendererSystem( GFXFactory factory, GFXPipeline pipeline,
+        const Win32::Client& client
+    ) : resourceStorage_(), pairs_(),
         factory_( std::move(factory) ),
-        pipeline_( std::move(pipeline) ) {}
+        pipeline_( std::move(pipeline) ),
+        viewport_( D3D11_VIEWPORT{
+            .TopLeftX = 0.f,
+            .TopLeftY = 0.f,
+            .Width = static_cast<FLOAT>(client.width),
+            .Height = static_cast<FLOAT>(client.height),
+            .MinDepth = 0.f,
+            .MaxDepth = 1.f
+        } ) {}
 
     template <class RendererT>
     Slot addRenderer() {
@@ -34,7 +47,7 @@ public:
 
     void sync(Slot slot) {
         auto& [pRenderer, _] = pairs_.at(slot);
-        pRenderer->sync(resourceStorage_, factory_);
+        pRenderer->sync(resourceStorage_, factory_, viewport_);
     }
 
 #ifdef ACTIVATE_RENDERER_LOG
@@ -55,9 +68,14 @@ public:
 #endif // ACTIVATE_RENDERER_LOG
 
     void render() {
+        resourceStorage_.syncAsync();
+
         for (auto slot = Slot(0); slot < pairs_.size(); ++slot) {
             render(slot);
         }
+
+        resourceStorage_.advanceFrame();
+        pipeline_.advanceFrame();
     }
 
     void render(Slot slot) {
@@ -113,6 +131,7 @@ private:
     > > pairs_; // Renderer - Scene pairs (1:1 relationship)
     GFXFactory factory_;
     GFXPipeline pipeline_;
+    D3D11_VIEWPORT viewport_;
 };
 
 }  // namespace gfx::scenery
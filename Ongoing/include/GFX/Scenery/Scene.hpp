@@ -3,14 +3,21 @@
 
 #include "RCDrawComponent.hpp"
 #include "Camera.hpp"
+#include "Culling.hpp"
+#include "DynamicBVH.hpp"
+#include "SortedRun.hpp"
 
 #include "GFX/Core/Storage.hpp"
 
 #include <ranges>
 #include <algorithm>
 #include <vector>
+#include <span>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <concepts>
+#include <cstdint>
 
 #include "AdditionalRanges.hpp"
 
@@ -19,8 +26,56 @@
 namespace gfx {
 namespace scenery {
 
-class Layer {
+// keeps its draw components sorted across frames, see SortedRun.
+// bounded components are also kept in a BVH, for culling and picking.
+class Layer : public SortKeyListener {
 public:
+    struct PickResult {
+        RCDrawCmp* drawCmp;
+        float distance;
+    };
+
+    Layer()
+        : drawCmps_(), bindees_(), bvh_(), proxies_(),
+        drawProxies_(), bDrawProxiesStale_(false), bSeen_() {}
+
+    ~Layer() {
+        detachAll();
+    }
+
+    Layer(const Layer&) = delete;
+    Layer& operator=(const Layer&) = delete;
+
+    // draw components report to the layer by address, so they follow moves.
+    Layer(Layer&& other) noexcept
+        : drawCmps_( std::move(other.drawCmps_) ),
+        bindees_( std::move(other.bindees_) ),
+        bvh_( std::move(other.bvh_) ),
+        proxies_( std::move(other.proxies_) ),
+        drawProxies_( std::move(other.drawProxies_) ),
+        bDrawProxiesStale_(other.bDrawProxiesStale_),
+        bSeen_( std::move(other.bSeen_) ) {
+        attachAll();
+    }
+
+    Layer& operator=(Layer&& other) noexcept {
+        if (this == &other) [[unlikely]] {
+            return *this;
+        }
+
+        detachAll();
+        drawCmps_ = std::move(other.drawCmps_);
+        bindees_ = std::move(other.bindees_);
+        bvh_ = std::move(other.bvh_);
+        proxies_ = std::move(other.proxies_);
+        drawProxies_ = std::move(other.drawProxies_);
+        bDrawProxiesStale_ = other.bDrawProxiesStale_;
+        bSeen_ = std::move(other.bSeen_);
+        attachAll();
+
+        return *this;
+    }
+
     void setup() {
 
     }
@@ -50,7 +105,9 @@ public:
     }
 
     void addDrawCmp(RCDrawCmp* drawCmp) {
-        drawCmps_.push_back(drawCmp);
+        drawCmps_.add(drawCmp);
+        drawCmp->setSortKeyListener(this);
+        bDrawProxiesStale_ = true;
     }
 
     template <std::ranges::range R>
@@ -58,36 +115,174 @@ public:
             || std::same_as< std::ranges::range_value_t<R>, const RCDrawCmp* >
         )
     void addDrawCmp(R&& range) {
-        if constexpr ( std::ranges::sized_range<R> ) {
-            drawCmps_.reserve( std::size(range) );
+        for (auto drawCmp : range) {
+            addDrawCmp(drawCmp);
         }
-
-        drawCmps_.insert( drawCmps_.end(), std::begin(range), std::end(range) );
     }
 
-    // to be added: removeDrawCmp
+    // the others stay in order.
+    void removeDrawCmp(RCDrawCmp* drawCmp) {
+        drawCmps_.remove(drawCmp);
+        drawCmp->setSortKeyListener(nullptr);
+
+        if ( auto it = proxies_.find(drawCmp); it != proxies_.end() ) {
+            bvh_.remove(it->second);
+            proxies_.erase(it);
+        }
+        bDrawProxiesStale_ = true;
+    }
 
     auto drawCmps() noexcept {
-        return drawCmps_ | dereference();
+        return drawCmps_.items() | dereference();
     }
 
     const auto drawCmps() const noexcept {
-        return drawCmps_ | dereference();
+        return drawCmps_.items() | dereference();
+    }
+
+    // in draw order, for walking runs of draw components.
+    std::span<RCDrawCmp* const> drawCmpPtrs() const noexcept {
+        return drawCmps_.items();
+    }
+
+    // pulls the bounds of every draw component into the BVH.
+    // call once their transforms are updated for the frame.
+    void refitBounds() {
+        syncDrawProxies();
+
+        const auto drawCmps = drawCmps_.items();
+        for (std::size_t i = 0u; i < drawCmps.size(); ++i) {
+            const auto drawCmp = drawCmps[i];
+            const auto bounds = drawCmp->bounds();
+            auto& proxy = drawProxies_[i];
+
+            if ( !bounds.has_value() ) {
+                if (proxy != BVH::nullProxy) {
+                    bvh_.remove(proxy);
+                    proxies_.erase(drawCmp);
+                    proxy = BVH::nullProxy;
+                }
+            }
+            else if (proxy == BVH::nullProxy) {
+                proxy = bvh_.insert( BoundingBox::enclosing( bounds.value() ),
+                    drawCmp
+                );
+                proxies_.emplace(drawCmp, proxy);
+            }
+            else {
+                bvh_.move( proxy, BoundingBox::enclosing( bounds.value() ) );
+            }
+        }
+
+        if ( bvh_.rebuildDue() ) {
+            bvh_.rebuild();
+        }
     }
 
+    // components the frustum may see, as bounded by the last refit.
+    // unbounded ones are always seen.
+    // in draw order, so the renderer only orders equal keys by depth.
+    void cull(const Frustum& frustum, std::vector<RCDrawCmp*>& visible) {
+        syncDrawProxies();
+
+        // marked by proxy, then picked up walking the draw order,
+        // which leaves every mark cleared.
+        bSeen_.resize( bvh_.capacity() );
+        bvh_.queryFrustum( frustum, [this](BVH::Proxy proxy, RCDrawCmp*) {
+            bSeen_[proxy] = true;
+        } );
+
+        visible.clear();
+        const auto drawCmps = drawCmps_.items();
+        for (std::size_t i = 0u; i < drawCmps.size(); ++i) {
+            const auto proxy = drawProxies_[i];
+            if (proxy == BVH::nullProxy) {
+                visible.push_back( drawCmps[i] );
+            }
+            else if ( bSeen_[proxy] ) {
+                visible.push_back( drawCmps[i] );
+                bSeen_[proxy] = false;
+            }
+        }
+    }
+
+    // the nearest bounded component along the ray,
+    // among those as bounded by the last refit.
+    std::optional<PickResult> pick(const Ray& ray) const {
+        const auto hit = bvh_.raycast( ray,
+            [&ray](const RCDrawCmp* drawCmp, float tMax) {
+                const auto bounds = drawCmp->bounds();
+                return bounds.has_value() ? ray.intersect(bounds.value(), tMax)
+                    : std::nullopt;
+            }
+        );
+
+        if ( !hit.has_value() ) {
+            return std::nullopt;
+        }
+        return PickResult{
+            .drawCmp = bvh_.value(hit->proxy),
+            .distance = hit->distance
+        };
+    }
+
+    void sortKeyChanged(DynDrawCmpBase& drawCmp) override {
+        drawCmps_.keyChanged( static_cast<RCDrawCmp*>(&drawCmp) );
+    }
+
+    // added components have no key before their first sync.
     template <class TRenderer>
     void sortFor(const TRenderer& renderer) {
-        std::ranges::for_each( drawCmps(), [&renderer](auto& dc) {
-            dc.sync(renderer);
+        if ( drawCmps_.sorted() ) [[likely]] {
+            return;
+        }
+
+        drawCmps_.repair( [&renderer](RCDrawCmp* drawCmp) {
+            drawCmp->sync(renderer);
         } );
-        std::ranges::sort( drawCmps_, std::less<>{},
-            &IDrawComponent::renderObjectDesc
-        );
+        bDrawProxiesStale_ = true;
     }
 
 private:
-    std::vector<RCDrawCmp*> drawCmps_;
+    // lines drawProxies_ up with the draw order again.
+    void syncDrawProxies() {
+        if (!bDrawProxiesStale_) [[likely]] {
+            return;
+        }
+
+        drawProxies_.clear();
+        for ( auto drawCmp : drawCmps_.items() ) {
+            const auto it = proxies_.find(drawCmp);
+            drawProxies_.push_back(
+                it != proxies_.end() ? it->second : BVH::nullProxy
+            );
+        }
+        bDrawProxiesStale_ = false;
+    }
+
+    void attachAll() noexcept {
+        for ( auto drawCmp : drawCmps_.items() ) {
+            drawCmp->setSortKeyListener(this);
+        }
+    }
+
+    void detachAll() noexcept {
+        for ( auto drawCmp : drawCmps_.items() ) {
+            drawCmp->setSortKeyListener(nullptr);
+        }
+    }
+
+    SortedRun<RCDrawCmp> drawCmps_;
     std::vector<GFXResView> bindees_;
+
+    using BVH = DynamicBVH<RCDrawCmp*>;
+    BVH bvh_;
+    std::unordered_map<const RCDrawCmp*, BVH::Proxy> proxies_;
+    // parallel to drawCmps_, nullProxy for unbounded components.
+    std::vector<BVH::Proxy> drawProxies_;
+    bool bDrawProxiesStale_;
+    // marked by proxy while culling, all cleared between culls.
+    std::vector<bool> bSeen_;
 };
 
 class Scene {
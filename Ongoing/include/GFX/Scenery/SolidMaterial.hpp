@@ -21,7 +21,8 @@ struct SolidMaterialDesc {
 
 class SolidMaterial : public po::IPipelineObject {
 private:
-    using MyPSCBuffer = po::PSCBuffer<SolidMaterialDesc>;
+    // static materials aren't uploaded again on every bind.
+    using MyPSCBuffer = po::ShadowedCBuffer< po::PSCBuffer<SolidMaterialDesc> >;
 
 public:
     SolidMaterial() = default;
@@ -0,0 +1,141 @@
+#ifndef __SortedRun
+#define __SortedRun
+
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <functional>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "RadixSort.hpp"
+
+namespace gfx {
+namespace scenery {
+
+template <class T>
+concept SortKeyed = requires (const T& t) {
+    { t.sortKey() } -> std::convertible_to<std::uint64_t>;
+};
+
+// keeps pointers sorted by their sort keys across frames.
+// only those added, or whose key changed since the last repair,
+// are sorted and merged back into the sorted run,
+// so keeping a static run in order costs nothing.
+template <SortKeyed T>
+class SortedRun {
+public:
+    SortedRun()
+        : items_(), pending_(), sortEntries_(), sortScratch_(),
+        merged_(), nLastRepaired_(0u) {}
+
+    void add(T* item) {
+        items_.push_back(item);
+        pending_.push_back(item);
+    }
+
+    // the others stay in order.
+    void remove(T* item) {
+        std::erase(items_, item);
+        std::erase(pending_, item);
+    }
+
+    void keyChanged(T* item) {
+        pending_.push_back(item);
+    }
+
+    bool sorted() const noexcept {
+        return pending_.empty();
+    }
+
+    // prepare(item) runs on every pending item before it's sorted,
+    // e.g. to take its first key, and may report more changed keys.
+    template <class Fn>
+        requires std::invocable<Fn&, T*>
+    void repair(Fn prepare) {
+        if ( pending_.empty() ) [[likely]] {
+            nLastRepaired_ = 0u;
+            return;
+        }
+
+        // preparing may append to pending_, so iterate by index.
+        for (std::size_t i = 0u; i < pending_.size(); ++i) {
+            std::invoke( prepare, pending_[i] );
+        }
+
+        std::ranges::sort(pending_);
+        const auto [first, last] = std::ranges::unique(pending_);
+        pending_.erase(first, last);
+
+        // what is left of the sorted run stays sorted.
+        std::erase_if( items_, [this](T* item) {
+            return std::ranges::binary_search(pending_, item);
+        } );
+
+        sortEntries_.clear();
+        sortEntries_.reserve( pending_.size() );
+        for (std::size_t i = 0u; i < pending_.size(); ++i) {
+            sortEntries_.push_back( SortEntry{
+                .key = pending_[i]->sortKey(),
+                .idx = static_cast<std::uint32_t>(i)
+            } );
+        }
+        radixSort( sortEntries_, sortScratch_, &SortEntry::key );
+
+        merge();
+        nLastRepaired_ = pending_.size();
+        pending_.clear();
+    }
+
+    // in key order as of the last repair.
+    std::span<T* const> items() const noexcept {
+        return items_;
+    }
+
+    std::size_t size() const noexcept {
+        return items_.size();
+    }
+
+    // items sorted and merged by the last repair, 0 if it had nothing to do.
+    std::size_t nLastRepaired() const noexcept {
+        return nLastRepaired_;
+    }
+
+private:
+    struct SortEntry {
+        std::uint64_t key;
+        std::uint32_t idx;
+    };
+
+    // merges the sorted pending items into the sorted run.
+    void merge() {
+        merged_.clear();
+        merged_.reserve( items_.size() + sortEntries_.size() );
+
+        auto itRun = items_.begin();
+        for (const auto& entry : sortEntries_) {
+            while ( itRun != items_.end() && (*itRun)->sortKey() <= entry.key ) {
+                merged_.push_back(*itRun++);
+            }
+            merged_.push_back( pending_[entry.idx] );
+        }
+        merged_.insert( merged_.end(), itRun, items_.end() );
+
+        items_.swap(merged_);
+    }
+
+    std::vector<T*> items_;
+    // added or re-keyed since the last repair, may hold duplicates.
+    std::vector<T*> pending_;
+    // reused across frames to sort without allocation.
+    std::vector<SortEntry> sortEntries_;
+    std::vector<SortEntry> sortScratch_;
+    std::vector<T*> merged_;
+    std::size_t nLastRepaired_;
+};
+
+}  // namespace gfx::scenery
+}  // namespace gfx
+
+#endif  // __SortedRun
@@ -14,6 +14,9 @@
 namespace gfx {
 namespace scenery {
 
+// maps the world transform only, renderers map the camera's once a frame.
+// binds the transform cbuffer by itself,
+// so draws leave it out of their IDs.
 class MapTransformGPU : public po::IDrawContext {
 public:
     using MatrixType = dx::XMMATRIX;
@@ -30,46 +33,16 @@ public:
         transform_ = transform;
     }
 
-    void pushBackApplyee(Transform transform) {
-        applyees_.push_back(transform);
-    }
-
-    void popBackApplyee() {
-        applyees_.pop_back();
+    const Transform& transform() const noexcept {
+        return transform_;
     }
 
 private:
     Transform transform_;
-    std::vector<Transform> applyees_;
     GFXStorage* mappedStorage_;
     std::optional<GFXStorage::ID> IDTransCBuf_;
 };
 
-class ApplyTransform : public po::IDrawContext {
-public:
-    ApplyTransform(MapTransformGPU& mapper)
-        : transform_(), mapper_(&mapper) {}
-
-    void setTransform(Transform transform) {
-        transform_ = transform;
-    }
-
-    void beforeDrawCall(GFXPipeline& pipeline) override;
-    void afterDrawCall(GFXPipeline& pipeline) override;
-
-    void linkMapper(MapTransformGPU& mapper) {
-        mapper_ = &mapper;
-    }
-
-    void swap(ApplyTransform& ohter) noexcept {
-        std::swap(transform_, ohter.transform_);
-    }
-
-private:
-    Transform transform_;
-    MapTransformGPU* mapper_;
-};
-
 }  // namespace gfx::scenery
 }  // namespace gfx
 
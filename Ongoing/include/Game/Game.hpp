@@ -25,6 +25,8 @@
 #include "SimulationUI.hpp"
 
 #include <memory>
+#include <optional>
+#include <utility>
 
 class Game;
 
@@ -51,11 +53,35 @@ private:
     bool bSimulate_;
 };
 
+// remembers where the left button was pressed, for picking.
+template<>
+class MouseInputComponent<Game> : public IMouseInputComponent {
+public:
+    MouseInputComponent(const MousePointConverter& converter)
+        : converter_(converter), pressed_() {}
+
+    void receive(const Mouse::Event& ev) override {
+        if (ev.leftPressed()) {
+            pressed_ = converter_.convert(ev.pos());
+        }
+    }
+
+    // the point pressed since the last call, if any.
+    std::optional<AppMousePoint> consumePressed() noexcept {
+        return std::exchange(pressed_, std::nullopt);
+    }
+
+private:
+    const MousePointConverter& converter_;
+    std::optional<AppMousePoint> pressed_;
+};
+
 class Game {
 public:
     using MyTimer = Timer<float>;
     using MyChar = ChiliWindow::MyChar;
     using MyIC = KeyboardInputComponent<Game, CHAR>;
+    using MyMouseIC = MouseInputComponent<Game>;
 
     Game(const ChiliWindow& wnd, gfx::Graphics& gfx,
         Keyboard<MyChar>& kbd, Mouse& mouse
@@ -66,7 +92,11 @@ public:
     void render();
 
 private:
+    // bytes of resources kept loaded, those not drawn lately go beyond it.
+    static constexpr std::size_t resourceBudget = 8u << 20u;
+
     void updateEntities(milliseconds elapsed);
+    void pick();
 
     void createObjects(std::size_t n, const ChiliWindow& wnd,
         gfx::Graphics& gfx, Keyboard<MyChar>& kbd, Mouse& mouse
@@ -86,6 +116,10 @@ private:
     );
 
     gfx::scenery::RendererSystem rendererSystem_;
+    // boxes and the light are drawn by the first,
+    // the light's visualization by the second.
+    gfx::scenery::RendererSystem::Slot slotBPhongRenderer_;
+    gfx::scenery::RendererSystem::Slot slotSolidRenderer_;
     InputSystem<MyChar> inputSystem_;
     CoordSystem coordSystem_;
     MyTimer timer_;
@@ -97,6 +131,7 @@ private:
     SimulationUI simulationUI_;
 
     std::shared_ptr<MyIC> ic_;
+    std::shared_ptr<MyMouseIC> mouseIC_;
 };
 
 #endif  // __Game
\ No newline at end of file
@@ -14,6 +14,9 @@
 #include "GFX/PipelineObjects/Texture.hpp"
 #include "GFX/PipelineObjects/Sampler.hpp"
 
+#include <optional>
+#include <cmath>
+
 class IlluminatedBox {
 
 };
@@ -24,10 +27,7 @@ public:
     struct {} tagVertexBuffer;
     struct {} tagNormalBuffer;
     struct {} tagMaterial;
-    struct {} tagTopology;
-    struct {} tagTransformCBufV;
-    struct {} tagTransformCBufVP;
-    struct {} tagViewport;
+    struct {} tagTransformCBuf;
 
     class MyVertexBuffer : public gfx::Primitives::Cube::CubeVertexBufferIndependent {
     public:
@@ -51,63 +51,45 @@ public:
 
     using MyMaterial = SolidMaterial;
 
-    using MyTopology = PETopology;
-
-    class MyTransformCBufV : public PETransformCBuf {
-    public:
-        MyTransformCBufV() = default;
-        MyTransformCBufV(GFXFactory factory)
-            : PETransformCBuf(std::move(factory)) {}
-    };
-
-    class MyTransformCBufVP : public PETransformCBuf {
+    // world transform only, the renderer holds the camera's.
+    class MyTransformCBuf : public PETransformCBuf {
     public:
-        MyTransformCBufVP() = default;
-        MyTransformCBufVP(GFXFactory factory)
+        MyTransformCBuf() = default;
+        MyTransformCBuf(GFXFactory factory)
             : PETransformCBuf(std::move(factory)) {}
     };
 
-    using MyViewport = PEViewport;
     using MyDrawCaller = gfx::po::DrawCaller;
 
     DrawComponent( gfx::GFXFactory factory, gfx::GFXPipeline pipeline,
-        gfx::GFXStorage& storage, const ChiliWindow& wnd
-    ) : transformGPUMapperV_(storage),
-        transformGPUMapperVP_(storage),
-        transformApplyerV_(transformGPUMapperV_),
-        transformApplyerVP_(transformGPUMapperVP_),
+        gfx::GFXStorage& storage, const ChiliWindow&
+    ) : transformGPUMapper_(storage),
     #ifdef ACTIVATE_DRAWCOMPONENT_LOG
         logComponent_(this),
     #endif
         posBuffer_( GFXRes::makeCached<MyVertexBuffer>(storage, tagVertexBuffer, factory) ),
         normalBuffer_( GFXRes::makeCached<MyNormalBuffer>(storage, tagNormalBuffer, factory) ),
-        material_( GFXRes::makeCached<MyMaterial>(storage, tagMaterial, factory, storage) ),
-        topology_( GFXRes::makeCached<MyTopology>(storage, tagTopology) ),
-        viewport_( GFXRes::makeCached<MyViewport>(storage, tagViewport, wnd.client() )),
-        transformCBufV_( GFXRes::makeCached<MyTransformCBufV>(storage, tagTransformCBufV, factory) ),
-        transformCBufVP_( GFXRes::makeCached<MyTransformCBufVP>(storage, tagTransformCBufVP, factory) ),
+        material_( GFXRes::makeCached<MyMaterial>( storage, tagMaterial,
+            factory, std::ref(storage)
+        ) ),
+        transformCBuf_( GFXRes::makeCached<MyTransformCBuf>(storage, tagTransformCBuf, factory) ),
         pipeline_(pipeline), pStorage_(&storage) {
 
-        transformGPUMapperV_.setTCBufID(transformCBufV_.id());
-        transformGPUMapperVP_.setTCBufID(transformCBufVP_.id());
+        // the material lives in the bindee, rebuilding it would lose that.
+        material_.pin();
 
         this->setDrawCaller( std::make_unique<MyDrawCaller>(
             static_cast<UINT>( MyVertexBuffer::size() ), 0
         ) );
 
-        this->drawCaller().addDrawContext(&transformApplyerV_);
-        this->drawCaller().addDrawContext(&transformGPUMapperV_);
-
-        this->drawCaller().addDrawContext(&transformApplyerVP_);
-        this->drawCaller().addDrawContext(&transformGPUMapperVP_);
+        this->drawCaller().addDrawContext(&transformGPUMapper_);
     #ifdef ACTIVATE_DRAWCOMPONENT_LOG
         logComponent_.entryStackPop();
     #endif
     }
 
     void VCALL updateTrans(const gfx::Transform transform) {
-        transformGPUMapperV_.update(transform);
-        transformGPUMapperVP_.update(transform);
+        transformGPUMapper_.update(transform);
     }
 
     void VCALL updateDiffuse(dx::FXMVECTOR color) {
@@ -148,11 +130,11 @@ public:
     }
 
     void sync(const gfx::scenery::BPhongRenderer& renderer) {
-        assert(transformCBufV_.valid());
-        transformCBufV_.as<MyTransformCBufV>().setSlot( 0u );
-
-        assert(transformCBufVP_.valid());
-        transformCBufVP_.as<MyTransformCBufVP>().setSlot( 1u );
+        assert(transformCBuf_.valid());
+        transformCBuf_.as<MyTransformCBuf>().setSlot(
+            gfx::scenery::BPhongRenderer::slotObjectCBuffer()
+        );
+        transformGPUMapper_.setTCBufID( transformCBuf_.id() );
 
         assert(posBuffer_.valid());
         posBuffer_.as<MyVertexBuffer>().setSlot(
@@ -172,36 +154,53 @@ public:
         this->setRODesc( gfx::scenery::RenderObjectDesc{
             .header = {
                 .IDBuffer = posBuffer_.id(),
-                .IDType = typeid(IlluminatedBox)
+                .IDType = typeid(IlluminatedBox),
+                .denseType = gfx::scenery::denseTypeIndex<IlluminatedBox>(),
+                .IDMaterial = material_.id()
             },
             .IDs = {
-                posBuffer_.id(), normalBuffer_.id(), material_.id(),
-                topology_.id(), viewport_.id(), transformCBufV_.id(),
-                transformCBufVP_.id()
+                posBuffer_.id(), normalBuffer_.id(), material_.id()
+            },
+            .instancedIDs = {
+                posBuffer_.id(), normalBuffer_.id(), material_.id()
             }
         } );
     }
 
-    void sync(const gfx::scenery::CameraVision& vision) {
-        transformApplyerV_.setTransform( vision.viewTrans() );
-        transformApplyerVP_.setTransform( vision.viewTrans() * vision.projTrans() );
+    // the camera's transforms are bound by the renderer once per frame.
+    void sync(const gfx::scenery::CameraVision&) {}
+
+    // the same transform the draw context would map, untransposed.
+    void writeInstance(gfx::scenery::InstanceTransforms& dst) const override {
+        dx::XMStoreFloat4x4( &dst.world, transformGPUMapper_.transform().get() );
+    }
+
+    std::optional<gfx::scenery::BoundingSphere> bounds() const override {
+        // circumscribes the cube in model space.
+        const auto local = gfx::scenery::BoundingSphere{
+            .center = dx::XMFLOAT3(0.f, 0.f, 0.f),
+            .radius = std::sqrt(3.f) * gfx::Primitives::Cube::side
+        };
+
+        return local.transformed( transformGPUMapper_.transform().get() );
+    }
+
+    std::optional<gfx::Transform> occluder() const override {
+        // the cube itself, it's solid.
+        constexpr auto side = gfx::Primitives::Cube::side;
+        return gfx::Transform( dx::XMMatrixScaling(side, side, side) )
+            * transformGPUMapper_.transform();
     }
 
 private:
-    gfx::scenery::MapTransformGPU transformGPUMapperV_;
-    gfx::scenery::MapTransformGPU transformGPUMapperVP_;
-    gfx::scenery::ApplyTransform transformApplyerV_;
-    gfx::scenery::ApplyTransform transformApplyerVP_;
+    gfx::scenery::MapTransformGPU transformGPUMapper_;
 #ifdef ACTIVATE_DRAWCOMPONENT_LOG
     gfx::scenery::IDrawComponent::LogComponent logComponent_;
 #endif
     gfx::GFXRes posBuffer_;
     gfx::GFXRes normalBuffer_;
     gfx::GFXRes material_;
-    gfx::GFXRes topology_;
-    gfx::GFXRes viewport_;
-    gfx::GFXRes transformCBufV_;
-    gfx::GFXRes transformCBufVP_;
+    gfx::GFXRes transformCBuf_;
     std::optional<gfx::scenery::RenderObjectDesc> RODesc_;
     MyDrawCaller drawCaller_;
     gfx::GFXPipeline pipeline_;
@@ -17,10 +17,8 @@
 #include "GFX/Core/Pipeline.hpp"
 #include "GFX/PipelineObjects/IA.hpp"
 
-#include "GFX/PipelineObjects/Topology.hpp"
 #include "GFX/PipelineObjects/Buffer.hpp"
 #include "GFX/PipelineObjects/Shader.hpp"
-#include "GFX/PipelineObjects/Viewport.hpp"
 
 #include <d3d11.h>
 #include "GFX/Core/Namespaces.hpp"
@@ -33,12 +31,6 @@ struct PEFaceColorData {
     gfx::GFXColor faceColors[6];
 };
 
-class PETopology : public gfx::po::Topology {
-public:
-    PETopology()
-        : gfx::po::Topology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST) {}
-};
-
 class PETransformCBuf : public gfx::po::VSCBuffer<dx::XMMATRIX>{
 public:
     PETransformCBuf() = default;
@@ -72,29 +64,14 @@ private:
     static std::vector<gfx::GFXColor> makeRandom(std::size_t size);
 };
 
-class PEViewport : public gfx::po::Viewport {
-public:
-    PEViewport(const Win32::Client& client)
-        : Viewport( D3D11_VIEWPORT{
-            .TopLeftX = 0.f,
-            .TopLeftY = 0.f,
-            .Width = static_cast<FLOAT>(client.width),
-            .Height = static_cast<FLOAT>(client.height),
-            .MinDepth = 0.f,
-            .MaxDepth = 1.f
-        }) {}
-};
-
 template < class T, class PosBufferT, class IndexBufferT >
 class PEDrawComponent : public gfx::scenery::RCDrawCmp {
 public:
     struct {} tagPosBuffer;
     struct {} tagIndexBuffer;
-    struct {} tagTopology;
     struct {} tagTransformCBuf;
     struct {} tagIndexedColorCBuf;
     struct {} tagBlendedColorBuffer;
-    struct {} tagViewport;
 
     using MyType = gfx::scenery::DrawComponent<T>;
     using MyVertex = gfx::GFXVertex;
@@ -103,24 +80,23 @@ public:
     using MyConstantBufferColor = PEFaceColorData;
     using MyPosBuffer = PosBufferT;
     using MyIndexBuffer = IndexBufferT;
-    using MyTopology = PETopology;
     using MyTransformCBuf = PETransformCBuf;
     using MyIndexedColorCBuf = PEIndexedColorCBuf;
     using MyBlendedColorBuffer = PEColorBuffer;
-    using MyViewport = PEViewport;
     using MyDrawCaller = gfx::po::DrawCallerIndexed;
 
     PEDrawComponent( gfx::GFXFactory factory, gfx::GFXPipeline pipeline,
-        gfx::GFXStorage& storage, const ChiliWindow& wnd
+        gfx::GFXStorage& storage, const ChiliWindow&
     ) : transformGPUMapper_(storage),
-        transformApplyer_(transformGPUMapper_),
     #ifdef ACTIVATE_DRAWCOMPONENT_LOG
         logComponent_(this),
     #endif
-        posBuffer_( gfx::GFXRes::makeLoaded<MyPosBuffer>(storage, factory) ),
-        indexBuffer_( gfx::GFXRes::makeLoaded<MyIndexBuffer>(storage, factory) ),
-        topology_( gfx::GFXRes::makeCached<MyTopology>(storage, tagTopology) ),
-        viewport_( gfx::GFXRes::makeCached<MyViewport>(storage, tagViewport, wnd.client()) ),
+        posBuffer_( gfx::GFXRes::makeShared<MyPosBuffer>( storage,
+            gfx::GFXContentKey::make<MyPosBuffer>(), factory
+        ) ),
+        indexBuffer_( gfx::GFXRes::makeShared<MyIndexBuffer>( storage,
+            gfx::GFXContentKey::make<MyIndexBuffer>(), factory
+        ) ),
         transformCBuf_( gfx::GFXRes::makeCached<MyTransformCBuf>(storage, tagTransformCBuf, factory) ),
         indexedColorCBuf_( gfx::GFXRes::makeCached<MyIndexedColorCBuf>(storage, tagIndexedColorCBuf, factory) ),
         blendedColorBuffer_( gfx::GFXRes::makeLoaded<MyBlendedColorBuffer>(
@@ -128,13 +104,10 @@ public:
         ) ),
         pipeline_(pipeline), pStorage_(&storage) {
 
-        transformGPUMapper_.setTCBufID(transformCBuf_.id());
-
         this->setDrawCaller( std::make_unique<MyDrawCaller>(
             static_cast<UINT>( MyIndexBuffer::size() ), 0u, 0
         ) );
 
-        this->drawCaller().addDrawContext(&transformApplyer_);
         this->drawCaller().addDrawContext(&transformGPUMapper_);
     #ifdef ACTIVATE_DRAWCOMPONENT_LOG
         logComponent_.entryStackPop();
@@ -144,37 +117,33 @@ public:
 
     template <class ... TesselationFactors>
     PEDrawComponent( gfx::GFXFactory factory, gfx::GFXPipeline pipeline,
-        gfx::GFXStorage& storage, const ChiliWindow& wnd,
+        gfx::GFXStorage& storage, const ChiliWindow&,
         TesselationFactors&& ... tesselationFactors
     ) : transformGPUMapper_(storage),
-        transformApplyer_(transformGPUMapper_),
     #ifdef ACTIVATE_DRAWCOMPONENT_LOG
         logComponent_(this),
     #endif
-        posBuffer_( gfx::GFXRes::makeLoaded<MyPosBuffer>( storage, factory,
-            std::forward<TesselationFactors>(tesselationFactors)...
+        // geometry depends only on the tesselation factors,
+        // so entities with equal factors share one vertex/index buffer.
+        posBuffer_( gfx::GFXRes::makeShared<MyPosBuffer>( storage,
+            gfx::GFXContentKey::make<MyPosBuffer>(tesselationFactors...),
+            factory, tesselationFactors...
         ) ),
-        indexBuffer_( gfx::GFXRes::makeLoaded<MyIndexBuffer>( storage, factory,
-            std::forward<TesselationFactors>(tesselationFactors)...
+        indexBuffer_( gfx::GFXRes::makeShared<MyIndexBuffer>( storage,
+            gfx::GFXContentKey::make<MyIndexBuffer>(tesselationFactors...),
+            factory, tesselationFactors...
+        ) ),
+        transformCBuf_( gfx::GFXRes::makeCached<MyTransformCBuf>( storage, tagTransformCBuf, factory ) ),
+        indexedColorCBuf_( gfx::GFXRes::makeCached<MyIndexedColorCBuf>( storage, tagIndexedColorCBuf, factory ) ),
+        blendedColorBuffer_( gfx::GFXRes::makeLoaded<MyBlendedColorBuffer>( storage, factory,
+            MyPosBuffer::size(tesselationFactors...)
         ) ),
-        topology_( gfx::GFXRes::makeCached( storage, tagTopology ) ),
-        viewport_( gfx::GFXRes::makeCached( storage, tagViewport, wnd.client() ) ),
-        transformCBuf_( gfx::GFXRes::makeCached( storage, tagTransformCBuf, factory ) ),
-        indexedColorCBuf_( gfx::GFXRes::makeCached( storage, tagIndexedColorCBuf, factory ) ),
-        blendedColorBuffer_( gfx::GFXRes::makeLoaded(storage, factory, MyPosBuffer::size(
-            std::forward<TesselationFactors>(tesselationFactors)...
-        ) ) ),
         pipeline_(pipeline), pStorage_(&storage) {
 
-        transformGPUMapper_.setTCBufID(transformCBuf_.id());
-
         this->setDrawCaller( std::make_unique<MyDrawCaller>(
-            static_cast<UINT>( MyIndexBuffer::size(
-                std::forward<TesselationFactors>(tesselationFactors)...
-            ) ), 0u, 0
+            static_cast<UINT>( MyIndexBuffer::size(tesselationFactors...) ), 0u, 0
         ) );
 
-        this->drawCaller().addDrawContext(&transformApplyer_);
         this->drawCaller().addDrawContext(&transformGPUMapper_);
     #ifdef ACTIVATE_DRAWCOMPONENT_LOG
         logComponent_.entryStackPop();
@@ -200,67 +169,67 @@ public:
     
     void sync(const gfx::scenery::IndexedRenderer& renderer) {
         assert(posBuffer_.valid());
-        static_cast<MyPosBuffer*>( posBuffer_.get() )
-            ->setSlot( gfx::scenery::IndexedRenderer::slotPosBuffer() );
+        posBuffer_.as<MyPosBuffer>().setSlot(
+            gfx::scenery::IndexedRenderer::slotPosBuffer()
+        );
 
         assert(transformCBuf_.valid());
-        static_cast<MyTransformCBuf*>( transformCBuf_.get() )
-            ->setSlot( 0u );
+        transformCBuf_.as<MyTransformCBuf>().setSlot(
+            gfx::scenery::IndexedRenderer::slotObjectCBuffer()
+        );
+        transformGPUMapper_.setTCBufID( transformCBuf_.id() );
 
         this->setRODesc( gfx::scenery::RenderObjectDesc{
             .header = {
                 .IDBuffer = posBuffer_.id(),
-                .IDType = typeid(T)
+                .IDType = typeid(T),
+                .denseType = gfx::scenery::denseTypeIndex<T>()
             },
             .IDs = {
-                posBuffer_.id(), indexBuffer_.id(), topology_.id(),
-                viewport_.id(), transformCBuf_.id(), indexedColorCBuf_.id()
+                posBuffer_.id(), indexBuffer_.id(), indexedColorCBuf_.id()
             }
         } );
     }
 
     void sync(const gfx::scenery::BlendedRenderer& renderer) {
         assert(posBuffer_.valid());
-        static_cast<MyPosBuffer*>( posBuffer_.get() )
-            ->setSlot( gfx::scenery::BlendedRenderer::slotPosBuffer() );
-            
+        posBuffer_.as<MyPosBuffer>().setSlot(
+            gfx::scenery::BlendedRenderer::slotPosBuffer()
+        );
+
         assert(blendedColorBuffer_.valid());
-        static_cast<MyBlendedColorBuffer*>(
-            blendedColorBuffer_.get()
-        )->setSlot( gfx::scenery::BlendedRenderer::slotColorBuffer() );
+        blendedColorBuffer_.as<MyBlendedColorBuffer>().setSlot(
+            gfx::scenery::BlendedRenderer::slotColorBuffer()
+        );
 
         assert(transformCBuf_.valid());
-        static_cast<MyTransformCBuf*>( transformCBuf_.get() )
-            ->setSlot( 0u );
+        transformCBuf_.as<MyTransformCBuf>().setSlot(
+            gfx::scenery::BlendedRenderer::slotObjectCBuffer()
+        );
+        transformGPUMapper_.setTCBufID( transformCBuf_.id() );
 
         this->setRODesc( gfx::scenery::RenderObjectDesc{
             .header = {
                 .IDBuffer = posBuffer_.id(),
-                .IDType = typeid(T)
+                .IDType = typeid(T),
+                .denseType = gfx::scenery::denseTypeIndex<T>()
             },
             .IDs = {
-                posBuffer_.id(), blendedColorBuffer_.id(), indexBuffer_.id(), topology_.id(),
-                viewport_.id(), transformCBuf_.id()
+                posBuffer_.id(), blendedColorBuffer_.id(), indexBuffer_.id()
             }
         } );
     }
 
-    void sync(const gfx::scenery::CameraVision& vision) {
-        transformApplyer_.setTransform(
-            vision.viewTrans() * vision.projTrans()
-        );
-    }
+    // the camera's transform is bound by the renderer once per frame.
+    void sync(const gfx::scenery::CameraVision&) {}
 
 private:
     gfx::scenery::MapTransformGPU transformGPUMapper_;
-    gfx::scenery::ApplyTransform transformApplyer_;
 #ifdef ACTIVATE_DRAWCOMPONENT_LOG
     gfx::scenery::RCDrawCmp::LogComponent logComponent_;
 #endif
     gfx::GFXRes posBuffer_;
     gfx::GFXRes indexBuffer_;
-    gfx::GFXRes topology_;
-    gfx::GFXRes viewport_;
     gfx::GFXRes transformCBuf_;
     gfx::GFXRes indexedColorCBuf_;
     gfx::GFXRes blendedColorBuffer_;
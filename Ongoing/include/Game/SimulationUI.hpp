@@ -1,21 +1,43 @@
 #ifndef __SimulationUI
 #define __SimulationUI
 
+#include "GFX/Scenery/LOD.hpp"
+
+#include <optional>
+#include <cstddef>
+
 class SimulationUI {
 public:
     SimulationUI()
-        : speedFactor_(1.f), buffer_{0}, willShow_(true) {}
+        : speedFactor_(1.f), buffer_{0}, willShow_(true), picked_(),
+        nOccludedDraws_(0u), lodStats_() {}
 
     void render();
 
     float speedFactor() const noexcept {
         return speedFactor_;
     }
+
+    // distance to the object picked last, none if missed.
+    void setPicked(std::optional<float> distance) noexcept {
+        picked_ = distance;
+    }
+
+    void setOccludedDraws(std::size_t n) noexcept {
+        nOccludedDraws_ = n;
+    }
+
+    void setLODStats(const gfx::scenery::LODStats& stats) noexcept {
+        lodStats_ = stats;
+    }
 private:
     float speedFactor_;
     bool willShow_;
 
     char buffer_[1024];  // temporary
+    std::optional<float> picked_;
+    std::size_t nOccludedDraws_;
+    gfx::scenery::LODStats lodStats_;
 };
 
 #endif  // __SimulationUI
\ No newline at end of file
@@ -1,12 +1,13 @@
-// separte cbuffers temporarily.
-// integrate them later when the Transform Constant Buffer class is well defined.
+// camera transforms are mapped once per frame,
+// each draw only maps its world transform.
 
-cbuffer TransCBuf1 {
-    matrix worldView;
+cbuffer Camera {
+    matrix view;
+    matrix viewProj;
 };
 
-cbuffer TransCBuf2 {
-    matrix worldViewProj;
+cbuffer Object {
+    matrix world;
 };
 
 struct VSOut {
@@ -17,9 +18,12 @@ struct VSOut {
 
 VSOut main( float3 pos : Position, float3 n : Normal )
 {
+    const float4 worldPos = mul( float4(pos, 1.0f), world );
+
+    // lit in view space.
     VSOut vso;
-    vso.worldPos = (float3)mul( float4(pos, 1.0f), worldView );
-    vso.normal = mul( n, (float3x3)worldView );
-    vso.pos = mul( float4(pos, 1.0f), worldViewProj );
+    vso.worldPos = (float3)mul( worldPos, view );
+    vso.normal = mul( mul( n, (float3x3)world ), (float3x3)view );
+    vso.pos = mul( worldPos, viewProj );
     return vso;
 }
\ No newline at end of file
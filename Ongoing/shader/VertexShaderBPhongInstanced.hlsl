@@ -0,0 +1,28 @@
+// VertexShaderBPhong.hlsl with world transforms read per instance,
+// so objects sharing geometry are drawn by one draw call.
+
+cbuffer Camera {
+    matrix view;
+    matrix viewProj;
+};
+
+struct VSOut {
+    float3 worldPos : Position;
+    float3 normal : Normal;
+    float4 pos : SV_Position;
+};
+
+VSOut main( float3 pos : Position, float3 n : Normal,
+    float4 w0 : World0, float4 w1 : World1,
+    float4 w2 : World2, float4 w3 : World3 )
+{
+    const matrix world = float4x4(w0, w1, w2, w3);
+    const float4 worldPos = mul( float4(pos, 1.0f), world );
+
+    // lit in view space.
+    VSOut vso;
+    vso.worldPos = (float3)mul( worldPos, view );
+    vso.normal = mul( mul( n, (float3x3)world ), (float3x3)view );
+    vso.pos = mul( worldPos, viewProj );
+    return vso;
+}
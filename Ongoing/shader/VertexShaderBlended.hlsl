@@ -1,5 +1,12 @@
-cbuffer CBuf {
-    matrix transform;
+// the camera's transform is mapped once per frame,
+// each draw only maps its world transform.
+
+cbuffer Camera {
+    matrix viewProj;
+};
+
+cbuffer Object {
+    matrix world;
 };
 
 struct VSOut {
@@ -9,7 +16,7 @@ struct VSOut {
 
 VSOut main( float3 pos : Position, float4 color : Color ) {
     VSOut vso;
-    vso.pos = mul(float4(pos, 1.f), transform);
+    vso.pos = mul( mul(float4(pos, 1.f), world), viewProj );
     vso.color = color;
     return vso;
 }
\ No newline at end of file
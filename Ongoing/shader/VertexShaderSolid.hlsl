@@ -1,7 +1,14 @@
-cbuffer CBuf {
-    matrix transform;
+// the camera's transform is mapped once per frame,
+// each draw only maps its world transform.
+
+cbuffer Camera {
+    matrix viewProj;
+};
+
+cbuffer Object {
+    matrix world;
 };
 
 float4 main(float3 pos : Position) : SV_Position {
-    return mul(float4(pos, 1.f), transform);
+    return mul( mul(float4(pos, 1.f), world), viewProj );
 }
\ No newline at end of file
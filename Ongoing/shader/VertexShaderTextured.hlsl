@@ -1,5 +1,12 @@
-cbuffer CBuf {
-    matrix transform;
+// the camera's transform is mapped once per frame,
+// each draw only maps its world transform.
+
+cbuffer Camera {
+    matrix viewProj;
+};
+
+cbuffer Object {
+    matrix world;
 };
 
 struct VSOut {
@@ -9,7 +16,7 @@ struct VSOut {
 
 VSOut main( float3 pos : Position, float2 tex : TexCoord ) {
     VSOut vso;
-    vso.pos = mul( float4(pos, 1.0f), transform );
+    vso.pos = mul( mul( float4(pos, 1.0f), world ), viewProj );
     vso.tex = tex;
 
     return vso;
@@ -0,0 +1,69 @@
+#include "GFX/Core/CommandBuffer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+namespace gfx {
+
+void GFXCommandBuffer::replay(IGFXCommandBackend& backend) const {
+    for (const auto& command : commands_) {
+        const auto payload = std::span( payload_ )
+            .subspan(command.payloadOffset, command.payloadSize);
+
+        switch (command.type) {
+        case GFXCommandType::Bind:
+            backend.bind(command.id);
+            break;
+        case GFXCommandType::Draw:
+            backend.draw(*command.pDrawCaller);
+            break;
+        case GFXCommandType::DrawInstanced:
+            backend.drawInstanced( *command.pDrawCaller,
+                command.nInstance, payload
+            );
+            break;
+        }
+    }
+}
+
+std::uint32_t GFXCommandBuffer::store(std::span<const std::byte> bytes) {
+    const auto offset = (payload_.size() + payloadAlign - 1u)
+        / payloadAlign * payloadAlign;
+
+    if ( offset + bytes.size() > std::numeric_limits<std::uint32_t>::max() ) {
+        throw std::length_error("GFXCommandBuffer payload exceeded 4GiB.");
+    }
+
+    payload_.resize( offset + bytes.size() );
+    std::ranges::copy( bytes, payload_.begin() + offset );
+
+    return static_cast<std::uint32_t>(offset);
+}
+
+void GFXRecordingBackend::bind(SlotMapKey id) {
+    entries_.push_back( Entry{
+        .type = GFXCommandType::Bind,
+        .id = id
+    } );
+}
+
+void GFXRecordingBackend::draw(const po::BasicDrawCaller& drawCaller) {
+    entries_.push_back( Entry{
+        .type = GFXCommandType::Draw,
+        .pDrawCaller = &drawCaller
+    } );
+}
+
+void GFXRecordingBackend::drawInstanced( const po::BasicDrawCaller& drawCaller,
+    std::uint32_t nInstance, std::span<const std::byte> instances
+) {
+    entries_.push_back( Entry{
+        .type = GFXCommandType::DrawInstanced,
+        .pDrawCaller = &drawCaller,
+        .nInstance = nInstance,
+        .bytes = { instances.begin(), instances.end() }
+    } );
+}
+
+}   // namespace gfx
@@ -1,4 +1,5 @@
 #include "GFX/Core/Graphics.hpp"
+#include "GFX/Core/UploadRing.hpp"
 
 #include "GFX/PipelineObjects/RenderTarget.hpp"
 
@@ -83,6 +84,10 @@ void Graphics::initGFXComponents() {
         /* pFeatureLevel = */ nullptr,
         /* ppImmediateContext = */ &pipeline_
     ));
+
+    if ( GFXUploadRing::supported(factory_) ) {
+        pipeline_.setUploadRing( std::make_shared<GFXUploadRing>(factory_) );
+    }
 }
 
 void Graphics::constructAppRenderTarget() {
@@ -0,0 +1,394 @@
+#include "GFX/Core/PayloadCache.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace gfx {
+
+namespace {
+
+// file layout:
+// Header | Record[nRecords] | type names | payloads,
+// each payload aligned to payloadAlign.
+// the records checksum covers the records and the type names.
+constexpr auto magic = std::array<char, 4>{ 'G', 'F', 'X', 'P' };
+constexpr std::size_t payloadAlign = 16u;
+
+struct Header {
+    std::array<char, 4> magic;
+    std::uint32_t version;
+    std::uint32_t nRecords;
+    std::uint32_t nameBytes;
+    std::uint64_t recordsChecksum;
+};
+
+struct Record {
+    std::uint64_t hash;
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint32_t elemSize;
+    std::uint32_t nParams;
+    std::array<std::uint64_t, GFXContentKey::maxParams> params;
+    std::uint32_t nameOffset;   // into the type names
+    std::uint32_t nameSize;
+    std::uint64_t checksum;
+};
+
+constexpr auto checksumBasis = 0xcbf29ce484222325ull;
+
+// continues from the given checksum, to cover separate spans as one.
+std::uint64_t checksum( std::span<const std::byte> bytes,
+    std::uint64_t ret = checksumBasis
+) noexcept {
+    // FNV-1a
+    for (auto b : bytes) {
+        ret = ( ret ^ static_cast<std::uint64_t>(b) ) * 0x100000001b3ull;
+    }
+    return ret;
+}
+
+constexpr std::uint64_t alignUp(std::uint64_t val) noexcept {
+    return (val + payloadAlign - 1u) / payloadAlign * payloadAlign;
+}
+
+}   // anonymous namespace
+
+GFXPayloadCache::GFXPayloadCache()
+    : path_(), entries_(), mutex_(), hFile_(nullptr),
+    hMapping_(nullptr), view_(nullptr), viewSize_(0u), bDirty_(false),
+    nHit_(0u), nMiss_(0u) {}
+
+GFXPayloadCache::~GFXPayloadCache() {
+    unmap();
+}
+
+void GFXPayloadCache::open(const std::filesystem::path& path) {
+    std::lock_guard lock(mutex_);
+
+    entries_.clear();
+    unmap();
+    path_ = path;
+    bDirty_ = false;
+
+    if ( !map(path) || !validate() ) {
+        // stale or corrupted, fall back to regeneration.
+        entries_.clear();
+        unmap();
+        bDirty_ = true;
+    }
+}
+
+bool GFXPayloadCache::save() {
+    std::lock_guard lock(mutex_);
+
+    if ( !bDirty_ || path_.empty() ) {
+        return true;
+    }
+
+    auto records = std::vector<Record>();
+    records.reserve( entries_.size() );
+    auto names = std::string();
+
+    for (const auto& [hash, entry] : entries_) {
+        records.push_back( Record{
+            .hash = hash,
+            .offset = 0u,
+            .size = entry.bytes.size(),
+            .elemSize = entry.elemSize,
+            .nParams = entry.nParams,
+            .params = entry.params,
+            .nameOffset = static_cast<std::uint32_t>( names.size() ),
+            .nameSize = static_cast<std::uint32_t>( entry.typeName.size() ),
+            .checksum = checksum(entry.bytes)
+        } );
+        names += entry.typeName;
+    }
+
+    auto offset = alignUp( sizeof(Header)
+        + records.size() * sizeof(Record) + names.size()
+    );
+    for (auto& record : records) {
+        record.offset = offset;
+        offset = alignUp( offset + record.size );
+    }
+
+    const auto header = Header{
+        .magic = magic,
+        .version = formatVersion,
+        .nRecords = static_cast<std::uint32_t>( records.size() ),
+        .nameBytes = static_cast<std::uint32_t>( names.size() ),
+        .recordsChecksum = checksum( std::as_bytes( std::span(names) ),
+            checksum( std::as_bytes( std::span(records) ) )
+        )
+    };
+
+    // the mapped file can't be replaced in place,
+    // so write next to it and swap afterwards.
+    auto tmpPath = path_;
+    tmpPath += ".tmp";
+
+    {
+        auto out = std::ofstream(tmpPath, std::ios::binary | std::ios::trunc);
+        const auto pad = [&out]() {
+            static constexpr auto zeros = std::array<char, payloadAlign>{};
+            const auto pos = static_cast<std::uint64_t>( out.tellp() );
+            out.write( zeros.data(), alignUp(pos) - pos );
+        };
+
+        out.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+        out.write( reinterpret_cast<const char*>( records.data() ),
+            records.size() * sizeof(Record)
+        );
+        out.write( names.data(), names.size() );
+        pad();
+
+        // records were laid out in the iteration order of entries_.
+        for (const auto& [hash, entry] : entries_) {
+            out.write( reinterpret_cast<const char*>( entry.bytes.data() ),
+                entry.bytes.size()
+            );
+            pad();
+        }
+
+        if (!out) {
+            return false;
+        }
+    }
+
+    entries_.clear();
+    unmap();
+
+    auto ec = std::error_code();
+    std::filesystem::rename(tmpPath, path_, ec);
+
+    // remap what was just written, so the generated copies are released.
+    bDirty_ = ec || !map(path_) || !validate();
+    if (bDirty_) {
+        entries_.clear();
+        unmap();
+    }
+
+    return !ec;
+}
+
+std::optional< std::span<const std::byte> > GFXPayloadCache::find(
+    const GFXContentKey& key, std::size_t elemSize
+) {
+    std::lock_guard lock(mutex_);
+
+    auto pEntry = search( key.stableHash(), key, elemSize );
+    if (!pEntry) {
+        nMiss_.fetch_add(1u, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    nHit_.fetch_add(1u, std::memory_order_relaxed);
+    return pEntry->bytes;
+}
+
+std::span<const std::byte> GFXPayloadCache::insert( const GFXContentKey& key,
+    std::size_t elemSize, std::span<const std::byte> bytes
+) {
+    std::lock_guard lock(mutex_);
+
+    // another thread may have generated the same payload meanwhile,
+    // its span must stay valid.
+    const auto hash = key.stableHash();
+    if ( auto pEntry = search(hash, key, elemSize) ) {
+        return pEntry->bytes;
+    }
+
+    auto entry = Entry{
+        .typeName = std::string( key.typeName() ),
+        .nParams = static_cast<std::uint32_t>( key.params().size() ),
+        .elemSize = static_cast<std::uint32_t>(elemSize),
+        .owned = std::vector<std::byte>( bytes.begin(), bytes.end() )
+    };
+    std::ranges::copy( key.params(), entry.params.begin() );
+
+    auto& inserted = entries_.emplace( hash, std::move(entry) )->second;
+    inserted.bytes = inserted.owned;
+    bDirty_ = true;
+
+    return inserted.bytes;
+}
+
+GFXPayloadCache::Entry* GFXPayloadCache::search( std::uint64_t hash,
+    const GFXContentKey& key, std::size_t elemSize
+) noexcept {
+    auto [first, last] = entries_.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        if ( it->second.matches(key, elemSize) ) {
+            return &it->second;
+        }
+    }
+    return nullptr;
+}
+
+#ifdef _WIN32
+bool GFXPayloadCache::map(const std::filesystem::path& path) {
+    hFile_ = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (hFile_ == INVALID_HANDLE_VALUE) {
+        hFile_ = nullptr;
+        return false;
+    }
+
+    auto size = LARGE_INTEGER{};
+    if ( !GetFileSizeEx(hFile_, &size) || size.QuadPart == 0 ) {
+        return false;
+    }
+    viewSize_ = static_cast<std::size_t>(size.QuadPart);
+
+    hMapping_ = CreateFileMappingW( hFile_, nullptr, PAGE_READONLY,
+        0u, 0u, nullptr
+    );
+    if (!hMapping_) {
+        return false;
+    }
+
+    view_ = static_cast<const std::byte*>(
+        MapViewOfFile(hMapping_, FILE_MAP_READ, 0u, 0u, 0u)
+    );
+
+    return view_ != nullptr;
+}
+
+void GFXPayloadCache::unmap() noexcept {
+    if (view_) {
+        UnmapViewOfFile(view_);
+        view_ = nullptr;
+    }
+    if (hMapping_) {
+        CloseHandle(hMapping_);
+        hMapping_ = nullptr;
+    }
+    if (hFile_) {
+        CloseHandle(hFile_);
+        hFile_ = nullptr;
+    }
+    viewSize_ = 0u;
+}
+#else
+// the mapping outlives the descriptor, so no handle is kept.
+bool GFXPayloadCache::map(const std::filesystem::path& path) {
+    const auto fd = ::open( path.c_str(), O_RDONLY );
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat status = {};
+    if ( ::fstat(fd, &status) == 0 && status.st_size > 0 ) {
+        const auto size = static_cast<std::size_t>(status.st_size);
+        const auto view = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if (view != MAP_FAILED) {
+            view_ = static_cast<const std::byte*>(view);
+            viewSize_ = size;
+        }
+    }
+
+    ::close(fd);
+    return view_ != nullptr;
+}
+
+void GFXPayloadCache::unmap() noexcept {
+    if (view_) {
+        ::munmap( const_cast<std::byte*>(view_), viewSize_ );
+        view_ = nullptr;
+    }
+    viewSize_ = 0u;
+}
+#endif
+
+bool GFXPayloadCache::validate() {
+    auto header = Header{};
+    if ( viewSize_ < sizeof(header) ) {
+        return false;
+    }
+    std::copy_n( view_, sizeof(header), reinterpret_cast<std::byte*>(&header) );
+
+    if ( header.magic != magic || header.version != formatVersion
+        || ( viewSize_ - sizeof(header) ) / sizeof(Record) < header.nRecords
+        || viewSize_ - sizeof(header) - header.nRecords * sizeof(Record)
+            < header.nameBytes
+    ) {
+        return false;
+    }
+
+    auto records = std::vector<Record>(header.nRecords);
+    const auto recordBytes = std::span( view_ + sizeof(header),
+        records.size() * sizeof(Record)
+    );
+    std::ranges::copy( recordBytes,
+        reinterpret_cast<std::byte*>( records.data() )
+    );
+    const auto names = std::string_view(
+        reinterpret_cast<const char*>( recordBytes.data() + recordBytes.size() ),
+        header.nameBytes
+    );
+
+    if ( checksum( std::as_bytes( std::span(names) ), checksum(recordBytes) )
+        != header.recordsChecksum
+    ) {
+        return false;
+    }
+
+    for (const auto& record : records) {
+        if ( record.offset > viewSize_ || record.size > viewSize_ - record.offset
+            || record.elemSize == 0u || record.size % record.elemSize != 0u
+            || record.nParams > GFXContentKey::maxParams
+            || record.nameOffset > names.size()
+            || record.nameSize > names.size() - record.nameOffset
+        ) {
+            return false;
+        }
+
+        const auto bytes = std::span( view_ + record.offset,
+            static_cast<std::size_t>(record.size)
+        );
+
+        // a corrupted payload is regenerated, the others are kept.
+        if ( checksum(bytes) != record.checksum ) {
+            bDirty_ = true;
+            continue;
+        }
+
+        entries_.emplace( record.hash, Entry{
+            .typeName = std::string(
+                names.substr(record.nameOffset, record.nameSize)
+            ),
+            .params = record.params,
+            .nParams = record.nParams,
+            .elemSize = record.elemSize,
+            .bytes = bytes
+        } );
+    }
+
+    return true;
+}
+
+GFXPayloadCache& getGFXPayloadCache() {
+    static auto inst = std::optional<GFXPayloadCache>();
+
+    if (!inst.has_value()) {
+        inst.emplace();
+    }
+
+    return inst.value();
+}
+
+}   // namespace gfx
@@ -5,12 +5,14 @@ namespace gfx {
 std::optional<GFXRes::Dummy> GFXRes::nullTag;
 
 GFXRes::GFXRes(GFXRes&& other) noexcept
-    : gen_(std::move(other.gen_)),
+    : factory_(std::move(other.factory_)),
     stored_(std::move(other.stored_)),
-    genMode_(other.genMode_) {
+    genMode_(other.genMode_),
+    pStorage_(other.pStorage_) {
     // https://en.cppreference.com/w/cpp/utility/optional/operator%3D
     // moved-from optional doesn't be reset.
     other.stored_.reset();
+    adopt();
 }
 
 GFXRes& GFXRes::operator=(GFXRes&& other) noexcept {
@@ -20,14 +22,231 @@ GFXRes& GFXRes::operator=(GFXRes&& other) noexcept {
 
     destroy();
 
-    gen_ = std::move(other.gen_);
+    factory_ = std::move(other.factory_);
     stored_ = std::move(other.stored_);
     // https://en.cppreference.com/w/cpp/utility/optional/operator%3D
     // moved-from optional doesn't be reset.
     other.stored_.reset();
     genMode_ = other.genMode_;
+    pStorage_ = other.pStorage_;
+    adopt();
 
     return *this;
 }
 
-}   // namespace gfx
\ No newline at end of file
+void GFXRes::destroy() {
+    if ( !stored_.has_value() ) {
+        return;
+    }
+
+    switch (genMode_) {
+    case GenMode::StandAlone:
+        delete stored_.value().bindee;
+        break;
+
+    case GenMode::Load:
+        // unloading invalidates this through the owner link.
+        assert(pStorage_);
+        pStorage_->unload(stored_.value().id);
+        break;
+
+    default:
+        break;
+    }
+
+    stored_.reset();
+}
+
+void GFXRes::pin() {
+    if (pStorage_) {
+        pStorage_->pin( id() );
+    }
+}
+
+void GFXRes::unpin() {
+    if (pStorage_) {
+        pStorage_->unpin( id() );
+    }
+}
+
+void GFXRes::reconstruct() const {
+    stored_ = factory_();
+    adopt();
+
+    if (pStorage_) {
+        pStorage_->nReconstruct_.fetch_add(1u, std::memory_order_relaxed);
+    }
+}
+
+void GFXRes::adopt() const {
+    if ( genMode_ == GenMode::Load && pStorage_ && stored_.has_value() ) {
+        pStorage_->adopt(stored_.value().id, this);
+    }
+}
+
+void GFXStorage::syncAsync() {
+    auto ready = std::vector< std::unique_ptr<detail::GFXPendingLoadBase> >();
+
+    {
+        std::lock_guard lock(mutex_);
+        // loads still running are packed to the front, in order.
+        auto kept = pending_.begin();
+        for (auto& pending : pending_) {
+            if ( pending->ready() ) {
+                ready.push_back( std::move(pending) );
+            }
+            else {
+                *kept++ = std::move(pending);
+            }
+        }
+        pending_.erase( kept, pending_.end() );
+    }
+
+    for (auto& pending : ready) {
+        pending->finalize(*this);
+    }
+}
+
+void GFXStorage::waitAsync() {
+    auto waiting = std::vector< std::unique_ptr<detail::GFXPendingLoadBase> >();
+
+    // loads queued meanwhile are taken by the next round.
+    for (;;) {
+        {
+            std::lock_guard lock(mutex_);
+            if ( pending_.empty() ) {
+                return;
+            }
+            waiting.swap(pending_);
+        }
+
+        // waits unlocked, so other threads keep loading meanwhile.
+        for (std::size_t i = 0u; i < waiting.size(); ++i) {
+            try {
+                waiting[i]->wait();
+                waiting[i]->finalize(*this);
+            }
+            catch (...) {
+                // loads after the failed one are kept for the next wait.
+                std::lock_guard lock(mutex_);
+                pending_.insert( pending_.begin(),
+                    std::make_move_iterator( waiting.begin() + i + 1u ),
+                    std::make_move_iterator( waiting.end() )
+                );
+                throw;
+            }
+        }
+
+        waiting.clear();
+    }
+}
+
+bool GFXStorage::unloadUnlocked(const ID& id) {
+    auto pManaged = resources_.find(id);
+    if (!pManaged) {
+        return false;
+    }
+
+    usage_.fetch_sub( pManaged->footprint(), std::memory_order_relaxed );
+    account( *pManaged->get(), pManaged->footprint(), false );
+    readTable_.retract(id);
+
+    // readers of this frame may still hold the bindee,
+    // it is released on the next advanceFrame.
+    auto retired = std::move(*pManaged);
+    retired.retire();
+    resources_.erase(id);
+    retired_.push_back( std::move(retired) );
+
+    return true;
+}
+
+void GFXStorage::advanceFrame() {
+    std::lock_guard lock(mutex_);
+
+    {
+        // releasing may reenter unload and retire more,
+        // those wait for the next frame.
+        auto retired = std::move(retired_);
+        retired_.clear();
+    }
+
+    const auto closed = frame_.fetch_add(1u, std::memory_order_relaxed);
+
+    if ( budget_.has_value() && usage() > budget_.value() ) [[unlikely]] {
+        evict(closed);
+    }
+
+    frameCounters_ = GFXStorageCounters{
+        .nHit = nHit_.exchange(0u, std::memory_order_relaxed),
+        .nMiss = nMiss_.exchange(0u, std::memory_order_relaxed),
+        .nLoad = nLoad_.exchange(0u, std::memory_order_relaxed),
+        .nReconstruct = nReconstruct_.exchange(0u, std::memory_order_relaxed),
+        .nEvict = nEvict_.exchange(0u, std::memory_order_relaxed)
+    };
+    totalCounters_ += frameCounters_;
+}
+
+void GFXStorage::evict(std::uint64_t closed) {
+    evictCandidates_.clear();
+    for (std::size_t i = 0u; i < resources_.size(); ++i) {
+        const auto& managed = *(resources_.begin() + i);
+        const auto id = resources_.keyAt(i);
+        const auto lastUsed = readTable_.lastUsed(id.index);
+
+        if ( !managed.pinned() && lastUsed < closed ) {
+            evictCandidates_.emplace_back(lastUsed, id);
+        }
+    }
+
+    std::ranges::sort( evictCandidates_, std::less<>{},
+        &std::pair<std::uint64_t, ID>::first
+    );
+
+    for (const auto& [_, id] : evictCandidates_) {
+        if ( usage() <= budget_.value() ) {
+            break;
+        }
+        if ( unloadUnlocked(id) ) {
+            nEvict_.fetch_add(1u, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::vector< std::pair<std::type_index, GFXStorageFootprint> >
+    GFXStorage::typeFootprints() const {
+    auto ret = std::vector< std::pair<std::type_index, GFXStorageFootprint> >();
+
+    {
+        std::lock_guard lock(mutex_);
+        ret.assign( typeFootprints_.begin(), typeFootprints_.end() );
+    }
+
+    std::ranges::sort( ret, std::greater<>{},
+        [](const auto& elem) { return elem.second.bytes; }
+    );
+
+    return ret;
+}
+
+void GFXStorage::account( const po::IPipelineObject& bindee,
+    std::size_t footprint, bool bLoaded
+) {
+    const auto update = [footprint, bLoaded](GFXStorageFootprint& target) {
+        if (bLoaded) {
+            ++target.nResource;
+            target.bytes += footprint;
+        }
+        else {
+            --target.nResource;
+            target.bytes -= footprint;
+        }
+    };
+
+    update( typeFootprints_[ std::type_index( typeid(bindee) ) ] );
+    update( categoryFootprints_[
+        static_cast<std::size_t>( bindee.footprintCategory() )
+    ] );
+}
+
+}   // namespace gfx
@@ -0,0 +1,35 @@
+#include "GFX/Core/UploadQueue.hpp"
+
+#include "GFX/Core/Exception.hpp"
+
+namespace gfx {
+
+void GFXUploadQueue::flush(ID3D11DeviceContext* pContext) {
+    const auto write = [pContext]( const wrl::ComPtr<ID3D11Buffer>& pBuffer,
+        std::size_t offset, std::span<const std::byte> bytes
+    ) {
+        auto desc = D3D11_BUFFER_DESC{};
+        pBuffer->GetDesc(&desc);
+
+        // constant buffers only take whole writes, without a box.
+        const auto bWhole = offset == 0u && bytes.size() == desc.ByteWidth;
+        const auto box = D3D11_BOX{
+            .left = static_cast<UINT>(offset),
+            .top = 0u,
+            .front = 0u,
+            .right = static_cast<UINT>( offset + bytes.size() ),
+            .bottom = 1u,
+            .back = 1u
+        };
+
+        GFX_THROW_FAILED_VOID(
+            pContext->UpdateSubresource( pBuffer.Get(), 0u,
+                bWhole ? nullptr : &box, bytes.data(), 0u, 0u
+            )
+        );
+    };
+
+    GFXBasicUploadQueue::flush(write);
+}
+
+}   // namespace gfx
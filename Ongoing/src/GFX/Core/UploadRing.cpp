@@ -0,0 +1,153 @@
+#include "GFX/Core/UploadRing.hpp"
+
+#include "GFX/Core/Pipeline.hpp"
+#include "GFX/Core/Exception.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace gfx {
+
+namespace {
+
+D3D11_FEATURE_DATA_D3D11_OPTIONS featureOptions(GFXFactory factory) {
+    auto options = D3D11_FEATURE_DATA_D3D11_OPTIONS{};
+    if ( FAILED( factory.device()->CheckFeatureSupport(
+        D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options)
+    ) ) ) {
+        return D3D11_FEATURE_DATA_D3D11_OPTIONS{};
+    }
+    return options;
+}
+
+constexpr std::size_t constantSize = 16u;
+
+}   // namespace
+
+void GFXUploadRingBinder::doBind( GFXPipeline& pipeline, UINT slot,
+    ID3D11DeviceContext1* pContext, ID3D11Buffer* pBuffer,
+    UINT firstConstant, UINT nConstant
+) {
+    GFX_THROW_FAILED_VOID(
+        pContext->VSSetConstantBuffers1(
+            slot, 1u, &pBuffer, &firstConstant, &nConstant
+        )
+    );
+}
+
+bool GFXUploadRing::supported(GFXFactory factory) {
+    return featureOptions( std::move(factory) ).ConstantBufferOffsetting;
+}
+
+GFXUploadRing::GFXUploadRing(GFXFactory factory, std::size_t capacity)
+    : factory_( std::move(factory) ), pBuffer_(), pContext_(), binder_(),
+    capacity_(0u), head_(0u), base_(0u),
+    bNoOverwrite_( featureOptions(factory_).MapNoOverwriteOnDynamicConstantBuffer ),
+    bStaging_(false), stage_(), staged_(), nTaken_(0u), nMap_(0u) {
+    create(capacity);
+}
+
+void GFXUploadRing::beginStaging() {
+    stage_.clear();
+    staged_.clear();
+    nTaken_ = 0u;
+    bStaging_ = true;
+}
+
+void GFXUploadRing::stage(std::span<const std::byte> bytes) {
+    assert(bStaging_);
+
+    const auto offset = stage_.size();
+    const auto size = (bytes.size() + alignment - 1u) / alignment * alignment;
+    // the most a constant buffer binding spans.
+    assert( size <= D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * constantSize );
+
+    stage_.resize(offset + size);
+    std::ranges::copy( bytes, stage_.begin() + offset );
+    staged_.push_back( Staged{ .offset = offset, .size = size } );
+}
+
+void GFXUploadRing::upload(GFXPipeline& pipeline) {
+    bStaging_ = false;
+    nTaken_ = 0u;
+
+    if ( stage_.empty() ) {
+        return;
+    }
+
+    if (!pContext_) {
+        GFX_THROW_FAILED( pipeline.context().As(&pContext_) );
+    }
+
+    if ( stage_.size() > capacity_ ) [[unlikely]] {
+        create( std::bit_ceil( stage_.size() ) );
+    }
+
+    // wrapped around, or nothing written yet.
+    auto mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    if ( head_ == 0u || head_ + stage_.size() > capacity_ || !bNoOverwrite_ ) {
+        head_ = 0u;
+        mapType = D3D11_MAP_WRITE_DISCARD;
+    }
+
+    auto mapped = D3D11_MAPPED_SUBRESOURCE{};
+    GFX_THROW_FAILED(
+        pipeline.context()->Map( pBuffer_.Get(), 0u, mapType, 0u, &mapped )
+    );
+
+    std::ranges::copy( stage_, static_cast<std::byte*>(mapped.pData) + head_ );
+
+    GFX_THROW_FAILED_VOID(
+        pipeline.context()->Unmap( pBuffer_.Get(), 0u )
+    );
+    ++nMap_;
+
+    base_ = head_;
+    head_ += stage_.size();
+}
+
+std::optional<GFXUploadRing::Allocation> GFXUploadRing::take() noexcept {
+    if ( bStaging_ || nTaken_ >= staged_.size() ) {
+        return std::nullopt;
+    }
+
+    const auto& staged = staged_[nTaken_++];
+    return Allocation{
+        .firstConstant = static_cast<UINT>(
+            (base_ + staged.offset) / constantSize
+        ),
+        .nConstant = static_cast<UINT>(staged.size / constantSize)
+    };
+}
+
+void GFXUploadRing::bindVS( GFXPipeline& pipeline, UINT slot,
+    const Allocation& alloc
+) {
+    binder_.bind( pipeline, slot, pContext_.Get(), pBuffer_.Get(),
+        alloc.firstConstant, alloc.nConstant
+    );
+}
+
+void GFXUploadRing::create(std::size_t capacity) {
+    const auto desc = D3D11_BUFFER_DESC{
+        .ByteWidth = static_cast<UINT>(capacity),
+        .Usage = D3D11_USAGE_DYNAMIC,
+        .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+        .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
+        .MiscFlags = 0u,
+        .StructureByteStride = 0u
+    };
+
+    auto pBuffer = wrl::ComPtr<ID3D11Buffer>();
+    GFX_THROW_FAILED(
+        factory_.device()->CreateBuffer(&desc, nullptr, &pBuffer)
+    );
+
+    // draws in flight keep the old buffer alive through the context.
+    pBuffer_ = std::move(pBuffer);
+    capacity_ = capacity;
+    head_ = 0u;
+}
+
+}   // namespace gfx
@@ -20,6 +20,20 @@ void DrawCaller::drawCall(GFXPipeline& pipeline) const {
     basicDrawCall(pipeline);
 }
 
+void DrawCaller::drawCallInstanced( GFXPipeline& pipeline,
+    UINT nInstance
+) const {
+    GFX_THROW_FAILED_VOID(
+        pipeline.context()->DrawInstanced( numVertex_, nInstance,
+            startVertexLocation_, 0u
+        )
+    );
+
+#ifdef ACTIVATE_DRAWCALLER_LOG
+    logComponent_.logDraw();
+#endif
+}
+
 void DrawCallerIndexed::indexedDrawCall(GFXPipeline& pipeline) const {
     GFX_THROW_FAILED_VOID(
         pipeline.context()->DrawIndexed(numIndex_,
@@ -36,5 +50,19 @@ void DrawCallerIndexed::drawCall(GFXPipeline& pipeline) const {
     indexedDrawCall(pipeline);
 }
 
+void DrawCallerIndexed::drawCallInstanced( GFXPipeline& pipeline,
+    UINT nInstance
+) const {
+    GFX_THROW_FAILED_VOID(
+        pipeline.context()->DrawIndexedInstanced( numIndex_, nInstance,
+            startIndexLocation_, baseVertexLocation_, 0u
+        )
+    );
+
+#ifdef ACTIVATE_DRAWCALLER_LOG
+    logComponent_.logDraw();
+#endif
+}
+
 }   // namespace gfx::po
 }   // namespace gfx
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "GFX/PipelineObjects/PipelineStateObject.hpp"
+
+#include <atomic>
+
+namespace gfx {
+namespace po {
+
+namespace {
+
+std::uint64_t makePipelineStateSerial() noexcept {
+    static auto serial = std::atomic<std::uint64_t>(0u);
+    return serial.fetch_add(1u, std::memory_order_relaxed);
+}
+
+}   // namespace
+
+GFXBindKey PipelineStateBinder::bindKey(PipelineStateObject* pPSO) noexcept {
+    return GFXBindKey(pPSO->serial_);
+}
+
+void PipelineStateBinder::doBind( GFXPipeline& pipeline,
+    PipelineStateObject* pPSO
+) {
+    pPSO->bindParts(pipeline);
+}
+
+PipelineStateObject::PipelineStateObject( const VertexShader& vertexShader,
+    const PixelShader& pixelShader, const PipelineStateDesc& desc
+#ifdef ACTIVATE_BINDABLE_LOG
+    , bool enableLogOnCreation
+#endif
+) :
+#ifdef ACTIVATE_BINDABLE_LOG
+    logComponent_( this, GFXCMDSourceCategory("PipelineStateObject") ),
+#endif
+    serial_( makePipelineStateSerial() ),
+    pVertexShader_( vertexShader.shader() ),
+    pInputLayout_( vertexShader.inputLayout() ),
+    pPixelShader_( pixelShader.shader() ),
+    desc_(desc), binder_(), vertexShaderBinder_(), pixelShaderBinder_(),
+    topologyBinder_(), viewportBinder_(), rasterizerStateBinder_(),
+    blendStateBinder_(), depthStencilStateBinder_() {
+#ifdef ACTIVATE_BINDABLE_LOG
+    if (enableLogOnCreation) {
+        logComponent_.enableLog();
+    }
+    logComponent_.logCreate();
+#endif
+}
+
+void PipelineStateObject::bind(GFXPipeline& pipeline) {
+    [[maybe_unused]] auto bBindOccured = binder_.bind(pipeline, this);
+
+#ifdef ACTIVATE_BINDABLE_LOG
+    if (bBindOccured) {
+        logComponent_.logBind();
+    }
+#endif
+}
+
+// each part is diffed against what the pipeline holds on its own.
+void PipelineStateObject::bindParts(GFXPipeline& pipeline) {
+    vertexShaderBinder_.bind( pipeline,
+        pVertexShader_.Get(), pInputLayout_.Get()
+    );
+    pixelShaderBinder_.bind( pipeline, pPixelShader_.Get() );
+    topologyBinder_.bind( pipeline, desc_.topology );
+    viewportBinder_.bind( pipeline, &desc_.viewport );
+    rasterizerStateBinder_.bind( pipeline, desc_.pRasterizerState.Get() );
+    blendStateBinder_.bind( pipeline, desc_.pBlendState.Get() );
+    depthStencilStateBinder_.bind( pipeline,
+        desc_.pDepthStencilState.Get()
+    );
+}
+
+}   // namespace gfx::po
+}   // namespace gfx
@@ -35,7 +35,7 @@ Sampler::Sampler( GFXFactory factory
 }
 
 void Sampler::bind(GFXPipeline& pipeline) {
-    [[maybe_unused]] auto bBindOccured = binder_.bind( slot_,
+    [[maybe_unused]] auto bBindOccured = binder_.bind(
         pipeline, slot_, pSampler_.Get()
     );
 
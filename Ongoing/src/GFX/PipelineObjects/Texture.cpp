@@ -21,7 +21,10 @@ Texture::Texture( GFXFactory factory, const Surface& surface
 #ifdef ACTIVATE_BINDABLE_LOG
     logComponent_( this, GFXCMDSourceCategory("Texture") ),
 #endif
-    slot_(), pSRV_() {
+    slot_(), pSRV_(),
+    footprint_( surface.GetWidth() * surface.GetHeight()
+        * sizeof( Surface::Color )
+    ) {
     auto textureDesc = D3D11_TEXTURE2D_DESC{
         .Width = static_cast<UINT>( surface.GetWidth() ),
         .Height = static_cast<UINT>( surface.GetHeight() ),
@@ -77,7 +80,7 @@ Texture::Texture( GFXFactory factory, const Surface& surface
 }
 
 void Texture::bind(GFXPipeline& pipeline) {
-    [[maybe_unused]] auto bBindOccured = binder_.bind( slot_,
+    [[maybe_unused]] auto bBindOccured = binder_.bind(
         pipeline, slot_, pSRV_.GetAddressOf()
     );
 
@@ -3,12 +3,14 @@
 #include "imgui.h"
 
 #include <optional>
+#include <iterator>
 
 namespace gfx {
 namespace scenery {
 
 GFXCMDLogGuiView::GFXCMDLogGuiView()
-    : nFrameSample_(0u), frameID_(0), willShow_(true) {}
+    : nFrameSample_(0u), frameID_(0), pStorage_(nullptr),
+    pipeline_(), willShow_(true) {}
 
 void GFXCMDLogGuiView::render() {
     GFXCMDSUM.update(GFXCMDSUM.phIDFrame, GFXCMDSummarizer::IDFrame(frameID_));
@@ -44,10 +46,82 @@ void GFXCMDLogGuiView::render() {
 
         ImGui::Text( curFrameGFXCMDReport.c_str() );
 
+        if (pipeline_) {
+            renderPipeline();
+        }
+
+        if (pStorage_) {
+            renderStorage();
+        }
+
         ImGui::End();
     }
 }
 
+void GFXCMDLogGuiView::renderStorage() {
+    static constexpr const char* categoryNames[] = {
+        "Buffer", "Texture", "Shader", "Other"
+    };
+    static_assert( std::size(categoryNames)
+        == static_cast<std::size_t>(GFXStorage::FootprintCategory::Count)
+    );
+
+    const auto counters = pStorage_->frameCounters();
+    ImGui::Text( "[Resources in Frame %llu]\n"
+        "    Hit: %zu, Miss: %zu, Load: %zu, Reconstruct: %zu, Evict: %zu",
+        static_cast<unsigned long long>( pStorage_->frame() ),
+        counters.nHit, counters.nMiss, counters.nLoad,
+        counters.nReconstruct, counters.nEvict
+    );
+
+    if ( const auto budget = pStorage_->budget() ) {
+        ImGui::Text( "[Resource Memory] %zu / %zu bytes",
+            pStorage_->usage(), budget.value()
+        );
+    }
+    else {
+        ImGui::Text( "[Resource Memory] %zu bytes", pStorage_->usage() );
+    }
+
+    const auto categories = pStorage_->categoryFootprints();
+    for (std::size_t i = 0u; i < categories.size(); ++i) {
+        ImGui::Text( "    %s: %zu bytes in %zu",
+            categoryNames[i], categories[i].bytes, categories[i].nResource
+        );
+    }
+
+    if ( ImGui::TreeNode("By Type") ) {
+        for (const auto& [type, footprint] : pStorage_->typeFootprints()) {
+            ImGui::Text( "%s: %zu bytes in %zu",
+                type.name(), footprint.bytes, footprint.nResource
+            );
+        }
+        ImGui::TreePop();
+    }
+}
+
+void GFXCMDLogGuiView::renderPipeline() {
+    const auto counters = pipeline_->state().frameCounters();
+    const auto nRequest = counters.nBind + counters.nElided;
+    const auto nUploadRequest = counters.nUpload + counters.nUploadSkipped;
+
+    ImGui::Text( "[Pipeline State]\n"
+        "    Bind: %zu, Elided: %zu (%.1f%%)\n"
+        "    Upload: %zu, Skipped: %zu (%.1f%%)",
+        counters.nBind, counters.nElided,
+        nRequest ? 100.f * static_cast<float>(counters.nElided)
+            / static_cast<float>(nRequest) : 0.f,
+        counters.nUpload, counters.nUploadSkipped,
+        nUploadRequest ? 100.f * static_cast<float>(counters.nUploadSkipped)
+            / static_cast<float>(nUploadRequest) : 0.f
+    );
+
+    const auto queued = pipeline_->uploadQueue().frameCounters();
+    ImGui::Text( "    Staged: %zu, Written: %zu (%zu bytes)",
+        queued.nStaged, queued.nUpload, queued.nByte
+    );
+}
+
 GFXCMDLogGuiView& getGFXCMDLogGuiView() {
     static auto inst = std::optional<GFXCMDLogGuiView>();
 
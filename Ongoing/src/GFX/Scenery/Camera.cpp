@@ -21,7 +21,7 @@ CameraVision::CameraVision()
     } ) {}
 
 CameraVision::CameraVision(const CameraVisionDesc& cvDesc)
-    : viewTrans_(), projTrans_(),
+    : viewTrans_(), projTrans_(), viewProjTrans_(),
     viewTransDesc_(cvDesc.viewTransDesc),
     projTransDesc_(cvDesc.projTransDesc) {
     auto eye = dx::XMLoadFloat3(&cvDesc.viewTransDesc.eye);
@@ -35,6 +35,7 @@ CameraVision::CameraVision(const CameraVisionDesc& cvDesc)
 
     viewTrans_ = dx::XMMatrixLookAtLH(eye, at, up);
     projTrans_ = dx::XMMatrixPerspectiveFovLH(fovy, aspect, nearZ, farZ);
+    viewProjTrans_ = viewTrans_ * projTrans_;
 }
 
 void CameraVision::updateView(const CameraViewTransDesc& vtd) {
@@ -43,6 +44,7 @@ void CameraVision::updateView(const CameraViewTransDesc& vtd) {
     auto up = dx::XMLoadFloat3(&vtd.up);
 
     viewTrans_ = dx::XMMatrixLookAtLH(eye, at, up);
+    viewProjTrans_ = viewTrans_ * projTrans_;
 
     viewTransDesc_ = vtd;
 }
@@ -54,10 +56,16 @@ void CameraVision::updateProj(const CameraProjTransDesc& ptd) {
     auto& farZ = ptd.farZ;
 
     projTrans_ = dx::XMMatrixPerspectiveFovLH(fovy, aspect, nearZ, farZ);
+    viewProjTrans_ = viewTrans_ * projTrans_;
 
     projTransDesc_ = ptd;
 }
 
+void VCALL CameraVision::rotateView(dx::FXMMATRIX rotation) {
+    viewTrans_ *= rotation;
+    viewProjTrans_ = viewTrans_ * projTrans_;
+}
+
 const CameraViewTransDesc
 Camera::CameraCoordComponent::makeVTDesc() const noexcept {
     auto worldTrans = coordSystem_.total();
@@ -99,19 +107,19 @@ void Camera::setParams( std::optional<float> fovy,
 }
 
 void Camera::rotateX(float theta) {
-    vision().viewTrans() *= dx::XMMatrixRotationX(theta);
+    vision().rotateView( dx::XMMatrixRotationX(theta) );
 }
 
 void Camera::rotateY(float theta) {
-    vision().viewTrans() *= dx::XMMatrixRotationY(theta);
+    vision().rotateView( dx::XMMatrixRotationY(theta) );
 }
 
 void Camera::rotateZ(float theta) {
-    vision().viewTrans() *= dx::XMMatrixRotationZ(theta);
+    vision().rotateView( dx::XMMatrixRotationZ(theta) );
 }
 
 void VCALL Camera::rotateAxis(dx::FXMVECTOR axis, float theta) {
-    vision().viewTrans() *= dx::XMMatrixRotationAxis(axis, theta);
+    vision().rotateView( dx::XMMatrixRotationAxis(axis, theta) );
 }
 
 } // namespace gfx::scenery
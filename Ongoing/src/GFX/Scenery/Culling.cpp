@@ -0,0 +1,207 @@
+#include "GFX/Scenery/Culling.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+namespace gfx {
+namespace scenery {
+
+BoundingSphere VCALL BoundingSphere::transformed(dx::FXMMATRIX trans) const noexcept {
+    // rows are the transformed axes, as vectors multiply from the left.
+    const auto scaleSq = dx::XMVectorMax(
+        dx::XMVector3LengthSq( trans.r[0] ),
+        dx::XMVectorMax(
+            dx::XMVector3LengthSq( trans.r[1] ),
+            dx::XMVector3LengthSq( trans.r[2] )
+        )
+    );
+
+    auto ret = BoundingSphere{
+        .center = {},
+        .radius = radius * dx::XMVectorGetX( dx::XMVectorSqrt(scaleSq) )
+    };
+    dx::XMStoreFloat3( &ret.center,
+        dx::XMVector3TransformCoord( dx::XMLoadFloat3(&center), trans )
+    );
+
+    return ret;
+}
+
+Ray Ray::unproject(const Transform& viewProj, float ndcX, float ndcY) noexcept {
+    const auto invViewProj = dx::XMMatrixInverse( nullptr, viewProj.get() );
+    const auto onNear = dx::XMVector3TransformCoord(
+        dx::XMVectorSet(ndcX, ndcY, 0.f, 1.f), invViewProj
+    );
+    const auto onFar = dx::XMVector3TransformCoord(
+        dx::XMVectorSet(ndcX, ndcY, 1.f, 1.f), invViewProj
+    );
+
+    auto ret = Ray{};
+    dx::XMStoreFloat3( &ret.origin, onNear );
+    dx::XMStoreFloat3( &ret.direction,
+        dx::XMVector3Normalize( dx::XMVectorSubtract(onFar, onNear) )
+    );
+
+    return ret;
+}
+
+std::optional<float> Ray::intersect( const BoundingBox& box,
+    float tMax
+) const noexcept {
+    auto tMin = 0.f;
+
+    for (std::size_t axis = 0u; axis < 3u; ++axis) {
+        const auto o = (&origin.x)[axis];
+        const auto d = (&direction.x)[axis];
+        const auto lo = (&box.lo.x)[axis];
+        const auto hi = (&box.hi.x)[axis];
+
+        // parallel to the slab, either always in or never.
+        if (d == 0.f) {
+            if (o < lo || hi < o) {
+                return std::nullopt;
+            }
+            continue;
+        }
+
+        auto tNear = (lo - o) / d;
+        auto tFar = (hi - o) / d;
+        if (tNear > tFar) {
+            std::swap(tNear, tFar);
+        }
+
+        tMin = std::max(tMin, tNear);
+        tMax = std::min(tMax, tFar);
+        if (tMin > tMax) {
+            return std::nullopt;
+        }
+    }
+
+    return tMin;
+}
+
+std::optional<float> Ray::intersect( const BoundingSphere& sphere,
+    float tMax
+) const noexcept {
+    const auto o = dx::XMLoadFloat3(&origin);
+    const auto d = dx::XMLoadFloat3(&direction);
+    const auto oc = dx::XMVectorSubtract( o, dx::XMLoadFloat3(&sphere.center) );
+
+    // |o + t * d - c|^2 = r^2, solved for the nearer t.
+    const auto a = dx::XMVectorGetX( dx::XMVector3Dot(d, d) );
+    const auto b = dx::XMVectorGetX( dx::XMVector3Dot(oc, d) );
+    const auto c = dx::XMVectorGetX( dx::XMVector3Dot(oc, oc) )
+        - sphere.radius * sphere.radius;
+
+    const auto discriminant = b * b - a * c;
+    if (a == 0.f || discriminant < 0.f) {
+        return std::nullopt;
+    }
+
+    const auto sqrtDisc = std::sqrt(discriminant);
+    auto t = (-b - sqrtDisc) / a;
+    // started inside the sphere.
+    if (t < 0.f) {
+        t = (-b + sqrtDisc) / a;
+        if (t < 0.f) {
+            return std::nullopt;
+        }
+        t = 0.f;
+    }
+
+    if (t > tMax) {
+        return std::nullopt;
+    }
+    return t;
+}
+
+Frustum::Frustum(const Transform& viewProj) noexcept
+    : planeBatches_() {
+    // clip = v * viewProj, so each clip coordinate is a column dotted with v.
+    const auto cols = dx::XMMatrixTranspose( viewProj.get() );
+
+    const auto planes = std::array<dx::XMVECTOR, nPlane>{
+        dx::XMVectorAdd( cols.r[3], cols.r[0] ),        // left
+        dx::XMVectorSubtract( cols.r[3], cols.r[0] ),   // right
+        dx::XMVectorAdd( cols.r[3], cols.r[1] ),        // bottom
+        dx::XMVectorSubtract( cols.r[3], cols.r[1] ),   // top
+        cols.r[2],                                      // near, depth from 0
+        dx::XMVectorSubtract( cols.r[3], cols.r[2] )    // far
+    };
+
+    for (std::size_t i = 0u; i < nBatch * batchSize; ++i) {
+        auto plane = dx::XMFLOAT4(0.f, 0.f, 0.f, 1.f);
+        if (i < nPlane) {
+            dx::XMStoreFloat4( &plane, dx::XMPlaneNormalize( planes[i] ) );
+        }
+
+        auto& batch = planeBatches_[i / batchSize];
+        const auto lane = i % batchSize;
+        (&batch.xs.x)[lane] = plane.x;
+        (&batch.ys.x)[lane] = plane.y;
+        (&batch.zs.x)[lane] = plane.z;
+        (&batch.ws.x)[lane] = plane.w;
+    }
+}
+
+Frustum::Containment Frustum::classify(const BoundingBox& box) const noexcept {
+    const auto zero = dx::XMVectorZero();
+    const auto lo = dx::XMLoadFloat3(&box.lo);
+    const auto hi = dx::XMLoadFloat3(&box.hi);
+    const auto loX = dx::XMVectorSplatX(lo);
+    const auto loY = dx::XMVectorSplatY(lo);
+    const auto loZ = dx::XMVectorSplatZ(lo);
+    const auto hiX = dx::XMVectorSplatX(hi);
+    const auto hiY = dx::XMVectorSplatY(hi);
+    const auto hiZ = dx::XMVectorSplatZ(hi);
+
+    auto outside = dx::XMVectorFalseInt();
+    auto crossing = dx::XMVectorFalseInt();
+
+    for (const auto& batch : planeBatches_) {
+        const auto px = dx::XMLoadFloat4(&batch.xs);
+        const auto py = dx::XMLoadFloat4(&batch.ys);
+        const auto pz = dx::XMLoadFloat4(&batch.zs);
+        const auto pw = dx::XMLoadFloat4(&batch.ws);
+
+        // the corners farthest along and against each plane normal.
+        const auto alongX = dx::XMVectorGreater(px, zero);
+        const auto alongY = dx::XMVectorGreater(py, zero);
+        const auto alongZ = dx::XMVectorGreater(pz, zero);
+
+        auto distFar = dx::XMVectorMultiplyAdd(
+            dx::XMVectorSelect(loX, hiX, alongX), px, pw
+        );
+        distFar = dx::XMVectorMultiplyAdd(
+            dx::XMVectorSelect(loY, hiY, alongY), py, distFar
+        );
+        distFar = dx::XMVectorMultiplyAdd(
+            dx::XMVectorSelect(loZ, hiZ, alongZ), pz, distFar
+        );
+
+        auto distNear = dx::XMVectorMultiplyAdd(
+            dx::XMVectorSelect(hiX, loX, alongX), px, pw
+        );
+        distNear = dx::XMVectorMultiplyAdd(
+            dx::XMVectorSelect(hiY, loY, alongY), py, distNear
+        );
+        distNear = dx::XMVectorMultiplyAdd(
+            dx::XMVectorSelect(hiZ, loZ, alongZ), pz, distNear
+        );
+
+        outside = dx::XMVectorOrInt( outside, dx::XMVectorLess(distFar, zero) );
+        crossing = dx::XMVectorOrInt( crossing, dx::XMVectorLess(distNear, zero) );
+    }
+
+    if ( dx::XMVector4NotEqualInt( outside, dx::XMVectorFalseInt() ) ) {
+        return Containment::Outside;
+    }
+    if ( dx::XMVector4NotEqualInt( crossing, dx::XMVectorFalseInt() ) ) {
+        return Containment::Intersects;
+    }
+    return Containment::Inside;
+}
+
+}  // namespace gfx::scenery
+}  // namespace gfx
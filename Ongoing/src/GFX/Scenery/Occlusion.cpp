@@ -0,0 +1,297 @@
+#include "GFX/Scenery/Occlusion.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+namespace gfx {
+namespace scenery {
+
+namespace {
+
+constexpr std::size_t simdWidth = 4u;
+
+// the cube occluders are placed from.
+const auto unitBox = BoundingBox{
+    .lo = dx::XMFLOAT3(-1.f, -1.f, -1.f),
+    .hi = dx::XMFLOAT3(1.f, 1.f, 1.f)
+};
+
+// corner i takes hi along axis n where bit n of i is set.
+constexpr std::size_t boxTriangles[12][3] = {
+    {0, 3, 2}, {0, 1, 3},   // -z
+    {4, 7, 5}, {4, 6, 7},   // +z
+    {0, 6, 4}, {0, 2, 6},   // -x
+    {1, 7, 3}, {1, 5, 7},   // +x
+    {0, 5, 1}, {0, 4, 5},   // -y
+    {2, 7, 6}, {2, 3, 7}    // +y
+};
+
+// a / b / c of a * x + b * y + c,
+// positive on the inner side of a counter-clockwise edge.
+struct Edge {
+    float a;
+    float b;
+    float c;
+
+    static Edge through( const auto& from, const auto& to ) noexcept {
+        const auto a = to.y - from.y;
+        const auto b = from.x - to.x;
+        return Edge{ .a = a, .b = b, .c = -(a * from.x + b * from.y) };
+    }
+
+    float at(float x, float y) const noexcept {
+        return a * x + b * y + c;
+    }
+};
+
+// the pixel boundary nearest to a screen coordinate, clamped to the screen.
+std::size_t toPixel(float v, std::size_t bound) noexcept {
+    return static_cast<std::size_t>(
+        std::clamp( v, 0.f, static_cast<float>(bound) )
+    );
+}
+
+dx::XMVECTOR loadDepths(const float* src) noexcept {
+    return dx::XMLoadFloat4( reinterpret_cast<const dx::XMFLOAT4*>(src) );
+}
+
+void storeDepths(float* dst, dx::FXMVECTOR depths) noexcept {
+    dx::XMStoreFloat4( reinterpret_cast<dx::XMFLOAT4*>(dst), depths );
+}
+
+}   // namespace
+
+OcclusionBuffer::OcclusionBuffer(std::size_t width, std::size_t height)
+    : width_( (width + tileWidth - 1u) / tileWidth * tileWidth ),
+    height_( (height + tileHeight - 1u) / tileHeight * tileHeight ),
+    nTileX_(width_ / tileWidth), viewProj_(),
+    depths_(width_ * height_, 1.f),
+    tileMaxDepths_(nTileX_ * (height_ / tileHeight), 1.f) {}
+
+void OcclusionBuffer::clear(const Transform& viewProj) {
+    viewProj_ = viewProj;
+    std::ranges::fill(depths_, 1.f);
+    std::ranges::fill(tileMaxDepths_, 1.f);
+}
+
+void OcclusionBuffer::rasterizeBox(const Transform& world) {
+    ScreenVertex corners[8];
+    if ( !project( ( world * viewProj_ ).get(), unitBox, corners ) ) {
+        return;
+    }
+
+    // a mirroring transform turns the faces' winding over.
+    const auto bMirrored = dx::XMVectorGetX(
+        dx::XMMatrixDeterminant( world.get() )
+    ) < 0.f;
+
+    for (const auto& [i0, i1, i2] : boxTriangles) {
+        if (bMirrored) {
+            rasterizeTriangle( corners[i0], corners[i2], corners[i1] );
+        }
+        else {
+            rasterizeTriangle( corners[i0], corners[i1], corners[i2] );
+        }
+    }
+
+    refreshTiles( rectOf(corners) );
+}
+
+bool OcclusionBuffer::visible(const BoundingBox& box) const {
+    ScreenVertex corners[8];
+    if ( !project( viewProj_.get(), box, corners ) ) {
+        return true;
+    }
+
+    const auto rect = rectOf(corners);
+    if (rect.x0 >= rect.x1 || rect.y0 >= rect.y1) {
+        return true;
+    }
+
+    auto nearest = corners[0].z;
+    for (const auto& corner : corners) {
+        nearest = std::min(nearest, corner.z);
+    }
+    const auto nearestV = dx::XMVectorReplicate(nearest);
+
+    for (auto ty = rect.y0 / tileHeight; ty * tileHeight < rect.y1; ++ty) {
+        for (auto tx = rect.x0 / tileWidth; tx * tileWidth < rect.x1; ++tx) {
+            // the whole tile is nearer than the box.
+            if (tileMaxDepths_[ty * nTileX_ + tx] < nearest) {
+                continue;
+            }
+
+            // tested in whole vectors, which only widens the rect.
+            const auto x0 = std::max(rect.x0, tx * tileWidth)
+                / simdWidth * simdWidth;
+            const auto x1 = std::min(rect.x1, (tx + 1u) * tileWidth);
+            const auto y0 = std::max(rect.y0, ty * tileHeight);
+            const auto y1 = std::min(rect.y1, (ty + 1u) * tileHeight);
+
+            for (auto y = y0; y < y1; ++y) {
+                const auto row = depths_.data() + y * width_;
+                for (auto x = x0; x < x1; x += simdWidth) {
+                    if ( !dx::XMVector4Less( loadDepths(row + x), nearestV ) ) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool OcclusionBuffer::project( dx::FXMMATRIX trans, const BoundingBox& box,
+    ScreenVertex (&corners)[8]
+) const noexcept {
+    const auto halfWidth = 0.5f * static_cast<float>(width_);
+    const auto halfHeight = 0.5f * static_cast<float>(height_);
+
+    for (std::size_t i = 0u; i < 8u; ++i) {
+        const auto corner = dx::XMVectorSet(
+            (i & 1u) ? box.hi.x : box.lo.x,
+            (i & 2u) ? box.hi.y : box.lo.y,
+            (i & 4u) ? box.hi.z : box.lo.z,
+            1.f
+        );
+
+        auto clip = dx::XMFLOAT4();
+        dx::XMStoreFloat4( &clip, dx::XMVector4Transform(corner, trans) );
+
+        // depth starts from 0 at the near plane.
+        if (clip.z < 0.f || clip.w <= 0.f) {
+            return false;
+        }
+
+        const auto invW = 1.f / clip.w;
+        corners[i] = ScreenVertex{
+            .x = (clip.x * invW + 1.f) * halfWidth,
+            .y = (1.f - clip.y * invW) * halfHeight,
+            .z = clip.z * invW
+        };
+    }
+
+    return true;
+}
+
+OcclusionBuffer::ScreenRect OcclusionBuffer::rectOf(
+    const ScreenVertex (&corners)[8]
+) const noexcept {
+    auto minX = corners[0].x;
+    auto maxX = corners[0].x;
+    auto minY = corners[0].y;
+    auto maxY = corners[0].y;
+    for (const auto& corner : corners) {
+        minX = std::min(minX, corner.x);
+        maxX = std::max(maxX, corner.x);
+        minY = std::min(minY, corner.y);
+        maxY = std::max(maxY, corner.y);
+    }
+
+    // every pixel the corners touch.
+    return ScreenRect{
+        .x0 = toPixel( std::floor(minX), width_ ),
+        .y0 = toPixel( std::floor(minY), height_ ),
+        .x1 = toPixel( std::ceil(maxX), width_ ),
+        .y1 = toPixel( std::ceil(maxY), height_ )
+    };
+}
+
+void OcclusionBuffer::rasterizeTriangle( ScreenVertex v0, ScreenVertex v1,
+    ScreenVertex v2
+) noexcept {
+    // back faces are hidden by the front ones anyway.
+    const auto area = Edge::through(v0, v1).at(v2.x, v2.y);
+    if (area <= 0.f) {
+        return;
+    }
+
+    const auto e0 = Edge::through(v1, v2);
+    const auto e1 = Edge::through(v2, v0);
+    const auto e2 = Edge::through(v0, v1);
+
+    // depth is linear in screen space, as barycentric weights are.
+    const auto invArea = 1.f / area;
+    const auto za = (e0.a * v0.z + e1.a * v1.z + e2.a * v2.z) * invArea;
+    const auto zb = (e0.b * v0.z + e1.b * v1.z + e2.b * v2.z) * invArea;
+    const auto zc = (e0.c * v0.z + e1.c * v1.z + e2.c * v2.z) * invArea;
+
+    // rows start at whole vectors, lanes outside fail the edge tests.
+    const auto x0 = toPixel( std::floor( std::min({v0.x, v1.x, v2.x}) ),
+        width_ ) / simdWidth * simdWidth;
+    const auto x1 = toPixel( std::ceil( std::max({v0.x, v1.x, v2.x}) ), width_ );
+    const auto y0 = toPixel( std::floor( std::min({v0.y, v1.y, v2.y}) ), height_ );
+    const auto y1 = toPixel( std::ceil( std::max({v0.y, v1.y, v2.y}) ), height_ );
+
+    const auto a0 = dx::XMVectorReplicate(e0.a);
+    const auto a1 = dx::XMVectorReplicate(e1.a);
+    const auto a2 = dx::XMVectorReplicate(e2.a);
+    const auto zaV = dx::XMVectorReplicate(za);
+    const auto zero = dx::XMVectorZero();
+
+    for (auto y = y0; y < y1; ++y) {
+        // sampled at pixel centers.
+        const auto py = static_cast<float>(y) + 0.5f;
+        const auto px = static_cast<float>(x0) + 0.5f;
+        auto xs = dx::XMVectorSet(px, px + 1.f, px + 2.f, px + 3.f);
+        const auto step = dx::XMVectorReplicate( static_cast<float>(simdWidth) );
+
+        const auto c0 = dx::XMVectorReplicate(e0.b * py + e0.c);
+        const auto c1 = dx::XMVectorReplicate(e1.b * py + e1.c);
+        const auto c2 = dx::XMVectorReplicate(e2.b * py + e2.c);
+        const auto cz = dx::XMVectorReplicate(zb * py + zc);
+
+        const auto row = depths_.data() + y * width_;
+        for (auto x = x0; x < x1; x += simdWidth) {
+            const auto inside = dx::XMVectorAndInt(
+                dx::XMVectorGreaterOrEqual(
+                    dx::XMVectorMultiplyAdd(a0, xs, c0), zero
+                ),
+                dx::XMVectorAndInt(
+                    dx::XMVectorGreaterOrEqual(
+                        dx::XMVectorMultiplyAdd(a1, xs, c1), zero
+                    ),
+                    dx::XMVectorGreaterOrEqual(
+                        dx::XMVectorMultiplyAdd(a2, xs, c2), zero
+                    )
+                )
+            );
+
+            const auto depths = loadDepths(row + x);
+            const auto z = dx::XMVectorMultiplyAdd(zaV, xs, cz);
+            storeDepths( row + x, dx::XMVectorSelect( depths,
+                dx::XMVectorMin(depths, z), inside
+            ) );
+
+            xs = dx::XMVectorAdd(xs, step);
+        }
+    }
+}
+
+void OcclusionBuffer::refreshTiles(const ScreenRect& rect) noexcept {
+    for (auto ty = rect.y0 / tileHeight; ty * tileHeight < rect.y1; ++ty) {
+        for (auto tx = rect.x0 / tileWidth; tx * tileWidth < rect.x1; ++tx) {
+            auto farthest = dx::XMVectorZero();
+
+            for (auto y = ty * tileHeight; y < (ty + 1u) * tileHeight; ++y) {
+                const auto row = depths_.data() + y * width_;
+                for (auto x = tx * tileWidth; x < (tx + 1u) * tileWidth;
+                    x += simdWidth
+                ) {
+                    farthest = dx::XMVectorMax( farthest, loadDepths(row + x) );
+                }
+            }
+
+            auto lanes = dx::XMFLOAT4();
+            dx::XMStoreFloat4(&lanes, farthest);
+            tileMaxDepths_[ty * nTileX_ + tx] = std::max(
+                { lanes.x, lanes.y, lanes.z, lanes.w }
+            );
+        }
+    }
+}
+
+}  // namespace gfx::scenery
+}  // namespace gfx
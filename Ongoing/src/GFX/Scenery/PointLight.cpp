@@ -11,9 +11,9 @@ BPDynPointLight::BPDynPointLight(GFXFactory factory)
 BPDynPointLight::BPDynPointLight( GFXFactory factory,
     const BPPointLightDesc& lightDesc
 ) : lightDesc_(lightDesc),
-    cbuf_( std::move(factory), D3D11_USAGE_DEFAULT, 0,
+    cbuf_( lightDesc_, std::move(factory), D3D11_USAGE_DEFAULT, 0,
         std::ranges::single_view(lightDesc_)
-    ), dirty_(false) {}
+    ) {}
 
 // referenced attenuation coefficient constants from
 // https://wiki.ogre3d.org/-Point+Light+Attenuation
@@ -31,13 +31,7 @@ void BPDynPointLight::bind(GFXPipeline& pipeline) /* overriden */ {
     // if rebind required, rebind
     // it is handled in PSCBuffer internally
     pipeline.bind(&cbuf_);
-
-    if (dirty_) {
-        cbuf_.stage( pipeline, [this](){
-            return &lightDesc_;
-        } );
-        dirty_ = false;
-    }
+    cbuf_.update(pipeline, lightDesc_);
 }
 
 }   // namespace Basic
@@ -72,7 +66,10 @@ void BPDynPointLight::bind(GFXPipeline& pipeline) /* overriden */ {
 Luminance::Luminance(GFXFactory factory, GFXStorage& storage)
     : res_( GFXRes::makeLoaded<BPDynPointLight>(
         storage, std::move(factory)
-    ) ) {}
+    ) ) {
+    // light state lives in the bindee, rebuilding it would lose that.
+    res_.pin();
+}
 
 void Luminance::sync(const Renderer& renderer) {
     if (typeid(renderer) == typeid(BPhongRenderer)) {
@@ -93,35 +90,73 @@ void Luminance::sync(const BPhongRenderer& renderer) {
     );
 }
 
-LightViz::LightViz( GFXFactory factory, GFXStorage& storage,
-    const Win32::Client& client
-) : dc_( std::move(factory), storage, client ),
-    base_(nullptr) {}
+void LightViz::prefetch(GFXFactory factory, GFXStorage& storage) {
+    DrawComponentLViz::prefetch(std::move(factory), storage);
+}
+
+LightViz::LightViz(GFXFactory factory, GFXStorage& storage)
+    : dc_( std::move(factory), storage ), base_(nullptr) {}
 
 LightViz::LightViz( const Luminance& base, GFXFactory factory,
-    GFXStorage& storage, const Win32::Client& client
-) : dc_( std::move(factory), storage, client ),
-    base_(&base) {}
+    GFXStorage& storage
+) : dc_( std::move(factory), storage ), base_(&base) {}
 
 class LightViz::DrawComponentLViz::MyVertexBuffer
     : public Primitives::Sphere::SphereVertexBuffer {
 public:
-    MyVertexBuffer(GFXFactory factory)
+    MyVertexBuffer(GFXFactory factory, std::size_t level)
+        : Primitives::Sphere::SphereVertexBuffer( std::move(factory),
+            lodTesselations[level], lodTesselations[level]
+        ) {}
+
+    MyVertexBuffer(GFXFactory factory, std::span<const MyVertex> prepared)
         : Primitives::Sphere::SphereVertexBuffer(
-            std::move(factory), 256u, 256u
+            std::move(factory), prepared
         ) {}
+
+    // shares the payload cached by the tesselating constructor.
+    static std::span<const MyVertex> prepare(std::size_t level) {
+        const auto n = lodTesselations[level];
+        return GFXPAYLOADCACHE.fetch<MyVertex>(
+            GFXContentKey::make<Primitives::Sphere::SphereVertexBuffer>(n, n),
+            [n]() {
+                return Primitives::Sphere::modelPositions< std::vector<MyVertex> >(
+                    n, n
+                );
+            }
+        );
+    }
 };
 
 class LightViz::DrawComponentLViz::MyIndexBuffer
     : public Primitives::Sphere::SphereIndexBuffer {
 public:
-    MyIndexBuffer(GFXFactory factory)
+    MyIndexBuffer(GFXFactory factory, std::size_t level)
+        : Primitives::Sphere::SphereIndexBuffer( std::move(factory),
+            lodTesselations[level], lodTesselations[level]
+        ) {}
+
+    MyIndexBuffer(GFXFactory factory, std::span<const MyIndex> prepared)
         : Primitives::Sphere::SphereIndexBuffer(
-            std::move(factory), 256u, 256u
+            std::move(factory), prepared
         ) {}
 
-    static std::size_t size() noexcept {
-        return Primitives::Sphere::SphereIndexBuffer::size(256u, 256u);
+    static std::span<const MyIndex> prepare(std::size_t level) {
+        const auto n = lodTesselations[level];
+        return GFXPAYLOADCACHE.fetch<MyIndex>(
+            GFXContentKey::make<Primitives::Sphere::SphereIndexBuffer>(n, n),
+            [n]() {
+                return Primitives::Sphere::modelIndices< std::vector<MyIndex> >(
+                    n, n
+                );
+            }
+        );
+    }
+
+    static std::size_t size(std::size_t level) noexcept {
+        return Primitives::Sphere::SphereIndexBuffer::size(
+            lodTesselations[level], lodTesselations[level]
+        );
     }
 };
 
@@ -139,7 +174,7 @@ class LightViz::DrawComponentLViz::MyDynColorCBuf
     : public po::IPipelineObject {
 public:
     MyDynColorCBuf(GFXFactory factory)
-        : wrapped_( std::move(factory) ),
+        : wrapped_( dx::XMVectorReplicate(1.f), std::move(factory) ),
         color_( dx::XMVectorReplicate(1.f) ) {}
 
     void setSlot(UINT slot) {
@@ -161,12 +196,10 @@ public:
 private:
     void bind(GFXPipeline& pipeline) override {
         pipeline.bind(&wrapped_);
-        wrapped_.dynamicUpdate(
-            pipeline, [this]() { return &color_; }
-        );
+        wrapped_.update(pipeline, color_);
     }
 
-    MyColorCBuf wrapped_;
+    po::ShadowedCBuffer<MyColorCBuf> wrapped_;
     dx::XMVECTOR color_;
 };
 
@@ -181,49 +214,32 @@ public:
         ) {}
 };
 
-class LightViz::DrawComponentLViz::MyViewport
-    : public po::Viewport {
-public:
-    MyViewport(const Win32::Client& client)
-        : Viewport( D3D11_VIEWPORT{
-            .TopLeftX = 0.f,
-            .TopLeftY = 0.f,
-            .Width = static_cast<FLOAT>(client.width),
-            .Height = static_cast<FLOAT>(client.height),
-            .MinDepth = 0.f,
-            .MaxDepth = 1.f
-        } ) {}
-};
-
-class LightViz::DrawComponentLViz::MyTopology
-    : public po::Topology {
-public:
-    MyTopology()
-        : Topology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST) {}
-};
-
 LightViz::DrawComponentLViz::DrawComponentLViz(
-    GFXFactory factory, GFXStorage& storage,
-    const Win32::Client& client
+    GFXFactory factory, GFXStorage& storage
 ) : transformGPUMapper_(storage),
-    transformApplyer_(transformGPUMapper_),
 #ifdef ACTIVATE_DRAWCOMPONENT_LOG
     logComponent_(this),
 #endif
-    vBuf_( GFXRes::makeCached<MyVertexBuffer>(storage, tagVertexBuffer, factory) ),
-    iBuf_( GFXRes::makeCached<MyIndexBuffer>(storage, tagIndexBuffer, factory) ),
+    vBufs_(), iBufs_(),
     colorCBuf_( GFXRes::makeLoaded<MyDynColorCBuf>(storage, factory) ),
     transCBuf_( GFXRes::makeCached<MyTransformCBuf>(storage, tagTransformCBuf, factory) ),
-    viewport_( GFXRes::makeCached<MyViewport>(storage, tagViewport, client) ),
-    topology_( GFXRes::makeCached<MyTopology>(storage, tagTopology) ) {
+    lod_(lodMinRadii) {
 
-    transformGPUMapper_.setTCBufID(transCBuf_.id());
+    for (std::size_t level = 0u; level < nLOD; ++level) {
+        vBufs_[level] = GFXRes::makeShared<MyVertexBuffer>( storage,
+            GFXContentKey::make<MyVertexBuffer>(level), factory, level
+        );
+        iBufs_[level] = GFXRes::makeShared<MyIndexBuffer>( storage,
+            GFXContentKey::make<MyIndexBuffer>(level), factory, level
+        );
+    }
+
+    colorCBuf_.pin();
 
     this->setDrawCaller( std::make_unique<MyDrawCaller>(
-        static_cast<UINT>( MyIndexBuffer::size() ), 0u, 0
+        static_cast<UINT>( MyIndexBuffer::size( lod_.level() ) ), 0u, 0
     ) );
 
-    this->drawCaller().addDrawContext(&transformApplyer_);
     this->drawCaller().addDrawContext(&transformGPUMapper_);
 #ifdef ACTIVATE_DRAWCOMPONENT_LOG
     logComponent_.entryStackPop();
@@ -231,29 +247,41 @@ LightViz::DrawComponentLViz::DrawComponentLViz(
 
 }
 
+void LightViz::DrawComponentLViz::prefetch(
+    GFXFactory factory, GFXStorage& storage
+) {
+    // sphere geometry dominates the CPU cost of the visualization,
+    // so generate it on workers and let the constructor share it.
+    for (std::size_t level = 0u; level < nLOD; ++level) {
+        storage.loadAsync<MyVertexBuffer>(
+            GFXContentKey::make<MyVertexBuffer>(level),
+            [level]() { return MyVertexBuffer::prepare(level); }, factory
+        );
+        storage.loadAsync<MyIndexBuffer>(
+            GFXContentKey::make<MyIndexBuffer>(level),
+            [level]() { return MyIndexBuffer::prepare(level); }, factory
+        );
+    }
+}
+
 LightViz::DrawComponentLViz::DrawComponentLViz(
     DrawComponentLViz&& other
 ) noexcept
     : RCDrawCmp(std::move(other)),
     transformGPUMapper_( std::move(other.transformGPUMapper_) ),
-    transformApplyer_( std::move(other.transformApplyer_) ),
 #ifdef ACTIVATE_DRAWCOMPONENT_LOG
     logComponent_( std::move(other.logComponent_) ),
 #endif
-    vBuf_( std::move(other.vBuf_) ),
-    iBuf_( std::move(other.iBuf_) ),
+    vBufs_( std::move(other.vBufs_) ),
+    iBufs_( std::move(other.iBufs_) ),
     colorCBuf_( std::move(other.colorCBuf_) ),
     transCBuf_( std::move(other.transCBuf_) ),
-    viewport_( std::move(other.viewport_) ),
-    topology_( std::move(other.topology_) ) {
-
-    transformApplyer_.linkMapper(transformGPUMapper_);
+    lod_( std::move(other.lod_) ) {
 
     this->setDrawCaller( std::make_unique<MyDrawCaller>(
-        static_cast<UINT>( MyIndexBuffer::size() ), 0u, 0
+        static_cast<UINT>( MyIndexBuffer::size( lod_.level() ) ), 0u, 0
     ) );
 
-    this->drawCaller().addDrawContext(&transformApplyer_);
     this->drawCaller().addDrawContext(&transformGPUMapper_);
 
 #ifdef ACTIVATE_DRAWCOMPONENT_LOG
@@ -290,34 +318,59 @@ void LightViz::DrawComponentLViz::sync(
     }
 }
 
+// only the level drawn is touched, the others may stay evicted.
 void LightViz::DrawComponentLViz::sync(const SolidRenderer& renderer) {
-    assert(vBuf_.valid());
-    vBuf_.as<MyVertexBuffer>().setSlot( SolidRenderer::slotPosBuffer() );
+    vBufs_[ lod_.level() ].as<MyVertexBuffer>().setSlot(
+        SolidRenderer::slotPosBuffer()
+    );
 
     assert(colorCBuf_.valid());
     colorCBuf_.as<MyDynColorCBuf>().setSlot( SolidRenderer::slotColorCBuf() );
 
-    assert(transCBuf_.valid());
-    transCBuf_.as<MyTransformCBuf>().setSlot( SolidRenderer::slotTransCBuf() );
+    transCBuf_.as<MyTransformCBuf>().setSlot( SolidRenderer::slotObjectCBuffer() );
+    transformGPUMapper_.setTCBufID( transCBuf_.id() );
 
-    this->setRODesc( RenderObjectDesc{
-        .header = RenderObjectDesc::Header{
-            .IDBuffer = vBuf_.id(),
-            .IDType = typeid(*this)
-        },
-        .IDs = {
-            vBuf_.id(), iBuf_.id(), colorCBuf_.id(),
-            transCBuf_.id(), viewport_.id(), topology_.id()
-        }
-    } );
+    bindLOD();
 }
 
 void LightViz::DrawComponentLViz::sync(
     const CameraVision& vision
 ) /* overriden */ {
-    transformApplyer_.setTransform(
-        vision.viewTrans() * vision.projTrans()
+    // the camera's transform is bound by the renderer once per frame.
+    // the level is bound by the renderer's sync which follows.
+    lod_.select( LODSelector::projectedRadius(
+        bounds().value(), vision.viewTrans(), vision.projTrans()
+    ) );
+}
+
+std::optional<BoundingSphere> LightViz::DrawComponentLViz::bounds() const
+/* overriden */ {
+    // the tesselated sphere is of unit radius.
+    const auto local = BoundingSphere{
+        .center = dx::XMFLOAT3(0.f, 0.f, 0.f),
+        .radius = 1.f
+    };
+
+    return local.transformed( transformGPUMapper_.transform().get() );
+}
+
+void LightViz::DrawComponentLViz::bindLOD() {
+    const auto level = lod_.level();
+
+    static_cast<MyDrawCaller&>( this->drawCaller() ).setNumIndex(
+        static_cast<UINT>( MyIndexBuffer::size(level) )
     );
+
+    this->setRODesc( RenderObjectDesc{
+        .header = RenderObjectDesc::Header{
+            .IDBuffer = vBufs_[level].id(),
+            .IDType = typeid(*this),
+            .denseType = denseTypeIndex<DrawComponentLViz>()
+        },
+        .IDs = {
+            vBufs_[level].id(), iBufs_[level].id(), colorCBuf_.id()
+        }
+    } );
 }
 
 void LightViz::DrawComponentLViz::swap(
@@ -325,8 +378,6 @@ void LightViz::DrawComponentLViz::swap(
 ) {
     auto rhsR = rhs.reflect();
     reflect().swap(rhsR);
-    transformApplyer_.linkMapper(transformGPUMapper_);
-    rhs.transformApplyer_.linkMapper(rhs.transformGPUMapper_);
 #ifdef ACTIVATE_DRAWCOMPONENT_LOG
     logComponent_.setLogSrc(this);
     rhs.logComponent_.setLogSrc(&rhs);
@@ -4,9 +4,17 @@
 #include "GFX/PipelineObjects/PipelineObject.hpp"
 
 #include "GFX/Core/CMDLogger.hpp"
+#include "GFX/Core/UploadRing.hpp"
+
+#include "ThreadPool.hpp"
 
 #include <ranges>
 #include <algorithm>
+#include <utility>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <future>
 
 #include "ShaderPath.h"
 
@@ -26,47 +34,342 @@ void Renderer::LogComponent::entryStackPop() noexcept {
 }
 #endif  // ACTIVATE_RENDERER_LOG
 
+// replays recorded commands onto the renderer's pipeline.
+class Renderer::PipelineBackend : public IGFXCommandBackend {
+public:
+    PipelineBackend(Renderer& renderer, const RendererDesc& desc) noexcept
+        : renderer_(renderer),
+        slotInstanceBuffer_( static_cast<UINT>(desc.slotInstanceBuffer) ) {}
+
+    void bind(SlotMapKey id) override {
+        renderer_.pipeline_.bind( renderer_.pStorage_->get(id).value() );
+    }
+
+    void draw(const po::BasicDrawCaller& drawCaller) override {
+        renderer_.pipeline_.drawCall(drawCaller);
+    }
+
+    void drawInstanced( const po::BasicDrawCaller& drawCaller,
+        std::uint32_t nInstance, std::span<const std::byte> instances
+    ) override {
+        auto& instanceBuffer = renderer_.instanceBuffer_;
+
+        if ( !instanceBuffer.has_value()
+            || instanceBuffer->capacity() < nInstance
+        ) [[unlikely]] {
+            instanceBuffer.emplace( renderer_.factory_,
+                std::bit_ceil( static_cast<std::size_t>(nInstance) )
+            );
+            instanceBuffer->setSlot(slotInstanceBuffer_);
+        }
+
+        // payloads are aligned, so the instances are read in place.
+        instanceBuffer->update( renderer_.pipeline_,
+            std::span<const InstanceTransforms>(
+                reinterpret_cast<const InstanceTransforms*>( instances.data() ),
+                nInstance
+            )
+        );
+
+        renderer_.pipeline_.bind( &instanceBuffer.value() );
+        renderer_.pipeline_.drawCallInstanced(drawCaller, nInstance);
+    }
+
+private:
+    Renderer& renderer_;
+    UINT slotInstanceBuffer_;
+};
+
+// runs the draw contexts of recorded draws ahead of the replay,
+// for their constants to be uploaded at once. touches no state.
+class Renderer::StagingBackend : public IGFXCommandBackend {
+public:
+    explicit StagingBackend(Renderer& renderer) noexcept
+        : renderer_(renderer) {}
+
+    void bind(SlotMapKey) override {}
+
+    void draw(const po::BasicDrawCaller& drawCaller) override {
+        renderer_.pipeline_.stageDrawCall(drawCaller);
+    }
+
+    // instances come from the instance buffer, not from draw contexts.
+    void drawInstanced( const po::BasicDrawCaller&, std::uint32_t,
+        std::span<const std::byte>
+    ) override {}
+
+private:
+    Renderer& renderer_;
+};
+
+namespace {
+
+// shared by every renderer, as they render one after another.
+ThreadPool& recordWorkers() {
+    static auto workers = ThreadPool();
+    return workers;
+}
+
+}   // namespace
+
 void Renderer::render(Scene& scene) {
+    const auto desc = rendererDesc();
+    const auto frustum = Frustum( scene.vision().viewProjTrans() );
+    syncFrame( scene.vision() );
+    auto& layers = scene.layers();
+
+    layerRecordings_.resize( layers.size() );
+
+    const auto recordLayer = [&](std::size_t idx) {
+        layerRecordings_[idx].cmds.clear();
+        record( desc, layers[idx], scene.vision(), frustum,
+            layerRecordings_[idx]
+        );
+    };
+
+    if (layers.size() < 2u) {
+        for (std::size_t idx = 0u; idx < layers.size(); ++idx) {
+            recordLayer(idx);
+        }
+    }
+    else {
+        auto recordings = std::vector< std::future<void> >();
+        recordings.reserve( layers.size() );
+
+        for (std::size_t idx = 0u; idx < layers.size(); ++idx) {
+            recordings.push_back( recordWorkers().submit(
+                [&recordLayer, idx]() { recordLayer(idx); }
+            ) );
+        }
+
+        // every recording must be over before a failure unwinds this frame.
+        std::ranges::for_each( recordings, [](auto& f) { f.wait(); } );
+        std::ranges::for_each( recordings, [](auto& f) { f.get(); } );
+    }
+
 #ifdef ACTIVATE_RENDERER_LOG
     logComponent().entryStackPush();
 #endif
 
-    std::ranges::for_each( std::move(rendererDesc().IDs),
-        [this](auto&& id) {
-            pipeline_.bind( mappedStorage().get(
-                std::forward<decltype(id)>(id)
-            ).value() );
+    // one map for every draw's constants, rather than one per draw.
+    if ( auto pRing = pipeline_.uploadRing() ) {
+        pRing->beginStaging();
+        auto staging = StagingBackend(*this);
+        std::ranges::for_each( layerRecordings_, [&staging](const auto& rec) {
+            rec.cmds.replay(staging);
+        } );
+        pRing->upload(pipeline_);
+    }
+
+    // replayed in layer order, as layers were drawn before.
+    auto backend = PipelineBackend(*this, desc);
+    std::ranges::for_each( layerRecordings_, [&backend](const auto& rec) {
+        rec.cmds.replay(backend);
+    } );
+
+#ifdef ACTIVATE_RENDERER_LOG
+    logComponent().entryStackPop();
+#endif
+}
+
+void Renderer::record( const RendererDesc& desc, Layer& layer,
+    const CameraVision& vision, const Frustum& frustum,
+    LayerRecording& recording
+) const {
+    auto& cmds = recording.cmds;
+
+    layer.setup();
+
+    std::ranges::for_each( layer.bindees(), [&cmds](GFXResView bindee) {
+        cmds.bind( bindee->id() );
+    } );
+
+    layer.refitBounds();
+    layer.cull(frustum, recording.visibleCmps);
+    occlude( vision.viewProjTrans(), recording );
+
+    // only what is drawn takes its IDs for this frame,
+    // rebuilding what the storage evicted, while the rest stays evicted.
+    // runs are found by looking ahead, so sync them all first.
+    std::ranges::for_each( recording.visibleCmps,
+        [this, &vision](RCDrawCmp* dc) {
+            dc->sync(vision);
+            dc->sync(*this);
         }
     );
+    sortByDepth( vision.viewProjTrans(), recording );
 
-    std::ranges::for_each( scene.layers(), [this, &scene](Layer& layer) {
-        layer.setup();
+    recording.lods = LODStats{};
+    for (const auto dc : recording.visibleCmps) {
+        if ( const auto level = dc->lodLevel() ) {
+            recording.lods.count( level.value() );
+        }
+    }
 
-        std::ranges::for_each( layer.bindees(), [&](GFXResView bindee) {
-            pipeline_.bind( &bindee->get() );
-        } );
+    recordDrawRuns( desc, std::span<RCDrawCmp* const>(recording.visibleCmps),
+        minInstanceRun, recording.instances, cmds
+    );
+}
 
-        std::ranges::for_each( layer.drawCmps(), [&](auto& dc) {
-            dc.sync(*this);
-            dc.sync(scene.vision());
+void Renderer::occlude(const Transform& viewProj, LayerRecording& recording) {
+    auto& visibleCmps = recording.visibleCmps;
+    auto& occluders = recording.occluders;
+    recording.nOccluded = 0u;
+
+    occluders.clear();
+    for (const auto dc : visibleCmps) {
+        const auto bounds = dc->bounds();
+        const auto occluder = dc->occluder();
+        if ( !bounds.has_value() || !occluder.has_value() ) {
+            continue;
+        }
 
-            auto IDs = std::move(dc.renderObjectDesc().IDs);
+        const auto center = dx::XMVector3Transform(
+            dx::XMLoadFloat3(&bounds->center), viewProj.get()
+        );
+        const auto depth = dx::XMVectorGetW(center);
+        if (depth > 0.f) {
+            occluders.push_back( Occluder{
+                .extent = bounds->radius / depth,
+                .world = occluder.value()
+            } );
+        }
+    }
 
-            std::ranges::for_each(IDs,
-                [&](auto&& id) {
-                    pipeline_.bind(pStorage_->get(
-                        std::forward<decltype(id)>(id)
-                    ).value() );
+    if ( occluders.empty() ) {
+        return;
+    }
+
+    const auto nOccluder = std::min(maxOccluders, occluders.size());
+    std::ranges::partial_sort( occluders, occluders.begin() + nOccluder,
+        std::ranges::greater(), &Occluder::extent
+    );
+
+    auto& occlusion = recording.occlusion;
+    occlusion.clear(viewProj);
+    for (std::size_t i = 0u; i < nOccluder; ++i) {
+        occlusion.rasterizeBox( occluders[i].world );
+    }
+
+    const auto nVisible = visibleCmps.size();
+    std::erase_if( visibleCmps, [&occlusion](const RCDrawCmp* dc) {
+        const auto bounds = dc->bounds();
+        return bounds.has_value()
+            && !occlusion.visible( BoundingBox::enclosing( bounds.value() ) );
+    } );
+    recording.nOccluded = nVisible - visibleCmps.size();
+}
+
+void Renderer::sortByDepth( const Transform& viewProj,
+    LayerRecording& recording
+) {
+    auto& visibleCmps = recording.visibleCmps;
+    auto& entries = recording.depthEntries;
+
+    // culled in the layer's order, so already sorted by key,
+    // only runs of equal keys are left to order.
+    for (std::size_t first = 0u; first < visibleCmps.size(); ) {
+        const auto key = visibleCmps[first]->sortKey();
+        auto last = first + 1u;
+        while ( last < visibleCmps.size() && visibleCmps[last]->sortKey() == key ) {
+            ++last;
+        }
+
+        if (last - first > 1u) {
+            entries.clear();
+            for (std::size_t i = first; i < last; ++i) {
+                const auto dc = visibleCmps[i];
+                // unbounded components are taken as lying at the near plane.
+                auto viewDepth = 0.f;
+                if ( const auto bounds = dc->bounds() ) {
+                    viewDepth = dx::XMVectorGetW( dx::XMVector3Transform(
+                        dx::XMLoadFloat3(&bounds->center), viewProj.get()
+                    ) );
                 }
+
+                entries.push_back( DepthEntry{
+                    .viewDepth = viewDepth,
+                    .drawCmp = dc
+                } );
+            }
+
+            std::ranges::sort( entries, std::ranges::less(),
+                &DepthEntry::viewDepth
             );
+            for (std::size_t i = first; i < last; ++i) {
+                visibleCmps[i] = entries[i - first].drawCmp;
+            }
+        }
 
-            pipeline_.drawCall(dc.drawCaller());
-        } );
-    } );
+        first = last;
+    }
+}
 
-#ifdef ACTIVATE_RENDERER_LOG
-    logComponent().entryStackPop();
-#endif
+GFXRes Renderer::makePipelineState( GFXRes& vertexShader,
+    GFXRes& pixelShader, po::PipelineStateDesc desc
+) {
+    vertexShader.pin();
+    pixelShader.pin();
+
+    const auto word = [](const GFXStorage::ID& id) {
+        return static_cast<std::uint64_t>(id.index) << 32u | id.generation;
+    };
+    // D3D11 returns the same state object for equal descs,
+    // so states are told apart by address, held by the object.
+    const auto address = [](const auto& pState) {
+        return reinterpret_cast<std::uintptr_t>( pState.Get() );
+    };
+
+    const auto& viewport = desc.viewport;
+    const auto key = GFXContentKey::make<po::PipelineStateObject>(
+        word( vertexShader.id() ), word( pixelShader.id() ),
+        static_cast<std::uint64_t>(desc.topology),
+        GFXBindKey::pack(viewport.TopLeftX, viewport.TopLeftY),
+        GFXBindKey::pack(viewport.Width, viewport.Height),
+        GFXBindKey::pack(viewport.MinDepth, viewport.MaxDepth),
+        address(desc.pRasterizerState), address(desc.pBlendState),
+        address(desc.pDepthStencilState)
+    );
+
+    auto ret = GFXRes::makeShared<po::PipelineStateObject>( mappedStorage(),
+        key, vertexShader.as<po::VertexShader>(),
+        pixelShader.as<po::PixelShader>(), std::move(desc)
+    );
+    ret.pin();
+
+    return ret;
+}
+
+const RendererDesc Renderer::rendererDesc() const {
+    return RendererDesc{
+            .header = {
+                .IDVertexShader = vertexShader_.id(),
+                .IDPixelShader = pixelShader_.id(),
+                .IDType = typeid(*this)
+            },
+            .IDs = {
+                pipelineState_.id(), cameraCBuf_.id()
+            },
+            .instancedIDs = instancedPipelineState_.has_value()
+                ? GFXIDList{ instancedPipelineState_->id(), cameraCBuf_.id() }
+                : GFXIDList{},
+            .slotInstanceBuffer = slotInstanceBuffer_
+        };
+}
+
+void Renderer::syncFrame(const CameraVision& vision) {
+    updateCamera_( cameraCBuf_, pipeline_, vision );
+}
+
+ViewProjCBuf::ViewProjCBuf(GFXFactory factory)
+    : VSCBuffer<dx::XMMATRIX>( std::move(factory), D3D11_USAGE_DYNAMIC,
+        D3D11_CPU_ACCESS_WRITE, std::ranges::single_view( dx::XMMatrixIdentity() )
+    ) {}
+
+// transposed for the shaders.
+void ViewProjCBuf::update(GFXPipeline& pipeline, const CameraVision& vision) {
+    const auto viewProj = vision.viewProjTrans().transpose();
+    dynamicUpdate( pipeline, [&viewProj]() { return viewProj.data(); } );
 }
 
 SolidRenderer::MyVertexShader::MyVertexShader(GFXFactory factory)
@@ -99,25 +402,12 @@ SolidRenderer::MyPixelShader::csoPath() const noexcept {
     return compiledShaderPath/L"PixelShaderSolid.cso";
 }
 
-const RendererDesc SolidRenderer::rendererDesc() const {
-    return RendererDesc{
-            .header = {
-                .IDVertexShader = vertexShader_.id(),
-                .IDPixelShader = pixelShader_.id(),
-                .IDType = typeid(*this)
-            },
-            .IDs = {
-                vertexShader_.id(), pixelShader_.id()
-            }
-        };
-}
-
 void SolidRenderer::loadBindables(GFXFactory factory) {
-    vertexShader_ = GFXRes::makeCached<MyVertexShader>(
-        mappedStorage(), tagVertexShader, factory
-    );
-    pixelShader_ = GFXRes::makeCached<MyPixelShader>(
-        mappedStorage(), tagPixelShader, factory
+    loadPipeline<MyVertexShader, MyPixelShader, ViewProjCBuf>( factory,
+        po::PipelineStateDesc{
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .viewport = viewport()
+        }, slotCameraCBuffer()
     );
 }
 
@@ -151,25 +441,12 @@ IndexedRenderer::MyPixelShader::csoPath() const noexcept {
     return compiledShaderPath/L"PixelShaderIndexed.cso";
 }
 
-const RendererDesc IndexedRenderer::rendererDesc() const {
-    return RendererDesc{
-            .header = {
-                .IDVertexShader = vertexShader_.id(),
-                .IDPixelShader = pixelShader_.id(),
-                .IDType = typeid(*this)
-            },
-            .IDs = {
-                vertexShader_.id(), pixelShader_.id()
-            }
-        };
-}
-
 void IndexedRenderer::loadBindables(GFXFactory factory) {
-    vertexShader_ = GFXRes::makeCached<MyVertexShader>(
-        mappedStorage(), tagVertexShader, factory
-    );
-    pixelShader_ = GFXRes::makeCached<MyPixelShader>(
-        mappedStorage(), tagPixelShader, factory
+    loadPipeline<MyVertexShader, MyPixelShader, ViewProjCBuf>( factory,
+        po::PipelineStateDesc{
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .viewport = viewport()
+        }, slotCameraCBuffer()
     );
 }
 
@@ -211,25 +488,12 @@ BlendedRenderer::MyPixelShader::csoPath() const noexcept {
     return compiledShaderPath/L"PixelShaderBlended.cso";
 }
 
-const RendererDesc BlendedRenderer::rendererDesc() const {
-    return RendererDesc{
-            .header = {
-                .IDVertexShader = vertexShader_.id(),
-                .IDPixelShader = pixelShader_.id(),
-                .IDType = typeid(*this)
-            },
-            .IDs = {
-                vertexShader_.id(), pixelShader_.id()
-            }
-        };
-}
-
 void BlendedRenderer::loadBindables(GFXFactory factory) {
-    vertexShader_ = GFXRes::makeCached<MyVertexShader>(
-        mappedStorage(), tagVertexShader, factory
-    );
-    pixelShader_ = GFXRes::makeCached<MyPixelShader>(
-        mappedStorage(), tagPixelShader, factory
+    loadPipeline<MyVertexShader, MyPixelShader, ViewProjCBuf>( factory,
+        po::PipelineStateDesc{
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .viewport = viewport()
+        }, slotCameraCBuffer()
     );
 }
 
@@ -271,25 +535,12 @@ TexturedRenderer::MyPixelShader::csoPath() const noexcept {
     return compiledShaderPath/L"PixelShaderTextured.cso";
 }
 
-const RendererDesc TexturedRenderer::rendererDesc() const {
-    return RendererDesc{
-            .header = {
-                .IDVertexShader = vertexShader_.id(),
-                .IDPixelShader = pixelShader_.id(),
-                .IDType = typeid(*this)
-            },
-            .IDs = {
-                vertexShader_.id(), pixelShader_.id()
-            }
-        };
-}
-
 void TexturedRenderer::loadBindables(GFXFactory factory) {
-    vertexShader_ = GFXRes::makeCached<MyVertexShader>(
-        mappedStorage(), tagVertexShader, factory
-    );
-    pixelShader_ = GFXRes::makeCached<MyPixelShader>(
-        mappedStorage(), tagPixelShader, factory
+    loadPipeline<MyVertexShader, MyPixelShader, ViewProjCBuf>( factory,
+        po::PipelineStateDesc{
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .viewport = viewport()
+        }, slotCameraCBuffer()
     );
 }
 
@@ -323,6 +574,79 @@ BPhongRenderer::MyVertexShader::csoPath() const noexcept {
     return compiledShaderPath/L"VertexShaderBPhong.cso";
 }
 
+BPhongRenderer::MyInstancedVertexShader::MyInstancedVertexShader(
+    GFXFactory factory
+) : VertexShader(factory, inputElemDescs(), csoPath()) {}
+
+std::vector<D3D11_INPUT_ELEMENT_DESC>
+BPhongRenderer::MyInstancedVertexShader::inputElemDescs() const noexcept {
+    auto ret = std::vector<D3D11_INPUT_ELEMENT_DESC>{
+        { .SemanticName = "Position",
+            .SemanticIndex = 0,
+            .Format = DXGI_FORMAT_R32G32B32_FLOAT,
+            .InputSlot = 0,
+            .AlignedByteOffset = 0,
+            .InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA,
+            .InstanceDataStepRate = 0
+        },
+        { .SemanticName = "Normal",
+            .SemanticIndex = 0,
+            .Format = DXGI_FORMAT_R32G32B32_FLOAT,
+            .InputSlot = 1u,
+            .AlignedByteOffset = 0,
+            .InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA,
+            .InstanceDataStepRate = 0
+        }
+    };
+
+    // a matrix takes a row per semantic index.
+    const auto addMatrix = [&ret]( const char* semanticName,
+        std::size_t offset
+    ) {
+        for (UINT row = 0u; row < 4u; ++row) {
+            ret.push_back( D3D11_INPUT_ELEMENT_DESC{
+                .SemanticName = semanticName,
+                .SemanticIndex = row,
+                .Format = DXGI_FORMAT_R32G32B32A32_FLOAT,
+                .InputSlot = slotInstanceBuffer(),
+                .AlignedByteOffset = static_cast<UINT>(
+                    offset + row * sizeof(dx::XMFLOAT4)
+                ),
+                .InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA,
+                .InstanceDataStepRate = 1u
+            } );
+        }
+    };
+    addMatrix( "World", offsetof(InstanceTransforms, world) );
+
+    return ret;
+}
+
+std::filesystem::path
+BPhongRenderer::MyInstancedVertexShader::csoPath() const noexcept {
+    return compiledShaderPath/L"VertexShaderBPhongInstanced.cso";
+}
+
+BPhongRenderer::MyCameraCBuf::MyCameraCBuf(GFXFactory factory)
+    : VSCBuffer<CameraConstants>( std::move(factory), D3D11_USAGE_DYNAMIC,
+        D3D11_CPU_ACCESS_WRITE, std::ranges::single_view( CameraConstants{
+            .view = dx::XMMatrixIdentity(),
+            .viewProj = dx::XMMatrixIdentity()
+        } )
+    ) {}
+
+// mapped once per frame, draws only upload their world transforms.
+void BPhongRenderer::MyCameraCBuf::update( GFXPipeline& pipeline,
+    const CameraVision& vision
+) {
+    const auto constants = CameraConstants{
+        .view = vision.viewTrans().transpose().get(),
+        .viewProj = vision.viewProjTrans().transpose().get()
+    };
+
+    dynamicUpdate( pipeline, [&constants]() { return &constants; } );
+}
+
 BPhongRenderer::MyPixelShader::MyPixelShader(GFXFactory factory)
     : PixelShader(factory, csoPath()) {}
 
@@ -331,25 +655,16 @@ BPhongRenderer::MyPixelShader::csoPath() const noexcept {
     return compiledShaderPath/L"PixelShaderBPhong.cso";
 }
 
-const RendererDesc BPhongRenderer::rendererDesc() const {
-    return RendererDesc{
-            .header = {
-                .IDVertexShader = vertexShader_.id(),
-                .IDPixelShader = pixelShader_.id(),
-                .IDType = typeid(*this)
-            },
-            .IDs = {
-                vertexShader_.id(), pixelShader_.id()
-            }
-        };
-}
-
 void BPhongRenderer::loadBindables(GFXFactory factory) {
-    vertexShader_ = GFXRes::makeCached<MyVertexShader>(
-        mappedStorage(), tagVertexShader, factory
+    const auto stateDesc = po::PipelineStateDesc{
+        .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+        .viewport = viewport()
+    };
+    loadPipeline<MyVertexShader, MyPixelShader, MyCameraCBuf>( factory,
+        stateDesc, slotCameraCBuffer()
     );
-    pixelShader_ = GFXRes::makeCached<MyPixelShader>(
-        mappedStorage(), tagPixelShader, factory
+    loadInstancedPipeline<MyInstancedVertexShader>( factory, stateDesc,
+        slotInstanceBuffer()
     );
 }
 
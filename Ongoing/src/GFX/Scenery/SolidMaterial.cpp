@@ -9,8 +9,8 @@ SolidMaterial::SolidMaterial(GFXFactory factory, GFXStorage& storage)
 SolidMaterial::SolidMaterial( GFXFactory factory, GFXStorage& storage,
     const SolidMaterialDesc& matDesc
 ) : matDesc_(matDesc),
-    cbuf_( std::move(factory), D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE,
-        std::ranges::single_view(matDesc_)
+    cbuf_( matDesc_, std::move(factory), D3D11_USAGE_DYNAMIC,
+        D3D11_CPU_ACCESS_WRITE, std::ranges::single_view(matDesc_)
     ) {}
 
 const SolidMaterialDesc SolidMaterial::defMatDesc() noexcept {
@@ -28,7 +28,7 @@ void SolidMaterial::bind(GFXPipeline& pipeline) /* overriden */ {
     // it is handled in PSCBuffer internally
     pipeline.bind(&cbuf_);
 
-    cbuf_.dynamicUpdate( pipeline, [this](){ return &matDesc_; } );
+    cbuf_.update(pipeline, matDesc_);
 }
 
 }   // namespace gfx::scenery
@@ -1,7 +1,8 @@
 #include "GFX/Scenery/TransformDrawContexts.hpp"
 #include "GFX/PipelineObjects/Buffer.hpp"
+#include "GFX/Core/UploadRing.hpp"
 
-#include <numeric>
+#include <span>
 
 namespace gfx {
 namespace scenery {
@@ -10,33 +11,34 @@ void MapTransformGPU::beforeDrawCall(GFXPipeline& pipeline) {
     assert( IDTransCBuf_.has_value() );
     assert( mappedStorage_->get(IDTransCBuf_.value()).has_value() );
 
-    auto transCBuf = static_cast< po::CBuffer<MatrixType>* >(
+    auto transCBuf = static_cast< po::VSCBuffer<MatrixType>* >(
         mappedStorage_->get(IDTransCBuf_.value()).value()
     );
 
-    // to avoid dangling pointer issue
-    // caused by following lambda returning the raw address of it,
-    // accumulated transform should be declared here.
-    auto accumulated = Transform();
-
-    transCBuf->dynamicUpdate( pipeline, [this, &accumulated](){
-        accumulated = std::accumulate( applyees_.begin(), applyees_.end(),
-            transform_, [](Transform lhs, const Transform& rhs) {
-                return lhs * rhs;
-            }
-        );
-
-        accumulated = accumulated.transpose();
-        return accumulated.data();
+    // staged before the frame is drawn, bound at its offset when drawn.
+    if ( auto pRing = pipeline.uploadRing() ) {
+        if ( pRing->staging() ) {
+            const auto transposed = transform_.transpose();
+            pRing->stage( std::as_bytes(
+                std::span<const MatrixType>( transposed.data(), 1u )
+            ) );
+            return;
+        }
+
+        if ( const auto alloc = pRing->take() ) {
+            pRing->bindVS( pipeline, transCBuf->slot(), alloc.value() );
+            return;
+        }
+    }
+
+    // drawn without being staged.
+    const auto transposed = transform_.transpose();
+    transCBuf->dynamicUpdate( pipeline, [&transposed](){
+        return transposed.data();
     } );
-}
-
-void ApplyTransform::beforeDrawCall(GFXPipeline& pipeline) {
-    mapper_->pushBackApplyee(transform_);
-}
 
-void ApplyTransform::afterDrawCall(GFXPipeline& pipeline) {
-    mapper_->popBackApplyee();
+    // left out of draws' IDs, the ring may hold the slot instead.
+    pipeline.bind(transCBuf);
 }
 
 }   // namespace gfx::scenery
@@ -3,6 +3,7 @@
 #include "Game/IlluminatedBox.hpp"
 
 #include "GFX/Core/CMDLogger.hpp"
+#include "GFX/Core/PayloadCache.hpp"
 #include "GFX/Scenery/CMDLogGUIView.hpp"
 #include "GFX/Scenery/CMDLogFileView.hpp"
 
@@ -16,12 +17,26 @@ GDIPlusManager gdipm;
 
 Game::Game(const ChiliWindow& wnd, gfx::Graphics& gfx,
     Keyboard<MyChar>& kbd, Mouse& mouse
-) : rendererSystem_( gfx.factory(), gfx.pipeline() ),
+) : rendererSystem_( gfx.factory(), gfx.pipeline(), wnd.client() ),
+    slotBPhongRenderer_(
+        rendererSystem_.addRenderer<gfx::scenery::BPhongRenderer>()
+    ),
+    slotSolidRenderer_(
+        rendererSystem_.addRenderer<gfx::scenery::SolidRenderer>()
+    ),
     inputSystem_( kbd, mouse, wnd.client() ),
     coordSystem_(), timer_(), camera_(),
     cameraControl_(), entities_(), light_(),
     pointLightControl_(),
-    simulationUI_(), ic_( std::make_shared<MyIC>() ) {
+    simulationUI_(), ic_( std::make_shared<MyIC>() ),
+    mouseIC_( std::make_shared<MyMouseIC>( inputSystem_.mousePointConverter() ) ) {
+
+    // geometry generated by the last run is mapped instead of recomputed.
+    GFXPAYLOADCACHE.open("GFXPayload.cache");
+    rendererSystem_.storage().setBudget(resourceBudget);
+
+    // prepare heavy geometry on workers while renderers are set up.
+    gfx::scenery::LightViz::prefetch( gfx.factory(), rendererSystem_.storage() );
 
     camera_.setParams(dx::XM_PIDIV2, 1.f, 0.5f, 40.f);
     camera_.attach(coordSystem_);
@@ -30,37 +45,41 @@ Game::Game(const ChiliWindow& wnd, gfx::Graphics& gfx,
     );
     cameraControl_.show();
 
-    auto slotBPhongRenderer = rendererSystem_
-        .addRenderer<gfx::scenery::BPhongRenderer>();
-    rendererSystem_.enableLog(slotBPhongRenderer);
-    rendererSystem_.sync(slotBPhongRenderer);
-    rendererSystem_.scene(slotBPhongRenderer).setVision( camera_.vision() );
-    rendererSystem_.scene(slotBPhongRenderer).addLayer();
+    rendererSystem_.enableLog(slotBPhongRenderer_);
+    rendererSystem_.sync(slotBPhongRenderer_);
+    rendererSystem_.scene(slotBPhongRenderer_).setVision( camera_.vision() );
+    rendererSystem_.scene(slotBPhongRenderer_).addLayer();
 
-    auto slotSolidRenderer = rendererSystem_
-        .addRenderer<gfx::scenery::SolidRenderer>();
-    rendererSystem_.enableLog(slotSolidRenderer);
-    rendererSystem_.sync(slotSolidRenderer);
-    rendererSystem_.scene(slotSolidRenderer).setVision( camera_.vision() );
+    rendererSystem_.enableLog(slotSolidRenderer_);
+    rendererSystem_.sync(slotSolidRenderer_);
+    rendererSystem_.scene(slotSolidRenderer_).setVision( camera_.vision() );
 
     light_.ctLuminance(gfx.factory(), rendererSystem_.storage());
     light_.luminance().loader().loadAt(
-        rendererSystem_.adapt<gfx::scenery::LSceneAdapter>(slotBPhongRenderer)
+        rendererSystem_.adapt<gfx::scenery::LSceneAdapter>(slotBPhongRenderer_)
     );
     light_.luminance().loader().loadAt(coordSystem_);
-    light_.luminance().sync(rendererSystem_.renderer(slotBPhongRenderer));
-    light_.ctViz(gfx.factory(), rendererSystem_.storage(), wnd.client());
-    light_.viz().loader().loadAt(rendererSystem_.scene(slotSolidRenderer).layer(0));
+    light_.luminance().sync(rendererSystem_.renderer(slotBPhongRenderer_));
+    rendererSystem_.storage().waitAsync();
+    light_.ctViz(gfx.factory(), rendererSystem_.storage());
+    light_.viz().loader().loadAt(rendererSystem_.scene(slotSolidRenderer_).layer(0));
 
     inputSystem_.setListner(ic_);
+    inputSystem_.setListner(mouseIC_);
+    GFXCMDLOG_GUIVIEW.watch( rendererSystem_.storage() );
+    GFXCMDLOG_GUIVIEW.watch( gfx.pipeline() );
 
     coordSystem_.traverse();
 
     createObjects(80u, wnd, gfx, kbd, mouse);
+
+    GFXPAYLOADCACHE.save();
 }
 
 Game::~Game() {
     coordSystem_.destroyCascade();
+    // keeps payloads generated later, e.g. by reconstruction.
+    GFXPAYLOADCACHE.save();
 }
 
 void Game::update() {
@@ -79,6 +98,7 @@ void Game::update() {
     camera_.update();
 
     updateEntities(elapsed);
+    pick();
 
     // coord systems may be changed during updating entities,
     // so update coord system once more.
@@ -87,6 +107,13 @@ void Game::update() {
 
 void Game::render() {
     rendererSystem_.render();
+    simulationUI_.setOccludedDraws(
+        rendererSystem_.renderer(slotBPhongRenderer_).nOccludedDraws()
+    );
+    // the light's visualization is drawn by the solid renderer.
+    simulationUI_.setLODStats(
+        rendererSystem_.renderer(slotSolidRenderer_).lodStats()
+    );
     simulationUI_.render();
     cameraControl_.render();
     pointLightControl_.render();
@@ -107,6 +134,28 @@ void Game::updateEntities(milliseconds elapsed) {
     }
 }
 
+void Game::pick() {
+    const auto pt = mouseIC_->consumePressed();
+    if ( !pt.has_value() ) {
+        return;
+    }
+
+    // mouse points are converted to normalized device coordinates.
+    const auto& vision = camera_.vision();
+    const auto ray = gfx::scenery::Ray::unproject(
+        vision.viewProjTrans(), pt->x, pt->y
+    );
+
+    // boxes live in the mesh layer of the Blinn-Phong renderer's scene.
+    const auto picked = rendererSystem_
+        .adapt<gfx::scenery::LSceneAdapter>(slotBPhongRenderer_)
+        .meshLayer().pick(ray);
+
+    simulationUI_.setPicked( picked.has_value()
+        ? std::optional<float>( picked->distance ) : std::nullopt
+    );
+}
+
 void Game::createObjects(std::size_t n, const ChiliWindow& wnd,
     gfx::Graphics& gfx, Keyboard<MyChar>& kbd, Mouse& mouse
 ) {
@@ -132,7 +181,9 @@ void Game::createIlBox( Distribution distRadius,
     );
     obj->ctTransformComponent(distRadius, distCTP, distDeltaCTP, distDeltaRTY);
 
-    obj->loader().loadAt( rendererSystem_.adapt<gfx::scenery::LSceneAdapter>(0u) );
+    obj->loader().loadAt(
+        rendererSystem_.adapt<gfx::scenery::LSceneAdapter>(slotBPhongRenderer_)
+    );
 
     entities_.push_back( std::move(obj) );
 }
\ No newline at end of file
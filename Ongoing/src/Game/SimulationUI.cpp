@@ -10,6 +10,23 @@ void SimulationUI::render() {
     if ( ImGui::Begin( "Simulation Speed", &willShow_ ) ) {
         ImGui::SliderFloat( "Speed Factor", &speedFactor_, 0.f, 4.f );
         ImGui::InputText("Butts", buffer_, 1024u);
+
+        if (picked_.has_value()) {
+            ImGui::Text( "Picked at %.2f", picked_.value() );
+        }
+        else {
+            ImGui::Text("Picked nothing");
+        }
+
+        ImGui::Text( "Occluded Draws: %zu", nOccludedDraws_ );
+
+        for (std::size_t level = 0u; level < lodStats_.nDraws.size(); ++level) {
+            if (lodStats_.nDraws[level]) {
+                ImGui::Text( "LOD %zu Draws: %zu", level,
+                    lodStats_.nDraws[level]
+                );
+            }
+        }
     }
 
     ImGui::End();
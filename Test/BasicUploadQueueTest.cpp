@@ -0,0 +1,195 @@
+#include <vector>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Core/BasicUploadQueue.hpp"
+
+namespace {
+
+// destinations are told apart by address, as buffers are.
+using Dest = std::shared_ptr<int>;
+using Queue = gfx::GFXBasicUploadQueue<Dest>;
+
+struct Write {
+    Dest dest;
+    std::size_t offset;
+    std::vector<std::byte> bytes;
+};
+
+std::vector<std::byte> makeBytes(std::size_t size, unsigned char value) {
+    return std::vector<std::byte>( size, std::byte(value) );
+}
+
+std::vector<Write> flush(Queue& queue) {
+    auto ret = std::vector<Write>();
+    queue.flush( [&ret]( const Dest& dest, std::size_t offset,
+        std::span<const std::byte> bytes
+    ) {
+        ret.push_back( Write{
+            .dest = dest,
+            .offset = offset,
+            .bytes = std::vector<std::byte>( bytes.begin(), bytes.end() )
+        } );
+    } );
+    return ret;
+}
+
+// bytes [first, last) of a write all hold value.
+bool holds( const Write& write, std::size_t first, std::size_t last,
+    unsigned char value
+) {
+    return std::all_of( write.bytes.begin() + first, write.bytes.begin() + last,
+        [value](std::byte b) { return b == std::byte(value); }
+    );
+}
+
+const Write* writeAt(const std::vector<Write>& writes, std::size_t offset) {
+    const auto it = std::ranges::find( writes, offset, &Write::offset );
+    return it != writes.end() ? &*it : nullptr;
+}
+
+}   // namespace
+
+TEST(BasicUploadQueue, OverlappingWritesMerge)
+{
+    auto queue = Queue();
+    const auto dest = std::make_shared<int>();
+
+    queue.stage( dest, 0u, makeBytes(16u, 1u) );
+    queue.stage( dest, 8u, makeBytes(16u, 2u) );
+    const auto writes = flush(queue);
+
+    ASSERT_EQ(writes.size(), 1u);
+    EXPECT_EQ(writes[0].dest, dest);
+    EXPECT_EQ(writes[0].offset, 0u);
+    ASSERT_EQ(writes[0].bytes.size(), 24u);
+    EXPECT_TRUE( holds(writes[0], 0u, 8u, 1u) );
+    // the later write wins.
+    EXPECT_TRUE( holds(writes[0], 8u, 24u, 2u) );
+    EXPECT_TRUE( queue.empty() );
+}
+
+TEST(BasicUploadQueue, AdjacentWritesMerge)
+{
+    auto queue = Queue();
+    const auto dest = std::make_shared<int>();
+
+    queue.stage( dest, 16u, makeBytes(16u, 2u) );
+    queue.stage( dest, 0u, makeBytes(16u, 1u) );
+    // apart from both, stays on its own.
+    queue.stage( dest, 48u, makeBytes(8u, 3u) );
+    const auto writes = flush(queue);
+
+    ASSERT_EQ(writes.size(), 2u);
+    const auto merged = writeAt(writes, 0u);
+    ASSERT_NE(merged, nullptr);
+    ASSERT_EQ(merged->bytes.size(), 32u);
+    EXPECT_TRUE( holds(*merged, 0u, 16u, 1u) );
+    EXPECT_TRUE( holds(*merged, 16u, 32u, 2u) );
+
+    const auto apart = writeAt(writes, 48u);
+    ASSERT_NE(apart, nullptr);
+    EXPECT_EQ(apart->bytes.size(), 8u);
+}
+
+// a write touching several ranges joins them all into one.
+TEST(BasicUploadQueue, BridgingWriteJoinsRanges)
+{
+    auto queue = Queue();
+    const auto dest = std::make_shared<int>();
+
+    queue.stage( dest, 0u, makeBytes(8u, 1u) );
+    queue.stage( dest, 32u, makeBytes(8u, 2u) );
+    queue.stage( dest, 64u, makeBytes(8u, 3u) );
+    queue.stage( dest, 4u, makeBytes(32u, 4u) );
+    // within what is staged, the rest stays.
+    queue.stage( dest, 12u, makeBytes(4u, 5u) );
+    const auto writes = flush(queue);
+
+    ASSERT_EQ(writes.size(), 2u);
+    const auto merged = writeAt(writes, 0u);
+    ASSERT_NE(merged, nullptr);
+    ASSERT_EQ(merged->bytes.size(), 40u);
+    EXPECT_TRUE( holds(*merged, 0u, 4u, 1u) );
+    EXPECT_TRUE( holds(*merged, 4u, 12u, 4u) );
+    EXPECT_TRUE( holds(*merged, 12u, 16u, 5u) );
+    EXPECT_TRUE( holds(*merged, 16u, 36u, 4u) );
+    EXPECT_TRUE( holds(*merged, 36u, 40u, 2u) );
+
+    const auto apart = writeAt(writes, 64u);
+    ASSERT_NE(apart, nullptr);
+    EXPECT_TRUE( holds(*apart, 0u, 8u, 3u) );
+}
+
+TEST(BasicUploadQueue, SeparateDestinationsStaySeparate)
+{
+    auto queue = Queue();
+    const auto first = std::make_shared<int>();
+    const auto second = std::make_shared<int>();
+
+    queue.stage( first, 0u, makeBytes(16u, 1u) );
+    queue.stage( second, 0u, makeBytes(16u, 2u) );
+    const auto writes = flush(queue);
+
+    ASSERT_EQ(writes.size(), 2u);
+    EXPECT_NE(writes[0].dest, writes[1].dest);
+    for (const auto& write : writes) {
+        EXPECT_EQ(write.bytes.size(), 16u);
+        EXPECT_TRUE( holds( write, 0u, 16u, write.dest == first ? 1u : 2u ) );
+    }
+}
+
+// destinations are held until flushed, not after.
+TEST(BasicUploadQueue, ReleasesDestinationsOnFlush)
+{
+    auto queue = Queue();
+    const auto dest = std::make_shared<int>();
+
+    queue.stage( dest, 0u, makeBytes(16u, 1u) );
+    queue.stage( dest, 32u, makeBytes(16u, 2u) );
+    EXPECT_EQ(dest.use_count(), 3);
+
+    flush(queue);
+    EXPECT_EQ(dest.use_count(), 1);
+    EXPECT_TRUE( flush(queue).empty() );
+}
+
+TEST(BasicUploadQueue, Counters)
+{
+    auto queue = Queue();
+    const auto first = std::make_shared<int>();
+    const auto second = std::make_shared<int>();
+
+    // 3 writes, 2 once merged.
+    queue.stage( first, 0u, makeBytes(16u, 1u) );
+    queue.stage( first, 8u, makeBytes(16u, 2u) );
+    queue.stage( second, 0u, makeBytes(8u, 3u) );
+    flush(queue);
+
+    // nothing is closed until the frame is.
+    EXPECT_EQ(queue.frameCounters().nStaged, 0u);
+    queue.advanceFrame();
+
+    auto frame = queue.frameCounters();
+    EXPECT_EQ(frame.nStaged, 3u);
+    EXPECT_EQ(frame.nUpload, 2u);
+    EXPECT_EQ(frame.nByte, 24u + 8u);
+
+    queue.stage( second, 0u, makeBytes(64u, 4u) );
+    flush(queue);
+    queue.advanceFrame();
+
+    frame = queue.frameCounters();
+    EXPECT_EQ(frame.nStaged, 1u);
+    EXPECT_EQ(frame.nUpload, 1u);
+    EXPECT_EQ(frame.nByte, 64u);
+
+    const auto total = queue.totalCounters();
+    EXPECT_EQ(total.nStaged, 4u);
+    EXPECT_EQ(total.nUpload, 3u);
+    EXPECT_EQ(total.nByte, 24u + 8u + 64u);
+}
@@ -0,0 +1,160 @@
+#include <vector>
+#include <array>
+#include <thread>
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Core/CommandBuffer.hpp"
+#include "Timer.hpp"
+
+namespace {
+
+struct Instance {
+    float world[16];
+};
+
+// only the address of a draw caller is recorded, never read,
+// so a stand-in is enough where no device is available.
+const gfx::po::BasicDrawCaller& fakeDrawCaller(const void* address) {
+    return *static_cast<const gfx::po::BasicDrawCaller*>(address);
+}
+
+// what a layer records per draw: its bindings, then the draw.
+void recordDraws( gfx::GFXCommandBuffer& cmds, std::size_t first,
+    std::size_t last, const gfx::po::BasicDrawCaller& drawCaller
+) {
+    for (auto i = first; i < last; ++i) {
+        const auto idx = static_cast<SlotMapKey::Index>(i);
+        cmds.bind( SlotMapKey(idx, 0u) );
+        cmds.bind( SlotMapKey(idx, 1u) );
+        cmds.bind( SlotMapKey(idx, 2u) );
+        cmds.draw(drawCaller);
+    }
+}
+
+}   // namespace
+
+TEST(CommandBuffer, ReplayInRecordedOrder)
+{
+    const auto callers = std::array<std::uint64_t, 2u>{};
+    const auto& caller1 = fakeDrawCaller(&callers[0]);
+    const auto& caller2 = fakeDrawCaller(&callers[1]);
+
+    auto instances = std::vector<Instance>(3u);
+    for (std::size_t i = 0u; i < instances.size(); ++i) {
+        instances[i].world[0] = static_cast<float>(i);
+    }
+
+    auto cmds = gfx::GFXCommandBuffer();
+    cmds.bind( SlotMapKey(1u, 0u) );
+    cmds.draw(caller1);
+    cmds.bind( SlotMapKey(2u, 3u) );
+    cmds.drawInstanced<Instance>( caller2, instances );
+    EXPECT_EQ(cmds.commands().size(), 4u);
+
+    auto backend = gfx::GFXRecordingBackend();
+    cmds.replay(backend);
+
+    const auto& entries = backend.entries();
+    ASSERT_EQ(entries.size(), 4u);
+
+    EXPECT_EQ(entries[0].type, gfx::GFXCommandType::Bind);
+    EXPECT_EQ(entries[0].id, SlotMapKey(1u, 0u));
+
+    EXPECT_EQ(entries[1].type, gfx::GFXCommandType::Draw);
+    EXPECT_EQ(entries[1].pDrawCaller, &caller1);
+
+    EXPECT_EQ(entries[2].type, gfx::GFXCommandType::Bind);
+    EXPECT_EQ(entries[2].id, SlotMapKey(2u, 3u));
+
+    EXPECT_EQ(entries[3].type, gfx::GFXCommandType::DrawInstanced);
+    EXPECT_EQ(entries[3].pDrawCaller, &caller2);
+    EXPECT_EQ(entries[3].nInstance, 3u);
+    ASSERT_EQ(entries[3].bytes.size(), sizeof(Instance) * 3u);
+    const auto pInstances = reinterpret_cast<const Instance*>(
+        entries[3].bytes.data()
+    );
+    for (std::size_t i = 0u; i < instances.size(); ++i) {
+        EXPECT_EQ(pInstances[i].world[0], static_cast<float>(i));
+    }
+}
+
+TEST(CommandBuffer, PayloadsAligned)
+{
+    const auto caller = std::uint64_t(0u);
+    const auto oneByte = std::array<std::uint8_t, 1u>{ 0xffu };
+
+    auto cmds = gfx::GFXCommandBuffer();
+    cmds.drawInstanced<std::uint8_t>( fakeDrawCaller(&caller), oneByte );
+    cmds.drawInstanced<std::uint8_t>( fakeDrawCaller(&caller), oneByte );
+
+    for (const auto& command : cmds.commands()) {
+        EXPECT_EQ(command.payloadOffset % 16u, 0u);
+    }
+}
+
+TEST(CommandBuffer, ClearKeepsNothing)
+{
+    const auto caller = std::uint64_t(0u);
+
+    auto cmds = gfx::GFXCommandBuffer();
+    recordDraws( cmds, 0u, 10u, fakeDrawCaller(&caller) );
+    cmds.clear();
+    EXPECT_TRUE( cmds.empty() );
+
+    auto backend = gfx::GFXRecordingBackend();
+    cmds.replay(backend);
+    EXPECT_TRUE( backend.entries().empty() );
+}
+
+// the same draws recorded by one thread, then split over more,
+// each into its own buffer as layers are recorded.
+TEST(CommandBufferBenchmark, RecordingThreadScaling)
+{
+    constexpr auto nDraw = std::size_t(400000u);
+    const auto caller = std::uint64_t(0u);
+    const auto& drawCaller = fakeDrawCaller(&caller);
+
+    std::cout << nDraw << " draws recorded\n";
+
+    for (std::size_t nThread = 1u; nThread <= 8u; nThread *= 2u) {
+        auto buffers = std::vector<gfx::GFXCommandBuffer>(nThread);
+        // the first frame allocates, the second records as every later does.
+        auto elapsed = Timer<double, std::milli>::duration();
+
+        for (int frame = 0; frame < 2; ++frame) {
+            auto timer = Timer<double, std::milli>();
+
+            auto threads = std::vector<std::thread>();
+            for (std::size_t t = 0u; t < nThread; ++t) {
+                threads.emplace_back( [&, t] {
+                    buffers[t].clear();
+                    recordDraws( buffers[t], nDraw * t / nThread,
+                        nDraw * (t + 1u) / nThread, drawCaller
+                    );
+                } );
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            elapsed = timer.mark();
+        }
+
+        auto nCommand = std::size_t(0u);
+        for (const auto& buffer : buffers) {
+            nCommand += buffer.commands().size();
+        }
+        EXPECT_EQ(nCommand, nDraw * 4u);
+
+        std::cout << "    " << nThread << " threads: "
+            << elapsed.count() << "ms\n";
+        RecordProperty( "RecordMs" + std::to_string(nThread),
+            std::to_string( elapsed.count() )
+        );
+    }
+}
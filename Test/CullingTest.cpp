@@ -0,0 +1,201 @@
+#include <vector>
+#include <array>
+#include <random>
+#include <iostream>
+#include <optional>
+#include <cmath>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Scenery/Culling.hpp"
+#include "GFX/Scenery/DynamicBVH.hpp"
+#include "Timer.hpp"
+
+using gfx::Transform;
+using gfx::scenery::BoundingBox;
+using gfx::scenery::DynamicBVH;
+using gfx::scenery::Frustum;
+using Containment = gfx::scenery::Frustum::Containment;
+
+namespace {
+
+// looking down +z from the origin, near plane at 0.5, far at 100.
+Transform makeViewProj() {
+    return dx::XMMatrixPerspectiveFovLH(
+        dx::XM_PIDIV2, 2.f, 0.5f, 100.f
+    );
+}
+
+BoundingBox makeBox( float lx, float ly, float lz,
+    float hx, float hy, float hz
+) {
+    return BoundingBox{
+        .lo = dx::XMFLOAT3(lx, ly, lz),
+        .hi = dx::XMFLOAT3(hx, hy, hz)
+    };
+}
+
+std::vector<BoundingBox> makeRandomBoxes(std::size_t n, unsigned seed) {
+    auto rng = std::mt19937(seed);
+    auto xy = std::uniform_real_distribution<float>(-150.f, 150.f);
+    auto z = std::uniform_real_distribution<float>(-20.f, 120.f);
+    auto extent = std::uniform_real_distribution<float>(0.25f, 4.f);
+
+    auto ret = std::vector<BoundingBox>();
+    ret.reserve(n);
+    for (std::size_t i = 0u; i < n; ++i) {
+        const auto cx = xy(rng);
+        const auto cy = xy(rng);
+        const auto cz = z(rng);
+        const auto e = extent(rng);
+        ret.push_back( makeBox(cx - e, cy - e, cz - e, cx + e, cy + e, cz + e) );
+    }
+    return ret;
+}
+
+// tests the eight corners in clip space against the six half spaces,
+// sharing nothing with how Frustum extracts its planes.
+// nullopt if a corner is too near a plane to tell.
+std::optional<Containment> classifyCorners( const Transform& viewProj,
+    const BoundingBox& box
+) {
+    auto nOutside = std::array<std::size_t, 6u>{};
+    auto bAllInside = true;
+
+    for (std::size_t corner = 0u; corner < 8u; ++corner) {
+        const auto point = dx::XMVectorSet(
+            corner & 1u ? box.hi.x : box.lo.x,
+            corner & 2u ? box.hi.y : box.lo.y,
+            corner & 4u ? box.hi.z : box.lo.z,
+            1.f
+        );
+        auto clip = dx::XMFLOAT4();
+        dx::XMStoreFloat4( &clip, dx::XMVector4Transform(point, viewProj.get()) );
+
+        const auto distances = std::array<float, 6u>{
+            clip.w + clip.x, clip.w - clip.x,
+            clip.w + clip.y, clip.w - clip.y,
+            clip.z, clip.w - clip.z
+        };
+        for (std::size_t plane = 0u; plane < 6u; ++plane) {
+            if ( std::abs( distances[plane] ) < 1e-3f ) {
+                return std::nullopt;
+            }
+            if (distances[plane] < 0.f) {
+                ++nOutside[plane];
+                bAllInside = false;
+            }
+        }
+    }
+
+    for (const auto n : nOutside) {
+        if (n == 8u) {
+            return Containment::Outside;
+        }
+    }
+    return bAllInside ? Containment::Inside : Containment::Intersects;
+}
+
+}   // namespace
+
+TEST(Frustum, ClassifyCases)
+{
+    const auto frustum = Frustum( makeViewProj() );
+
+    // straight ahead.
+    EXPECT_EQ( frustum.classify( makeBox(-1.f, -1.f, 10.f, 1.f, 1.f, 12.f) ),
+        Containment::Inside
+    );
+    // behind the camera.
+    EXPECT_EQ( frustum.classify( makeBox(-1.f, -1.f, -12.f, 1.f, 1.f, -10.f) ),
+        Containment::Outside
+    );
+    // past the far plane.
+    EXPECT_EQ( frustum.classify( makeBox(-1.f, -1.f, 150.f, 1.f, 1.f, 152.f) ),
+        Containment::Outside
+    );
+    // across the right plane, x = 2z with the aspect of 2.
+    EXPECT_EQ( frustum.classify( makeBox(18.f, -1.f, 10.f, 22.f, 1.f, 12.f) ),
+        Containment::Intersects
+    );
+    // across the near plane.
+    EXPECT_EQ( frustum.classify( makeBox(-1.f, -1.f, 0.f, 1.f, 1.f, 2.f) ),
+        Containment::Intersects
+    );
+    // beside the frustum, off the top plane.
+    EXPECT_EQ( frustum.classify( makeBox(-1.f, 30.f, 10.f, 1.f, 32.f, 12.f) ),
+        Containment::Outside
+    );
+}
+
+TEST(Frustum, ClassifyMatchesCorners)
+{
+    // turned and moved off the origin, so no plane lines up with an axis.
+    const auto viewProj = Transform( dx::XMMatrixRotationY(0.6f)
+        * dx::XMMatrixTranslation(3.f, -2.f, 5.f)
+    ) * makeViewProj();
+    const auto frustum = Frustum(viewProj);
+
+    auto nCompared = std::array<std::size_t, 3u>{};
+    for (const auto& box : makeRandomBoxes(20000u, 7u)) {
+        const auto expected = classifyCorners(viewProj, box);
+        if ( !expected.has_value() ) {
+            continue;
+        }
+
+        ASSERT_EQ( frustum.classify(box), expected.value() );
+        ++nCompared[ static_cast<std::size_t>( expected.value() ) ];
+    }
+
+    // every case was met.
+    EXPECT_GT( nCompared[ static_cast<std::size_t>(Containment::Outside) ], 0u );
+    EXPECT_GT( nCompared[ static_cast<std::size_t>(Containment::Intersects) ], 0u );
+    EXPECT_GT( nCompared[ static_cast<std::size_t>(Containment::Inside) ], 0u );
+}
+
+// 100k bounds classified one by one, against culled through the BVH.
+TEST(FrustumBenchmark, Classify100k)
+{
+    constexpr auto nBounds = std::size_t(100000u);
+    constexpr auto nRepeat = std::size_t(20u);
+
+    const auto frustum = Frustum( makeViewProj() );
+    const auto boxes = makeRandomBoxes(nBounds, 42u);
+
+    auto bvh = DynamicBVH<std::size_t>();
+    for (std::size_t i = 0u; i < nBounds; ++i) {
+        bvh.insert( boxes[i], i );
+    }
+    bvh.rebuild();
+
+    auto nFlat = std::size_t(0u);
+    auto nTree = std::size_t(0u);
+    auto flatTime = Timer<double, std::milli>::duration();
+    auto treeTime = Timer<double, std::milli>::duration();
+
+    auto timer = Timer<double, std::milli>();
+    for (std::size_t repeat = 0u; repeat < nRepeat; ++repeat) {
+        nFlat = 0u;
+        timer.mark();
+        for (const auto& box : boxes) {
+            nFlat += frustum.classify(box) != Containment::Outside;
+        }
+        flatTime += timer.mark();
+
+        nTree = 0u;
+        bvh.queryFrustum( frustum,
+            [&nTree](DynamicBVH<std::size_t>::Proxy, std::size_t) { ++nTree; }
+        );
+        treeTime += timer.mark();
+    }
+
+    // the tree's fat boxes may let a few more through.
+    EXPECT_GE(nTree, nFlat);
+
+    std::cout << nBounds << " bounds, " << nFlat << " visible\n"
+        << "    classify each: " << flatTime.count() / nRepeat << "ms\n"
+        << "    through BVH: " << treeTime.count() / nRepeat << "ms\n";
+    RecordProperty( "ClassifyMs", std::to_string( flatTime.count() / nRepeat ) );
+    RecordProperty( "BVHMs", std::to_string( treeTime.count() / nRepeat ) );
+}
@@ -0,0 +1,283 @@
+#include <vector>
+#include <array>
+#include <typeinfo>
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Scenery/DrawRuns.hpp"
+
+using gfx::GFXCommandType;
+using gfx::scenery::GFXIDList;
+using gfx::scenery::InstanceTransforms;
+using gfx::scenery::RenderObjectDesc;
+using gfx::scenery::RendererDesc;
+
+namespace {
+
+struct Box {};
+struct Sphere {};
+
+// the renderer's sets, told apart from the draws' by their indices.
+const auto rendererIDs = GFXIDList{ SlotMapKey(100u, 0u), SlotMapKey(101u, 0u) };
+const auto rendererInstancedIDs = GFXIDList{ SlotMapKey(200u, 0u) };
+
+RendererDesc makeRendererDesc(bool bInstancing) {
+    return RendererDesc{
+        .header = {
+            .IDVertexShader = SlotMapKey(1u, 0u),
+            .IDPixelShader = SlotMapKey(2u, 0u),
+            .IDType = typeid(RendererDesc)
+        },
+        .IDs = rendererIDs,
+        .instancedIDs = bInstancing ? rendererInstancedIDs : GFXIDList{}
+    };
+}
+
+// only the address of a draw caller is recorded, never read,
+// so a stand-in is enough where no device is available.
+const gfx::po::BasicDrawCaller& fakeDrawCaller(const void* address) {
+    return *static_cast<const gfx::po::BasicDrawCaller*>(address);
+}
+
+// stands in for RCDrawCmp, its instance marked by tag.
+struct FakeDraw {
+    RenderObjectDesc roDesc;
+    const gfx::po::BasicDrawCaller* pDrawCaller;
+    float tag;
+
+    const RenderObjectDesc& renderObjectDesc() const noexcept {
+        return roDesc;
+    }
+
+    const gfx::po::BasicDrawCaller& drawCaller() const noexcept {
+        return *pDrawCaller;
+    }
+
+    void writeInstance(InstanceTransforms& dst) const noexcept {
+        dst.world = {};
+        dst.world.m[3][0] = tag;
+    }
+};
+
+// draws of one buffer share geometry, and instance with each other
+// unless made without instanced IDs.
+template <class T>
+FakeDraw makeDraw( std::uint32_t buffer, float tag,
+    const std::uint64_t& drawCaller, bool bInstanceable = true
+) {
+    return FakeDraw{
+        .roDesc = RenderObjectDesc{
+            .header = {
+                .IDBuffer = SlotMapKey(buffer, 0u),
+                .IDType = typeid(T),
+                .denseType = 0u
+            },
+            .IDs = { SlotMapKey(buffer, 1u), SlotMapKey(buffer, 2u) },
+            .instancedIDs = bInstanceable ? GFXIDList{ SlotMapKey(buffer, 3u) }
+                : GFXIDList{}
+        },
+        .pDrawCaller = &fakeDrawCaller(&drawCaller),
+        .tag = tag
+    };
+}
+
+// a command, by the ID it binds or the instances it draws.
+struct Recorded {
+    GFXCommandType type;
+    SlotMapKey id = {};
+    std::uint32_t nInstance = 0u;
+
+    friend bool operator==(const Recorded&, const Recorded&) = default;
+};
+
+Recorded bind(SlotMapKey id) {
+    return Recorded{ .type = GFXCommandType::Bind, .id = id };
+}
+
+Recorded draw() {
+    return Recorded{ .type = GFXCommandType::Draw };
+}
+
+Recorded drawInstanced(std::uint32_t nInstance) {
+    return Recorded{ .type = GFXCommandType::DrawInstanced, .nInstance = nInstance };
+}
+
+std::vector<Recorded> record( const RendererDesc& desc,
+    std::vector<FakeDraw>& draws, std::size_t minInstanceRun,
+    gfx::GFXRecordingBackend& backend
+) {
+    auto pDraws = std::vector<FakeDraw*>();
+    for (auto& d : draws) {
+        pDraws.push_back(&d);
+    }
+
+    auto instances = std::vector<InstanceTransforms>();
+    auto cmds = gfx::GFXCommandBuffer();
+    gfx::scenery::recordDrawRuns( desc, std::span<FakeDraw* const>(pDraws),
+        minInstanceRun, instances, cmds
+    );
+    cmds.replay(backend);
+
+    auto ret = std::vector<Recorded>();
+    for (const auto& entry : backend.entries()) {
+        ret.push_back( Recorded{
+            .type = entry.type,
+            .id = entry.id,
+            .nInstance = entry.nInstance
+        } );
+    }
+    return ret;
+}
+
+// the tags of an instanced draw's instances, in order.
+std::vector<float> tagsOf(const gfx::GFXRecordingBackend::Entry& entry) {
+    const auto pInstances = reinterpret_cast<const InstanceTransforms*>(
+        entry.bytes.data()
+    );
+    auto ret = std::vector<float>();
+    for (std::uint32_t i = 0u; i < entry.nInstance; ++i) {
+        ret.push_back( pInstances[i].world.m[3][0] );
+    }
+    return ret;
+}
+
+}   // namespace
+
+TEST(DrawRuns, SharedGeometryOneInstancedDraw)
+{
+    const auto caller = std::uint64_t(0u);
+    auto draws = std::vector<FakeDraw>();
+    for (std::size_t i = 0u; i < 5u; ++i) {
+        draws.push_back( makeDraw<Box>( 7u, static_cast<float>(i), caller ) );
+    }
+
+    auto backend = gfx::GFXRecordingBackend();
+    const auto recorded = record( makeRendererDesc(true), draws, 2u, backend );
+
+    const auto expected = std::vector<Recorded>{
+        bind( SlotMapKey(200u, 0u) ),
+        bind( SlotMapKey(7u, 3u) ),
+        drawInstanced(5u)
+    };
+    EXPECT_EQ(recorded, expected);
+
+    const auto& entry = backend.entries().back();
+    EXPECT_EQ( entry.pDrawCaller, &fakeDrawCaller(&caller) );
+    EXPECT_EQ( tagsOf(entry), ( std::vector<float>{ 0.f, 1.f, 2.f, 3.f, 4.f } ) );
+}
+
+// sets are switched where the kind of draw changes, and only there.
+TEST(DrawRuns, MixedRunsSwitchBindingSets)
+{
+    const auto callers = std::array<std::uint64_t, 5u>{};
+    auto draws = std::vector<FakeDraw>{
+        makeDraw<Box>( 7u, 0.f, callers[0] ),
+        makeDraw<Box>( 7u, 1.f, callers[0] ),
+        makeDraw<Box>( 7u, 2.f, callers[0] ),
+        // alone with its geometry.
+        makeDraw<Sphere>( 8u, 3.f, callers[1] ),
+        // the same buffer but another type doesn't instance.
+        makeDraw<Box>( 8u, 4.f, callers[2] ),
+        makeDraw<Sphere>( 9u, 5.f, callers[3] ),
+        makeDraw<Sphere>( 9u, 6.f, callers[3] ),
+        // can't be instanced, though sharing geometry.
+        makeDraw<Sphere>( 10u, 7.f, callers[4], false ),
+        makeDraw<Sphere>( 10u, 8.f, callers[4], false )
+    };
+
+    auto backend = gfx::GFXRecordingBackend();
+    const auto recorded = record( makeRendererDesc(true), draws, 2u, backend );
+
+    const auto expected = std::vector<Recorded>{
+        bind( SlotMapKey(200u, 0u) ),
+        bind( SlotMapKey(7u, 3u) ),
+        drawInstanced(3u),
+
+        bind( SlotMapKey(100u, 0u) ),
+        bind( SlotMapKey(101u, 0u) ),
+        bind( SlotMapKey(8u, 1u) ),
+        bind( SlotMapKey(8u, 2u) ),
+        draw(),
+        // still bound for plain draws.
+        bind( SlotMapKey(8u, 1u) ),
+        bind( SlotMapKey(8u, 2u) ),
+        draw(),
+
+        bind( SlotMapKey(200u, 0u) ),
+        bind( SlotMapKey(9u, 3u) ),
+        drawInstanced(2u),
+
+        bind( SlotMapKey(100u, 0u) ),
+        bind( SlotMapKey(101u, 0u) ),
+        bind( SlotMapKey(10u, 1u) ),
+        bind( SlotMapKey(10u, 2u) ),
+        draw(),
+        bind( SlotMapKey(10u, 1u) ),
+        bind( SlotMapKey(10u, 2u) ),
+        draw()
+    };
+    EXPECT_EQ(recorded, expected);
+
+    const auto& entries = backend.entries();
+    EXPECT_EQ( tagsOf( entries[2] ), ( std::vector<float>{ 0.f, 1.f, 2.f } ) );
+    EXPECT_EQ( tagsOf( entries[13] ), ( std::vector<float>{ 5.f, 6.f } ) );
+    EXPECT_EQ( entries[7].pDrawCaller, &fakeDrawCaller(&callers[1]) );
+    EXPECT_EQ( entries[10].pDrawCaller, &fakeDrawCaller(&callers[2]) );
+}
+
+TEST(DrawRuns, ShortRunsDrawnOneByOne)
+{
+    const auto caller = std::uint64_t(0u);
+    auto draws = std::vector<FakeDraw>{
+        makeDraw<Box>( 7u, 0.f, caller ),
+        makeDraw<Box>( 7u, 1.f, caller ),
+        makeDraw<Box>( 8u, 2.f, caller ),
+        makeDraw<Box>( 8u, 3.f, caller ),
+        makeDraw<Box>( 8u, 4.f, caller )
+    };
+
+    auto backend = gfx::GFXRecordingBackend();
+    const auto recorded = record( makeRendererDesc(true), draws, 3u, backend );
+
+    const auto expected = std::vector<Recorded>{
+        bind( SlotMapKey(100u, 0u) ),
+        bind( SlotMapKey(101u, 0u) ),
+        bind( SlotMapKey(7u, 1u) ),
+        bind( SlotMapKey(7u, 2u) ),
+        draw(),
+        bind( SlotMapKey(7u, 1u) ),
+        bind( SlotMapKey(7u, 2u) ),
+        draw(),
+        bind( SlotMapKey(200u, 0u) ),
+        bind( SlotMapKey(8u, 3u) ),
+        drawInstanced(3u)
+    };
+    EXPECT_EQ(recorded, expected);
+}
+
+// a renderer without instanced shaders draws everything one by one.
+TEST(DrawRuns, NoInstancingWithoutRendererSet)
+{
+    const auto caller = std::uint64_t(0u);
+    auto draws = std::vector<FakeDraw>{
+        makeDraw<Box>( 7u, 0.f, caller ),
+        makeDraw<Box>( 7u, 1.f, caller )
+    };
+
+    auto backend = gfx::GFXRecordingBackend();
+    const auto recorded = record( makeRendererDesc(false), draws, 1u, backend );
+
+    const auto expected = std::vector<Recorded>{
+        bind( SlotMapKey(100u, 0u) ),
+        bind( SlotMapKey(101u, 0u) ),
+        bind( SlotMapKey(7u, 1u) ),
+        bind( SlotMapKey(7u, 2u) ),
+        draw(),
+        bind( SlotMapKey(7u, 1u) ),
+        bind( SlotMapKey(7u, 2u) ),
+        draw()
+    };
+    EXPECT_EQ(recorded, expected);
+}
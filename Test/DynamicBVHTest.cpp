@@ -0,0 +1,372 @@
+#include <vector>
+#include <random>
+#include <optional>
+#include <limits>
+#include <algorithm>
+#include <iostream>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Scenery/DynamicBVH.hpp"
+#include "Timer.hpp"
+
+using gfx::Transform;
+using gfx::scenery::BoundingBox;
+using gfx::scenery::DynamicBVH;
+using gfx::scenery::Frustum;
+using gfx::scenery::Ray;
+
+namespace {
+
+using BVH = DynamicBVH<std::size_t>;
+
+// values index the boxes the tree was given, so hits refine against them.
+struct Scene {
+    BVH bvh;
+    std::vector<BoundingBox> boxes;
+    std::vector<BVH::Proxy> proxies;
+    std::vector<bool> bLive;
+};
+
+BoundingBox makeRandomBox(std::mt19937& rng, float range) {
+    auto position = std::uniform_real_distribution<float>(-range, range);
+    auto extent = std::uniform_real_distribution<float>(0.1f, 2.f);
+    const auto cx = position(rng);
+    const auto cy = position(rng);
+    const auto cz = position(rng);
+    return BoundingBox{
+        .lo = dx::XMFLOAT3( cx - extent(rng), cy - extent(rng), cz - extent(rng) ),
+        .hi = dx::XMFLOAT3( cx + extent(rng), cy + extent(rng), cz + extent(rng) )
+    };
+}
+
+BoundingBox offset(const BoundingBox& box, float dx, float dy, float dz) {
+    return BoundingBox{
+        .lo = dx::XMFLOAT3(box.lo.x + dx, box.lo.y + dy, box.lo.z + dz),
+        .hi = dx::XMFLOAT3(box.hi.x + dx, box.hi.y + dy, box.hi.z + dz)
+    };
+}
+
+void insertRandom(Scene& scene, std::size_t n, std::mt19937& rng) {
+    for (std::size_t i = 0u; i < n; ++i) {
+        const auto value = scene.boxes.size();
+        scene.boxes.push_back( makeRandomBox(rng, 50.f) );
+        scene.proxies.push_back( scene.bvh.insert( scene.boxes.back(), value ) );
+        scene.bLive.push_back(true);
+    }
+}
+
+// small moves stay in the fat boxes, large ones refit.
+void moveRandom(Scene& scene, std::size_t n, std::mt19937& rng) {
+    auto pick = std::uniform_int_distribution<std::size_t>(0u, scene.boxes.size() - 1u);
+    auto step = std::uniform_real_distribution<float>(-3.f, 3.f);
+    for (std::size_t i = 0u; i < n; ++i) {
+        const auto value = pick(rng);
+        if ( !scene.bLive[value] ) {
+            continue;
+        }
+        const auto scale = i % 2u ? 0.01f : 1.f;
+        scene.boxes[value] = offset( scene.boxes[value],
+            step(rng) * scale, step(rng) * scale, step(rng) * scale
+        );
+        scene.bvh.move( scene.proxies[value], scene.boxes[value] );
+    }
+}
+
+void removeRandom(Scene& scene, std::size_t n, std::mt19937& rng) {
+    auto pick = std::uniform_int_distribution<std::size_t>(0u, scene.boxes.size() - 1u);
+    for (std::size_t i = 0u; i < n; ++i) {
+        const auto value = pick(rng);
+        if ( !scene.bLive[value] ) {
+            continue;
+        }
+        scene.bvh.remove( scene.proxies[value] );
+        scene.bLive[value] = false;
+    }
+}
+
+std::size_t nLive(const Scene& scene) {
+    return static_cast<std::size_t>( std::ranges::count(scene.bLive, true) );
+}
+
+// every leaf's fat box still holds the box it was last given.
+bool fatBoxesHold(const Scene& scene) {
+    for (std::size_t value = 0u; value < scene.boxes.size(); ++value) {
+        if ( scene.bLive[value] && !scene.bvh.fatBox( scene.proxies[value] )
+            .contains( scene.boxes[value] )
+        ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Transform makeViewProj(float yaw, float x, float z) {
+    return Transform( dx::XMMatrixRotationY(yaw)
+        * dx::XMMatrixTranslation(x, 0.f, z)
+    ) * Transform( dx::XMMatrixPerspectiveFovLH(
+        dx::XM_PIDIV4, 1.5f, 0.5f, 60.f
+    ) );
+}
+
+std::vector<BVH::Proxy> queryTree(const Scene& scene, const Frustum& frustum) {
+    auto ret = std::vector<BVH::Proxy>();
+    scene.bvh.queryFrustum( frustum,
+        [&ret](BVH::Proxy proxy, std::size_t) { ret.push_back(proxy); }
+    );
+    std::ranges::sort(ret);
+    return ret;
+}
+
+std::vector<BVH::Proxy> queryBruteForce(const Scene& scene, const Frustum& frustum) {
+    auto ret = std::vector<BVH::Proxy>();
+    for (std::size_t value = 0u; value < scene.boxes.size(); ++value) {
+        const auto proxy = scene.proxies[value];
+        if ( scene.bLive[value] && frustum.classify( scene.bvh.fatBox(proxy) )
+            != Frustum::Containment::Outside
+        ) {
+            ret.push_back(proxy);
+        }
+    }
+    std::ranges::sort(ret);
+    return ret;
+}
+
+std::optional<float> castTree(const Scene& scene, const Ray& ray) {
+    const auto hit = scene.bvh.raycast( ray,
+        [&scene, &ray](std::size_t value, float tMax) {
+            return ray.intersect( scene.boxes[value], tMax );
+        }
+    );
+    if ( !hit.has_value() ) {
+        return std::nullopt;
+    }
+    // the hit is the value it names.
+    EXPECT_EQ( ray.intersect( scene.boxes[ scene.bvh.value(hit->proxy) ],
+        std::numeric_limits<float>::infinity()
+    ), hit->distance );
+    return hit->distance;
+}
+
+std::optional<float> castBruteForce(const Scene& scene, const Ray& ray) {
+    auto ret = std::optional<float>();
+    for (std::size_t value = 0u; value < scene.boxes.size(); ++value) {
+        if ( !scene.bLive[value] ) {
+            continue;
+        }
+        const auto t = ray.intersect( scene.boxes[value],
+            std::numeric_limits<float>::infinity()
+        );
+        if ( t.has_value() && ( !ret.has_value() || t.value() < ret.value() ) ) {
+            ret = t;
+        }
+    }
+    return ret;
+}
+
+}   // namespace
+
+TEST(DynamicBVH, Empty)
+{
+    auto bvh = BVH();
+    EXPECT_TRUE( bvh.valid() );
+    EXPECT_EQ(bvh.size(), 0u);
+
+    bvh.rebuild();
+    EXPECT_TRUE( bvh.valid() );
+    EXPECT_FALSE( bvh.raycast( Ray{
+        .origin = dx::XMFLOAT3(0.f, 0.f, 0.f),
+        .direction = dx::XMFLOAT3(0.f, 0.f, 1.f)
+    }, [](std::size_t, float) { return std::optional<float>(0.f); } ).has_value() );
+}
+
+TEST(DynamicBVH, InsertMoveRemoveKeepInvariants)
+{
+    auto rng = std::mt19937(3u);
+    auto scene = Scene();
+
+    insertRandom(scene, 1u, rng);
+    EXPECT_TRUE( scene.bvh.valid() );
+    insertRandom(scene, 999u, rng);
+    EXPECT_TRUE( scene.bvh.valid() );
+    EXPECT_EQ( scene.bvh.size(), 1000u );
+    EXPECT_TRUE( fatBoxesHold(scene) );
+
+    moveRandom(scene, 2000u, rng);
+    EXPECT_TRUE( scene.bvh.valid() );
+    EXPECT_TRUE( fatBoxesHold(scene) );
+
+    removeRandom(scene, 500u, rng);
+    EXPECT_TRUE( scene.bvh.valid() );
+    EXPECT_EQ( scene.bvh.size(), nLive(scene) );
+
+    // freed proxies are reused, values follow their new proxies.
+    insertRandom(scene, 300u, rng);
+    EXPECT_TRUE( scene.bvh.valid() );
+    EXPECT_EQ( scene.bvh.size(), nLive(scene) );
+    for (std::size_t value = 0u; value < scene.boxes.size(); ++value) {
+        if ( scene.bLive[value] ) {
+            EXPECT_EQ( scene.bvh.value( scene.proxies[value] ), value );
+        }
+    }
+
+    // proxies survive the rebuild.
+    scene.bvh.rebuild();
+    EXPECT_TRUE( scene.bvh.valid() );
+    EXPECT_FALSE( scene.bvh.rebuildDue() );
+    EXPECT_TRUE( fatBoxesHold(scene) );
+
+    // down to nothing and back.
+    for (std::size_t value = 0u; value < scene.boxes.size(); ++value) {
+        if ( scene.bLive[value] ) {
+            scene.bvh.remove( scene.proxies[value] );
+            scene.bLive[value] = false;
+        }
+    }
+    EXPECT_TRUE( scene.bvh.valid() );
+    EXPECT_EQ( scene.bvh.size(), 0u );
+    insertRandom(scene, 10u, rng);
+    EXPECT_TRUE( scene.bvh.valid() );
+}
+
+TEST(DynamicBVH, SmallMovesDontTouchTree)
+{
+    auto bvh = BVH(0.5f);
+    const auto box = BoundingBox{
+        .lo = dx::XMFLOAT3(0.f, 0.f, 0.f),
+        .hi = dx::XMFLOAT3(1.f, 1.f, 1.f)
+    };
+    const auto proxy = bvh.insert(box, 0u);
+    bvh.insert( offset(box, 5.f, 0.f, 0.f), 1u );
+    bvh.rebuild();
+
+    EXPECT_FALSE( bvh.move( proxy, offset(box, 0.4f, 0.f, 0.f) ) );
+    EXPECT_FALSE( bvh.rebuildDue() );
+    EXPECT_TRUE( bvh.move( proxy, offset(box, 0.6f, 0.f, 0.f) ) );
+    EXPECT_TRUE( bvh.valid() );
+}
+
+TEST(DynamicBVH, QueryMatchesBruteForce)
+{
+    auto rng = std::mt19937(5u);
+    auto scene = Scene();
+    insertRandom(scene, 2000u, rng);
+    moveRandom(scene, 2000u, rng);
+    removeRandom(scene, 300u, rng);
+
+    auto yaw = std::uniform_real_distribution<float>(-dx::XM_PI, dx::XM_PI);
+    auto position = std::uniform_real_distribution<float>(-20.f, 20.f);
+    for (const auto bRebuilt : { false, true }) {
+        if (bRebuilt) {
+            scene.bvh.rebuild();
+        }
+        for (std::size_t i = 0u; i < 50u; ++i) {
+            const auto frustum = Frustum( makeViewProj(
+                yaw(rng), position(rng), position(rng)
+            ) );
+            // a node outside has its subtree outside, inside all inside.
+            ASSERT_EQ( queryTree(scene, frustum), queryBruteForce(scene, frustum) );
+        }
+    }
+}
+
+TEST(DynamicBVH, RaycastMatchesBruteForce)
+{
+    auto rng = std::mt19937(9u);
+    auto scene = Scene();
+    insertRandom(scene, 2000u, rng);
+    moveRandom(scene, 2000u, rng);
+    removeRandom(scene, 300u, rng);
+
+    auto position = std::uniform_real_distribution<float>(-60.f, 60.f);
+    auto direction = std::uniform_real_distribution<float>(-1.f, 1.f);
+    auto nHit = std::size_t(0u);
+    for (const auto bRebuilt : { false, true }) {
+        if (bRebuilt) {
+            scene.bvh.rebuild();
+        }
+        for (std::size_t i = 0u; i < 500u; ++i) {
+            const auto ray = Ray{
+                .origin = dx::XMFLOAT3( position(rng), position(rng), position(rng) ),
+                .direction = dx::XMFLOAT3( direction(rng), direction(rng), direction(rng) )
+            };
+            const auto expected = castBruteForce(scene, ray);
+            ASSERT_EQ( castTree(scene, ray), expected );
+            nHit += expected.has_value();
+        }
+    }
+    EXPECT_GT(nHit, 0u);
+}
+
+// the mouse picks through the camera, as the scene does.
+TEST(DynamicBVH, PickMatchesBruteForce)
+{
+    auto rng = std::mt19937(11u);
+    auto scene = Scene();
+    insertRandom(scene, 2000u, rng);
+    scene.bvh.rebuild();
+
+    const auto viewProj = makeViewProj(0.3f, 0.f, 55.f);
+    auto ndc = std::uniform_real_distribution<float>(-1.f, 1.f);
+    auto nHit = std::size_t(0u);
+    for (std::size_t i = 0u; i < 500u; ++i) {
+        const auto ray = Ray::unproject( viewProj, ndc(rng), ndc(rng) );
+        const auto expected = castBruteForce(scene, ray);
+        ASSERT_EQ( castTree(scene, ray), expected );
+        nHit += expected.has_value();
+    }
+    EXPECT_GT(nHit, 0u);
+}
+
+// a full rebuild against refitting after every leaf moved past its margin,
+// with what each leaves queries costing.
+TEST(DynamicBVHBenchmark, RebuildAndRefit)
+{
+    constexpr auto nLeaf = std::size_t(100000u);
+
+    auto rng = std::mt19937(13u);
+    auto scene = Scene();
+    scene.boxes.reserve(nLeaf);
+    insertRandom(scene, nLeaf, rng);
+
+    const auto frustum = Frustum( makeViewProj(0.f, 0.f, 0.f) );
+    const auto queryTime = [&] {
+        auto timer = Timer<double, std::milli>();
+        auto n = std::size_t(0u);
+        for (std::size_t i = 0u; i < 10u; ++i) {
+            scene.bvh.queryFrustum( frustum,
+                [&n](BVH::Proxy, std::size_t) { ++n; }
+            );
+        }
+        return timer.mark() / 10.;
+    };
+
+    auto timer = Timer<double, std::milli>();
+    scene.bvh.rebuild();
+    const auto rebuildTime = timer.mark();
+    const auto builtQueryTime = queryTime();
+
+    auto step = std::uniform_real_distribution<float>(-1.f, 1.f);
+    timer.mark();
+    for (std::size_t value = 0u; value < nLeaf; ++value) {
+        scene.boxes[value] = offset( scene.boxes[value],
+            step(rng), step(rng), step(rng)
+        );
+        scene.bvh.move( scene.proxies[value], scene.boxes[value] );
+    }
+    const auto refitTime = timer.mark();
+    const auto refitQueryTime = queryTime();
+
+    EXPECT_TRUE( scene.bvh.valid() );
+    EXPECT_TRUE( fatBoxesHold(scene) );
+
+    std::cout << nLeaf << " leaves\n"
+        << "    rebuild: " << rebuildTime.count() << "ms, query after: "
+        << builtQueryTime.count() << "ms\n"
+        << "    refit all: " << refitTime.count() << "ms, query after: "
+        << refitQueryTime.count() << "ms, rebuild due: "
+        << scene.bvh.rebuildDue() << '\n';
+    RecordProperty( "RebuildMs", std::to_string( rebuildTime.count() ) );
+    RecordProperty( "RefitMs", std::to_string( refitTime.count() ) );
+}
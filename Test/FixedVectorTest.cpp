@@ -0,0 +1,135 @@
+#include <vector>
+#include <array>
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "FixedVector.hpp"
+#include "Timer.hpp"
+
+namespace {
+
+// every allocation of the program through the global operator new.
+auto nAllocation = std::atomic<std::size_t>(0u);
+
+// the size of a draw's binding ID list.
+using IDList = FixedVector<std::uint64_t, 16u>;
+
+IDList makeIDs(std::size_t n) {
+    auto ids = IDList();
+    for (std::size_t i = 0u; i < n; ++i) {
+        ids.push_back(i * 7u);
+    }
+    return ids;
+}
+
+}   // namespace
+
+void* operator new(std::size_t size) {
+    nAllocation.fetch_add(1u, std::memory_order_relaxed);
+    if ( auto p = std::malloc(size ? size : 1u) ) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+TEST(FixedVector, PushBackCopyCompare)
+{
+    auto ids = makeIDs(5u);
+    ASSERT_EQ(ids.size(), 5u);
+    EXPECT_EQ(ids[4], 28u);
+
+    auto copied = ids;
+    EXPECT_EQ(copied, ids);
+    copied.push_back(1u);
+    EXPECT_FALSE(copied == ids);
+
+    copied.clear();
+    EXPECT_TRUE( copied.empty() );
+}
+
+TEST(FixedVector, InitializerListOverCapacity)
+{
+    using Small = FixedVector<int, 2u>;
+    EXPECT_NO_THROW( Small({1, 2}) );
+    EXPECT_THROW( Small({1, 2, 3}), std::length_error );
+}
+
+TEST(FixedVector, NeverAllocates)
+{
+    const auto before = nAllocation.load();
+
+    auto ids = makeIDs( IDList::capacity() );
+    auto copied = ids;
+    auto assigned = IDList();
+    assigned = copied;
+    assigned.clear();
+    assigned.push_back(ids[0]);
+    auto lists = std::array<IDList, 4u>{ ids, copied, assigned, IDList{1u, 2u} };
+
+    const auto nFixed = nAllocation.load() - before;
+
+    // the counter does see the heap.
+    auto heap = std::vector<std::uint64_t>( ids.begin(), ids.end() );
+    const auto nHeap = nAllocation.load() - before - nFixed;
+
+    EXPECT_EQ(nFixed, 0u);
+    EXPECT_GE(nHeap, 1u);
+    EXPECT_EQ(lists[3].size(), 2u);
+    EXPECT_EQ(heap.size(), IDList::capacity());
+}
+
+// copying a draw's ID list as recording does, against the std::vector it replaced.
+TEST(FixedVectorBenchmark, CopyAgainstVector)
+{
+    constexpr auto nCopy = std::size_t(1000000u);
+    constexpr auto nID = std::size_t(6u);
+
+    const auto fixed = makeIDs(nID);
+    const auto heap = std::vector<std::uint64_t>( fixed.begin(), fixed.end() );
+
+    auto timer = Timer<double, std::milli>();
+    auto before = nAllocation.load();
+
+    auto sumFixed = std::uint64_t(0u);
+    for (std::size_t i = 0u; i < nCopy; ++i) {
+        const auto copied = fixed;
+        sumFixed += copied[i % nID];
+    }
+    const auto fixedTime = timer.mark();
+    const auto nFixed = nAllocation.load() - before;
+
+    before = nAllocation.load();
+    auto sumHeap = std::uint64_t(0u);
+    for (std::size_t i = 0u; i < nCopy; ++i) {
+        const auto copied = heap;
+        sumHeap += copied[i % nID];
+    }
+    const auto heapTime = timer.mark();
+    const auto nHeap = nAllocation.load() - before;
+
+    EXPECT_EQ(sumFixed, sumHeap);
+    EXPECT_EQ(nFixed, 0u);
+
+    std::cout << nCopy << " copies of " << nID << " IDs\n"
+        << "    FixedVector: " << fixedTime.count() << "ms, "
+        << nFixed << " allocations\n"
+        << "    std::vector: " << heapTime.count() << "ms, "
+        << nHeap << " allocations\n";
+    RecordProperty( "FixedVectorMs", std::to_string( fixedTime.count() ) );
+    RecordProperty( "VectorMs", std::to_string( heapTime.count() ) );
+}
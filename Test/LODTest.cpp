@@ -0,0 +1,158 @@
+#include <vector>
+#include <array>
+#include <random>
+#include <limits>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Scenery/LOD.hpp"
+
+using gfx::Transform;
+using gfx::scenery::BoundingSphere;
+using gfx::scenery::LODSelector;
+using gfx::scenery::LODStats;
+
+namespace {
+
+constexpr auto minRadii = std::array<float, 3u>{ 0.5f, 0.2f, 0.05f };
+
+// a unit sphere down +z from a camera at the origin, seeing 90 degrees high,
+// so its projected radius is one over its distance.
+float projectAt(float distance) {
+    const auto view = Transform( dx::XMMatrixIdentity() );
+    const auto proj = Transform( dx::XMMatrixPerspectiveFovLH(
+        dx::XM_PIDIV2, 1.5f, 0.5f, 1000.f
+    ) );
+    return LODSelector::projectedRadius( BoundingSphere{
+        .center = dx::XMFLOAT3(0.f, 0.f, distance),
+        .radius = 1.f
+    }, view, proj );
+}
+
+// how often the level changes as the radii are given in turn.
+std::size_t countSwitches( LODSelector& selector,
+    const std::vector<float>& projRadii
+) {
+    auto ret = std::size_t(0u);
+    for (const auto projRadius : projRadii) {
+        const auto prev = selector.level();
+        ret += selector.select(projRadius) != prev;
+    }
+    return ret;
+}
+
+}   // namespace
+
+TEST(LOD, ProjectedRadius)
+{
+    EXPECT_FLOAT_EQ( projectAt(10.f), 0.1f );
+    EXPECT_FLOAT_EQ( projectAt(4.f), 0.25f );
+
+    // the camera within the sphere sees nothing but it.
+    EXPECT_EQ( projectAt(0.5f), std::numeric_limits<float>::infinity() );
+
+    // moved with the camera, nothing changes.
+    const auto proj = Transform( dx::XMMatrixPerspectiveFovLH(
+        dx::XM_PIDIV2, 1.5f, 0.5f, 1000.f
+    ) );
+    EXPECT_FLOAT_EQ( LODSelector::projectedRadius( BoundingSphere{
+        .center = dx::XMFLOAT3(3.f, 0.f, 10.f),
+        .radius = 1.f
+    }, Transform( dx::XMMatrixTranslation(-3.f, 0.f, 0.f) ), proj ), 0.1f );
+}
+
+TEST(LOD, SelectsByProjectedSize)
+{
+    const auto select = [](float projRadius) {
+        auto selector = LODSelector(minRadii);
+        return selector.select(projRadius);
+    };
+
+    EXPECT_EQ( LODSelector(minRadii).nLevel(), 4u );
+    EXPECT_EQ( select(1.f), 0u );
+    EXPECT_EQ( select(0.3f), 1u );
+    EXPECT_EQ( select(0.1f), 2u );
+    EXPECT_EQ( select(0.01f), 3u );
+    EXPECT_EQ( select( std::numeric_limits<float>::infinity() ), 0u );
+
+    // by distance, nearer is finer.
+    EXPECT_EQ( select( projectAt(1.5f) ), 0u );
+    EXPECT_EQ( select( projectAt(4.f) ), 1u );
+    EXPECT_EQ( select( projectAt(10.f) ), 2u );
+    EXPECT_EQ( select( projectAt(100.f) ), 3u );
+}
+
+TEST(LOD, JumpsSeveralLevels)
+{
+    auto selector = LODSelector(minRadii);
+    EXPECT_EQ( selector.select(0.01f), 3u );
+    EXPECT_EQ( selector.select(1.f), 0u );
+    EXPECT_EQ( selector.select(0.1f), 2u );
+}
+
+TEST(LOD, HoldsNearThresholdComingFromAbove)
+{
+    auto selector = LODSelector(minRadii, 0.1f);
+    EXPECT_EQ( selector.select(0.3f), 1u );
+
+    // within 10% either side of 0.2, level 1 is kept.
+    EXPECT_EQ( countSwitches( selector, { 0.19f, 0.21f, 0.185f, 0.215f, 0.19f } ), 0u );
+    EXPECT_EQ( selector.level(), 1u );
+
+    // past the margin, it's left.
+    EXPECT_EQ( selector.select(0.17f), 2u );
+}
+
+TEST(LOD, HoldsNearThresholdComingFromBelow)
+{
+    auto selector = LODSelector(minRadii, 0.1f);
+    EXPECT_EQ( selector.select(0.1f), 2u );
+
+    EXPECT_EQ( countSwitches( selector, { 0.21f, 0.19f, 0.215f, 0.185f, 0.21f } ), 0u );
+    EXPECT_EQ( selector.level(), 2u );
+
+    EXPECT_EQ( selector.select(0.23f), 1u );
+}
+
+// walking to an object and back with jittering distances,
+// each threshold is crossed once each way.
+TEST(LOD, NoFlipFlopWhileWalking)
+{
+    auto rng = std::mt19937(17u);
+    auto jitter = std::uniform_real_distribution<float>(0.97f, 1.03f);
+
+    auto away = std::vector<float>();
+    for (auto distance = 1.5f; distance < 100.f; distance *= 1.01f) {
+        away.push_back( projectAt( distance * jitter(rng) ) );
+    }
+    auto toward = std::vector<float>( away.rbegin(), away.rend() );
+    for (auto& projRadius : toward) {
+        projRadius *= jitter(rng);
+    }
+
+    auto selector = LODSelector(minRadii, 0.1f);
+    EXPECT_EQ( countSwitches(selector, away), 3u );
+    EXPECT_EQ( selector.level(), 3u );
+    EXPECT_EQ( countSwitches(selector, toward), 3u );
+    EXPECT_EQ( selector.level(), 0u );
+
+    // without a margin, the same walk pops.
+    auto bare = LODSelector(minRadii, 0.f);
+    EXPECT_GT( countSwitches(bare, away), 3u );
+}
+
+TEST(LOD, StatsClampLevels)
+{
+    auto stats = LODStats{};
+    stats.count(0u);
+    stats.count(2u);
+    stats.count(LODStats::maxLevel + 3u);
+
+    auto total = LODStats{};
+    total += stats;
+    total += stats;
+    EXPECT_EQ(total.nDraws[0], 2u);
+    EXPECT_EQ(total.nDraws[2], 2u);
+    EXPECT_EQ(total.nDraws[LODStats::maxLevel - 1u], 2u);
+}
@@ -0,0 +1,260 @@
+#ifndef __MockContext
+#define __MockContext
+
+#include <d3d11_1.h>
+#include <wrl.h>
+
+#include <vector>
+#include <string_view>
+#include <cstddef>
+
+// device context recording the writes it is asked for,
+// the vertex shader constant buffers and the states bound, drawing nothing.
+// mapped memory is its own, so resources may come from any device.
+// owned by the test, references only count.
+class MockContext : public ID3D11DeviceContext1 {
+public:
+    struct MapCall {
+        ID3D11Resource* pResource;
+        D3D11_MAP mapType;
+    };
+
+    struct UpdateCall {
+        ID3D11Resource* pResource;
+        bool bBox;
+        D3D11_BOX box;
+        std::vector<std::byte> bytes;
+    };
+
+    std::vector<MapCall> maps;
+    std::vector<UpdateCall> updates;
+    std::vector<std::byte> mapped;
+    std::vector<ID3D11Buffer*> vsCBuffers;
+    // names of the calls binding what a pipeline state object holds.
+    std::vector<std::string_view> stateBinds;
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppv) override {
+        if ( riid == __uuidof(ID3D11DeviceContext1)
+            || riid == __uuidof(ID3D11DeviceContext)
+            || riid == __uuidof(ID3D11DeviceChild)
+            || riid == __uuidof(IUnknown)
+        ) {
+            *ppv = static_cast<ID3D11DeviceContext1*>(this);
+            AddRef();
+            return S_OK;
+        }
+        *ppv = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override {
+        return ++nRef_;
+    }
+
+    ULONG STDMETHODCALLTYPE Release() override {
+        return --nRef_;
+    }
+
+    HRESULT STDMETHODCALLTYPE Map( ID3D11Resource* pResource, UINT,
+        D3D11_MAP mapType, UINT, D3D11_MAPPED_SUBRESOURCE* pMapped
+    ) override {
+        maps.push_back( MapCall{ .pResource = pResource, .mapType = mapType } );
+
+        auto pBuffer = static_cast<ID3D11Buffer*>(nullptr);
+        if ( SUCCEEDED( pResource->QueryInterface(&pBuffer) ) ) {
+            auto desc = D3D11_BUFFER_DESC{};
+            pBuffer->GetDesc(&desc);
+            pBuffer->Release();
+            mapped.resize(desc.ByteWidth);
+        }
+
+        *pMapped = D3D11_MAPPED_SUBRESOURCE{
+            .pData = mapped.data(),
+            .RowPitch = static_cast<UINT>( mapped.size() ),
+            .DepthPitch = static_cast<UINT>( mapped.size() )
+        };
+        return S_OK;
+    }
+
+    void STDMETHODCALLTYPE Unmap(ID3D11Resource*, UINT) override {}
+
+    // only buffers are written, the size comes from the box or the buffer.
+    void STDMETHODCALLTYPE UpdateSubresource( ID3D11Resource* pResource,
+        UINT, const D3D11_BOX* pBox, const void* pData, UINT, UINT
+    ) override {
+        auto size = std::size_t(0u);
+        if (pBox) {
+            size = pBox->right - pBox->left;
+        }
+        else {
+            auto pBuffer = static_cast<ID3D11Buffer*>(nullptr);
+            if ( SUCCEEDED( pResource->QueryInterface(&pBuffer) ) ) {
+                auto desc = D3D11_BUFFER_DESC{};
+                pBuffer->GetDesc(&desc);
+                pBuffer->Release();
+                size = desc.ByteWidth;
+            }
+        }
+
+        const auto pBytes = static_cast<const std::byte*>(pData);
+        updates.push_back( UpdateCall{
+            .pResource = pResource,
+            .bBox = pBox != nullptr,
+            .box = pBox ? *pBox : D3D11_BOX{},
+            .bytes = std::vector<std::byte>(pBytes, pBytes + size)
+        } );
+    }
+
+    // ID3D11DeviceChild
+    void STDMETHODCALLTYPE GetDevice(ID3D11Device** ppDevice) override { *ppDevice = nullptr; }
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT*, void*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override { return E_NOTIMPL; }
+
+    // ID3D11DeviceContext, nothing else is recorded.
+    void STDMETHODCALLTYPE VSSetConstantBuffers( UINT, UINT nBuffer,
+        ID3D11Buffer* const* ppBuffers
+    ) override {
+        vsCBuffers.insert( vsCBuffers.end(), ppBuffers, ppBuffers + nBuffer );
+    }
+    void STDMETHODCALLTYPE PSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader*, ID3D11ClassInstance* const*, UINT) override { stateBinds.push_back("PSSetShader"); }
+    void STDMETHODCALLTYPE PSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader*, ID3D11ClassInstance* const*, UINT) override { stateBinds.push_back("VSSetShader"); }
+    void STDMETHODCALLTYPE DrawIndexed(UINT, UINT, INT) override {}
+    void STDMETHODCALLTYPE Draw(UINT, UINT) override {}
+    void STDMETHODCALLTYPE PSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout*) override { stateBinds.push_back("IASetInputLayout"); }
+    void STDMETHODCALLTYPE IASetVertexBuffers(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) override {}
+    void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer*, DXGI_FORMAT, UINT) override {}
+    void STDMETHODCALLTYPE DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) override {}
+    void STDMETHODCALLTYPE DrawInstanced(UINT, UINT, UINT, UINT) override {}
+    void STDMETHODCALLTYPE GSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader*, ID3D11ClassInstance* const*, UINT) override {}
+    void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY) override { stateBinds.push_back("IASetPrimitiveTopology"); }
+    void STDMETHODCALLTYPE VSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE VSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE Begin(ID3D11Asynchronous*) override {}
+    void STDMETHODCALLTYPE End(ID3D11Asynchronous*) override {}
+    HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous*, void*, UINT, UINT) override { return E_NOTIMPL; }
+    void STDMETHODCALLTYPE SetPredication(ID3D11Predicate*, BOOL) override {}
+    void STDMETHODCALLTYPE GSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE GSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE OMSetRenderTargets(UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*) override {}
+    void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*, UINT, UINT, ID3D11UnorderedAccessView* const*, const UINT*) override {}
+    void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState*, const FLOAT[4], UINT) override { stateBinds.push_back("OMSetBlendState"); }
+    void STDMETHODCALLTYPE OMSetDepthStencilState(ID3D11DepthStencilState*, UINT) override { stateBinds.push_back("OMSetDepthStencilState"); }
+    void STDMETHODCALLTYPE SOSetTargets(UINT, ID3D11Buffer* const*, const UINT*) override {}
+    void STDMETHODCALLTYPE DrawAuto() override {}
+    void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer*, UINT) override {}
+    void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer*, UINT) override {}
+    void STDMETHODCALLTYPE Dispatch(UINT, UINT, UINT) override {}
+    void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer*, UINT) override {}
+    void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState*) override { stateBinds.push_back("RSSetState"); }
+    void STDMETHODCALLTYPE RSSetViewports(UINT, const D3D11_VIEWPORT*) override { stateBinds.push_back("RSSetViewports"); }
+    void STDMETHODCALLTYPE RSSetScissorRects(UINT, const D3D11_RECT*) override {}
+    void STDMETHODCALLTYPE CopySubresourceRegion(ID3D11Resource*, UINT, UINT, UINT, UINT, ID3D11Resource*, UINT, const D3D11_BOX*) override {}
+    void STDMETHODCALLTYPE CopyResource(ID3D11Resource*, ID3D11Resource*) override {}
+    void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer*, UINT, ID3D11UnorderedAccessView*) override {}
+    void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView*, const FLOAT[4]) override {}
+    void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView*, const UINT[4]) override {}
+    void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView*, const FLOAT[4]) override {}
+    void STDMETHODCALLTYPE ClearDepthStencilView(ID3D11DepthStencilView*, UINT, FLOAT, UINT8) override {}
+    void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView*) override {}
+    void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource*, FLOAT) override {}
+    FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource*) override { return 0.f; }
+    void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource*, UINT, ID3D11Resource*, UINT, DXGI_FORMAT) override {}
+    void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList*, BOOL) override {}
+    void STDMETHODCALLTYPE HSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader*, ID3D11ClassInstance* const*, UINT) override {}
+    void STDMETHODCALLTYPE HSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE HSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE DSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader*, ID3D11ClassInstance* const*, UINT) override {}
+    void STDMETHODCALLTYPE DSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE DSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE CSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE CSSetUnorderedAccessViews(UINT, UINT, ID3D11UnorderedAccessView* const*, const UINT*) override {}
+    void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader*, ID3D11ClassInstance* const*, UINT) override {}
+    void STDMETHODCALLTYPE CSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE CSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE VSGetConstantBuffers(UINT, UINT, ID3D11Buffer**) override {}
+    void STDMETHODCALLTYPE PSGetShaderResources(UINT, UINT, ID3D11ShaderResourceView**) override {}
+    void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader**, ID3D11ClassInstance**, UINT*) override {}
+    void STDMETHODCALLTYPE PSGetSamplers(UINT, UINT, ID3D11SamplerState**) override {}
+    void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader**, ID3D11ClassInstance**, UINT*) override {}
+    void STDMETHODCALLTYPE PSGetConstantBuffers(UINT, UINT, ID3D11Buffer**) override {}
+    void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout**) override {}
+    void STDMETHODCALLTYPE IAGetVertexBuffers(UINT, UINT, ID3D11Buffer**, UINT*, UINT*) override {}
+    void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer**, DXGI_FORMAT*, UINT*) override {}
+    void STDMETHODCALLTYPE GSGetConstantBuffers(UINT, UINT, ID3D11Buffer**) override {}
+    void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader**, ID3D11ClassInstance**, UINT*) override {}
+    void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY*) override {}
+    void STDMETHODCALLTYPE VSGetShaderResources(UINT, UINT, ID3D11ShaderResourceView**) override {}
+    void STDMETHODCALLTYPE VSGetSamplers(UINT, UINT, ID3D11SamplerState**) override {}
+    void STDMETHODCALLTYPE GetPredication(ID3D11Predicate**, BOOL*) override {}
+    void STDMETHODCALLTYPE GSGetShaderResources(UINT, UINT, ID3D11ShaderResourceView**) override {}
+    void STDMETHODCALLTYPE GSGetSamplers(UINT, UINT, ID3D11SamplerState**) override {}
+    void STDMETHODCALLTYPE OMGetRenderTargets(UINT, ID3D11RenderTargetView**, ID3D11DepthStencilView**) override {}
+    void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(UINT, ID3D11RenderTargetView**, ID3D11DepthStencilView**, UINT, UINT, ID3D11UnorderedAccessView**) override {}
+    void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState**, FLOAT[4], UINT*) override {}
+    void STDMETHODCALLTYPE OMGetDepthStencilState(ID3D11DepthStencilState**, UINT*) override {}
+    void STDMETHODCALLTYPE SOGetTargets(UINT, ID3D11Buffer**) override {}
+    void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState**) override {}
+    void STDMETHODCALLTYPE RSGetViewports(UINT*, D3D11_VIEWPORT*) override {}
+    void STDMETHODCALLTYPE RSGetScissorRects(UINT*, D3D11_RECT*) override {}
+    void STDMETHODCALLTYPE HSGetShaderResources(UINT, UINT, ID3D11ShaderResourceView**) override {}
+    void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader**, ID3D11ClassInstance**, UINT*) override {}
+    void STDMETHODCALLTYPE HSGetSamplers(UINT, UINT, ID3D11SamplerState**) override {}
+    void STDMETHODCALLTYPE HSGetConstantBuffers(UINT, UINT, ID3D11Buffer**) override {}
+    void STDMETHODCALLTYPE DSGetShaderResources(UINT, UINT, ID3D11ShaderResourceView**) override {}
+    void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader**, ID3D11ClassInstance**, UINT*) override {}
+    void STDMETHODCALLTYPE DSGetSamplers(UINT, UINT, ID3D11SamplerState**) override {}
+    void STDMETHODCALLTYPE DSGetConstantBuffers(UINT, UINT, ID3D11Buffer**) override {}
+    void STDMETHODCALLTYPE CSGetShaderResources(UINT, UINT, ID3D11ShaderResourceView**) override {}
+    void STDMETHODCALLTYPE CSGetUnorderedAccessViews(UINT, UINT, ID3D11UnorderedAccessView**) override {}
+    void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader**, ID3D11ClassInstance**, UINT*) override {}
+    void STDMETHODCALLTYPE CSGetSamplers(UINT, UINT, ID3D11SamplerState**) override {}
+    void STDMETHODCALLTYPE CSGetConstantBuffers(UINT, UINT, ID3D11Buffer**) override {}
+    void STDMETHODCALLTYPE ClearState() override {}
+    void STDMETHODCALLTYPE Flush() override {}
+    D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() override { return D3D11_DEVICE_CONTEXT_IMMEDIATE; }
+    UINT STDMETHODCALLTYPE GetContextFlags() override { return 0u; }
+    HRESULT STDMETHODCALLTYPE FinishCommandList(BOOL, ID3D11CommandList**) override { return E_NOTIMPL; }
+
+    // ID3D11DeviceContext1
+    void STDMETHODCALLTYPE CopySubresourceRegion1(ID3D11Resource*, UINT, UINT, UINT, UINT, ID3D11Resource*, UINT, const D3D11_BOX*, UINT) override {}
+    void STDMETHODCALLTYPE UpdateSubresource1(ID3D11Resource*, UINT, const D3D11_BOX*, const void*, UINT, UINT, UINT) override {}
+    void STDMETHODCALLTYPE DiscardResource(ID3D11Resource*) override {}
+    void STDMETHODCALLTYPE DiscardView(ID3D11View*) override {}
+    void STDMETHODCALLTYPE VSSetConstantBuffers1(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) override {}
+    void STDMETHODCALLTYPE HSSetConstantBuffers1(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) override {}
+    void STDMETHODCALLTYPE DSSetConstantBuffers1(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) override {}
+    void STDMETHODCALLTYPE GSSetConstantBuffers1(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) override {}
+    void STDMETHODCALLTYPE PSSetConstantBuffers1(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) override {}
+    void STDMETHODCALLTYPE CSSetConstantBuffers1(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) override {}
+    void STDMETHODCALLTYPE VSGetConstantBuffers1(UINT, UINT, ID3D11Buffer**, UINT*, UINT*) override {}
+    void STDMETHODCALLTYPE HSGetConstantBuffers1(UINT, UINT, ID3D11Buffer**, UINT*, UINT*) override {}
+    void STDMETHODCALLTYPE DSGetConstantBuffers1(UINT, UINT, ID3D11Buffer**, UINT*, UINT*) override {}
+    void STDMETHODCALLTYPE GSGetConstantBuffers1(UINT, UINT, ID3D11Buffer**, UINT*, UINT*) override {}
+    void STDMETHODCALLTYPE PSGetConstantBuffers1(UINT, UINT, ID3D11Buffer**, UINT*, UINT*) override {}
+    void STDMETHODCALLTYPE CSGetConstantBuffers1(UINT, UINT, ID3D11Buffer**, UINT*, UINT*) override {}
+    void STDMETHODCALLTYPE SwapDeviceContextState(ID3DDeviceContextState*, ID3DDeviceContextState**) override {}
+    void STDMETHODCALLTYPE ClearView(ID3D11View*, const FLOAT[4], const D3D11_RECT*, UINT) override {}
+    void STDMETHODCALLTYPE DiscardView1(ID3D11View*, const D3D11_RECT*, UINT) override {}
+
+private:
+    ULONG nRef_ = 1u;
+};
+
+// software device to create the resources written through the mock,
+// null where none is available.
+inline Microsoft::WRL::ComPtr<ID3D11Device> makeWarpDevice() {
+    auto pDevice = Microsoft::WRL::ComPtr<ID3D11Device>();
+    const auto hr = D3D11CreateDevice( nullptr, D3D_DRIVER_TYPE_WARP,
+        nullptr, 0u, nullptr, 0u, D3D11_SDK_VERSION, &pDevice, nullptr, nullptr
+    );
+    return SUCCEEDED(hr) ? pDevice : nullptr;
+}
+
+#endif  // __MockContext
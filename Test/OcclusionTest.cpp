@@ -0,0 +1,146 @@
+#include <vector>
+#include <random>
+#include <iostream>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Scenery/Occlusion.hpp"
+#include "Timer.hpp"
+
+using gfx::Transform;
+using gfx::scenery::BoundingBox;
+using gfx::scenery::OcclusionBuffer;
+
+namespace {
+
+// looking down +z from the origin, near plane at 0.5.
+Transform makeViewProj() {
+    return dx::XMMatrixPerspectiveFovLH(
+        dx::XM_PIDIV2, 2.f, 0.5f, 100.f
+    );
+}
+
+// the unit cube scaled by half extents, then moved to center.
+Transform makeBoxWorld( float cx, float cy, float cz,
+    float ex, float ey, float ez
+) {
+    return dx::XMMatrixScaling(ex, ey, ez)
+        * dx::XMMatrixTranslation(cx, cy, cz);
+}
+
+BoundingBox makeBox( float lx, float ly, float lz,
+    float hx, float hy, float hz
+) {
+    return BoundingBox{
+        .lo = dx::XMFLOAT3(lx, ly, lz),
+        .hi = dx::XMFLOAT3(hx, hy, hz)
+    };
+}
+
+}   // namespace
+
+TEST(Occlusion, FullyHidden)
+{
+    auto buffer = OcclusionBuffer();
+    buffer.clear( makeViewProj() );
+    // a wall spanning z 4.5 ~ 5.5.
+    buffer.rasterizeBox( makeBoxWorld(0.f, 0.f, 5.f, 4.f, 4.f, 0.5f) );
+
+    EXPECT_FALSE( buffer.visible( makeBox(-1.f, -1.f, 10.f, 1.f, 1.f, 12.f) ) );
+    // before the wall.
+    EXPECT_TRUE( buffer.visible( makeBox(-1.f, -1.f, 2.f, 1.f, 1.f, 3.f) ) );
+}
+
+TEST(Occlusion, PartlyHidden)
+{
+    auto buffer = OcclusionBuffer();
+    buffer.clear( makeViewProj() );
+    buffer.rasterizeBox( makeBoxWorld(0.f, 0.f, 5.f, 4.f, 4.f, 0.5f) );
+
+    // sticks out past the right edge of the wall.
+    EXPECT_TRUE( buffer.visible( makeBox(3.f, -1.f, 10.f, 12.f, 1.f, 12.f) ) );
+}
+
+TEST(Occlusion, NearPlaneCrossingOccluderSkipped)
+{
+    auto buffer = OcclusionBuffer();
+    buffer.clear( makeViewProj() );
+    // spans z -0.5 ~ 1.5, through the near plane.
+    buffer.rasterizeBox( makeBoxWorld(0.f, 0.f, 0.5f, 4.f, 4.f, 1.f) );
+
+    EXPECT_TRUE( buffer.visible( makeBox(-1.f, -1.f, 10.f, 1.f, 1.f, 12.f) ) );
+}
+
+TEST(Occlusion, NearPlaneCrossingBoxVisible)
+{
+    auto buffer = OcclusionBuffer();
+    buffer.clear( makeViewProj() );
+    buffer.rasterizeBox( makeBoxWorld(0.f, 0.f, 5.f, 4.f, 4.f, 0.5f) );
+
+    // can't be projected, so it's never taken as hidden.
+    EXPECT_TRUE( buffer.visible( makeBox(-1.f, -1.f, 0.f, 1.f, 1.f, 12.f) ) );
+}
+
+// a frame's worth of occluders and queries, as the renderer runs them.
+TEST(OcclusionBenchmark, RasterizeAndQuery)
+{
+    constexpr auto nOccluder = std::size_t(16u);
+    constexpr auto nQuery = std::size_t(10000u);
+    constexpr auto nFrame = std::size_t(20u);
+
+    auto rng = std::mt19937(42u);
+    auto xy = std::uniform_real_distribution<float>(-20.f, 20.f);
+    auto nearZ = std::uniform_real_distribution<float>(4.f, 10.f);
+    auto farZ = std::uniform_real_distribution<float>(12.f, 60.f);
+
+    auto occluders = std::vector<Transform>();
+    for (std::size_t i = 0u; i < nOccluder; ++i) {
+        occluders.push_back(
+            makeBoxWorld( xy(rng), xy(rng), nearZ(rng), 4.f, 4.f, 0.5f )
+        );
+    }
+
+    auto queries = std::vector<BoundingBox>();
+    for (std::size_t i = 0u; i < nQuery; ++i) {
+        const auto x = xy(rng);
+        const auto y = xy(rng);
+        const auto z = farZ(rng);
+        queries.push_back( makeBox(x - 1.f, y - 1.f, z - 1.f,
+            x + 1.f, y + 1.f, z + 1.f
+        ) );
+    }
+
+    auto buffer = OcclusionBuffer();
+    const auto viewProj = makeViewProj();
+    auto rasterizeTime = Timer<double, std::milli>::duration();
+    auto queryTime = Timer<double, std::milli>::duration();
+    auto nVisible = std::size_t(0u);
+
+    auto timer = Timer<double, std::milli>();
+    for (std::size_t frame = 0u; frame < nFrame; ++frame) {
+        timer.mark();
+        buffer.clear(viewProj);
+        for (const auto& occluder : occluders) {
+            buffer.rasterizeBox(occluder);
+        }
+        rasterizeTime += timer.mark();
+
+        nVisible = 0u;
+        for (const auto& query : queries) {
+            nVisible += buffer.visible(query);
+        }
+        queryTime += timer.mark();
+    }
+
+    EXPECT_LE(nVisible, nQuery);
+
+    std::cout << nOccluder << " occluders, " << nQuery << " queries, "
+        << nFrame << " frames, " << nQuery - nVisible << " hidden\n"
+        << "    rasterize: " << rasterizeTime.count() / nFrame << "ms/frame\n"
+        << "    query: " << queryTime.count() / nFrame << "ms/frame\n";
+    RecordProperty( "RasterizeMs",
+        std::to_string( rasterizeTime.count() / nFrame )
+    );
+    RecordProperty( "QueryMs", std::to_string( queryTime.count() / nFrame ) );
+}
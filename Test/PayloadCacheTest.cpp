@@ -0,0 +1,312 @@
+#include <vector>
+#include <string>
+#include <string_view>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Core/PayloadCache.hpp"
+#include "Timer.hpp"
+
+namespace {
+
+struct VertexTag {};
+struct IndexTag {};
+
+// a fresh path in the temp directory, left behind by no earlier run.
+std::filesystem::path makeCachePath(std::string_view name) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    return path;
+}
+
+// stands in for tesselating a primitive, seeded so payloads differ.
+std::vector<float> generate(std::size_t n, float seed) {
+    auto ret = std::vector<float>();
+    ret.reserve(n);
+    for (std::size_t i = 0u; i < n; ++i) {
+        ret.push_back( std::sin( seed + static_cast<float>(i) * 0.01f ) );
+    }
+    return ret;
+}
+
+std::vector<char> readFile(const std::filesystem::path& path) {
+    auto in = std::ifstream(path, std::ios::binary);
+    return std::vector<char>( std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>()
+    );
+}
+
+void writeFile(const std::filesystem::path& path, const std::vector<char>& bytes) {
+    auto out = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    out.write( bytes.data(), bytes.size() );
+}
+
+// fetches the payload, counting whether it had to be generated.
+std::span<const float> fetch( gfx::GFXPayloadCache& cache,
+    const gfx::GFXContentKey& key, float seed, std::size_t& nGenerate
+) {
+    return cache.fetch<float>( key, [&] {
+        ++nGenerate;
+        return generate(64u, seed);
+    } );
+}
+
+bool holds(std::span<const float> payload, float seed) {
+    return std::ranges::equal( payload, generate(64u, seed) );
+}
+
+}   // namespace
+
+TEST(PayloadCache, SaveAndRemapRoundTrip)
+{
+    const auto path = makeCachePath("PayloadCacheRoundTrip.cache");
+    const auto key = gfx::GFXContentKey::make<VertexTag>(16, 16);
+    auto nGenerate = std::size_t(0u);
+
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        EXPECT_TRUE( holds( fetch(cache, key, 1.f, nGenerate), 1.f ) );
+        EXPECT_TRUE( holds( fetch(cache, key, 1.f, nGenerate), 1.f ) );
+        EXPECT_EQ(nGenerate, 1u);
+
+        ASSERT_TRUE( cache.save() );
+        // remapped from the file just written.
+        EXPECT_TRUE( holds( fetch(cache, key, 1.f, nGenerate), 1.f ) );
+        EXPECT_EQ(nGenerate, 1u);
+    }
+
+    // unmapped before the file is removed.
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        EXPECT_TRUE( holds( fetch(cache, key, 1.f, nGenerate), 1.f ) );
+        EXPECT_EQ(nGenerate, 1u);
+        EXPECT_EQ(cache.nHit(), 1u);
+        EXPECT_EQ(cache.nMiss(), 0u);
+    }
+
+    std::filesystem::remove(path);
+}
+
+// keys are told apart by the whole key, not only by its hash.
+TEST(PayloadCache, DistinctKeysKeptApart)
+{
+    const auto path = makeCachePath("PayloadCacheDistinct.cache");
+    const auto keys = std::vector<gfx::GFXContentKey>{
+        gfx::GFXContentKey::make<VertexTag>(16, 16),
+        gfx::GFXContentKey::make<VertexTag>(16, 17),
+        gfx::GFXContentKey::make<IndexTag>(16, 16),
+        gfx::GFXContentKey::make<VertexTag>(16)
+    };
+    auto nGenerate = std::size_t(0u);
+
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        for (std::size_t i = 0u; i < keys.size(); ++i) {
+            fetch( cache, keys[i], static_cast<float>(i), nGenerate );
+        }
+        // the same key with another element size is another payload.
+        const auto indices = cache.fetch<std::uint16_t>( keys[0],
+            [] { return std::vector<std::uint16_t>{ 0u, 1u, 2u }; }
+        );
+        EXPECT_EQ(indices.size(), 3u);
+        ASSERT_TRUE( cache.save() );
+    }
+    EXPECT_EQ(nGenerate, keys.size());
+
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        for (std::size_t i = 0u; i < keys.size(); ++i) {
+            EXPECT_TRUE( holds( fetch( cache, keys[i], static_cast<float>(i),
+                nGenerate
+            ), static_cast<float>(i) ) );
+        }
+        EXPECT_EQ(nGenerate, keys.size());
+        EXPECT_EQ( cache.fetch<std::uint16_t>( keys[0],
+            [] { return std::vector<std::uint16_t>(); }
+        ).size(), 3u );
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(PayloadCache, CorruptPayloadRegenerated)
+{
+    const auto path = makeCachePath("PayloadCacheCorrupt.cache");
+    const auto first = gfx::GFXContentKey::make<VertexTag>(1);
+    const auto second = gfx::GFXContentKey::make<VertexTag>(2);
+    auto nGenerate = std::size_t(0u);
+
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        fetch(cache, first, 1.f, nGenerate);
+        fetch(cache, second, 2.f, nGenerate);
+        ASSERT_TRUE( cache.save() );
+    }
+
+    // payloads are a whole number of alignments, so the file ends in one.
+    auto bytes = readFile(path);
+    bytes.back() ^= 0x5a;
+    writeFile(path, bytes);
+
+    nGenerate = 0u;
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        EXPECT_TRUE( holds( fetch(cache, first, 1.f, nGenerate), 1.f ) );
+        EXPECT_TRUE( holds( fetch(cache, second, 2.f, nGenerate), 2.f ) );
+        EXPECT_EQ(nGenerate, 1u);
+        // the regenerated payload is written back.
+        ASSERT_TRUE( cache.save() );
+    }
+
+    nGenerate = 0u;
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        fetch(cache, first, 1.f, nGenerate);
+        fetch(cache, second, 2.f, nGenerate);
+        EXPECT_EQ(nGenerate, 0u);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(PayloadCache, BadRecordsChecksumDropsAll)
+{
+    const auto path = makeCachePath("PayloadCacheRecords.cache");
+    const auto first = gfx::GFXContentKey::make<VertexTag>(1);
+    const auto second = gfx::GFXContentKey::make<IndexTag>(2);
+    auto nGenerate = std::size_t(0u);
+
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        fetch(cache, first, 1.f, nGenerate);
+        fetch(cache, second, 2.f, nGenerate);
+        ASSERT_TRUE( cache.save() );
+    }
+
+    // a type name is covered by the records checksum.
+    auto bytes = readFile(path);
+    const auto name = first.typeName();
+    const auto found = std::ranges::search(bytes, name);
+    ASSERT_FALSE( found.empty() );
+    found.front() ^= 0x5a;
+    writeFile(path, bytes);
+
+    nGenerate = 0u;
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        EXPECT_TRUE( holds( fetch(cache, first, 1.f, nGenerate), 1.f ) );
+        EXPECT_TRUE( holds( fetch(cache, second, 2.f, nGenerate), 2.f ) );
+        EXPECT_EQ(nGenerate, 2u);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(PayloadCache, StaleVersionDropsAll)
+{
+    const auto path = makeCachePath("PayloadCacheVersion.cache");
+    const auto key = gfx::GFXContentKey::make<VertexTag>(1);
+    auto nGenerate = std::size_t(0u);
+
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        fetch(cache, key, 1.f, nGenerate);
+        ASSERT_TRUE( cache.save() );
+    }
+
+    // the version follows the 4 bytes of magic.
+    auto bytes = readFile(path);
+    const auto bumped = gfx::GFXPayloadCache::formatVersion + 1u;
+    std::copy_n( reinterpret_cast<const char*>(&bumped), sizeof(bumped),
+        bytes.begin() + 4
+    );
+    writeFile(path, bytes);
+
+    nGenerate = 0u;
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        EXPECT_TRUE( holds( fetch(cache, key, 1.f, nGenerate), 1.f ) );
+        EXPECT_EQ(nGenerate, 1u);
+    }
+
+    // a truncated file is no better.
+    bytes.resize( bytes.size() / 2u );
+    writeFile(path, bytes);
+
+    nGenerate = 0u;
+    {
+        auto cache = gfx::GFXPayloadCache();
+        cache.open(path);
+        EXPECT_TRUE( holds( fetch(cache, key, 1.f, nGenerate), 1.f ) );
+        EXPECT_EQ(nGenerate, 1u);
+    }
+
+    std::filesystem::remove(path);
+}
+
+// startup with the primitives generated against mapped from the cache.
+TEST(PayloadCacheBenchmark, ColdStart)
+{
+    constexpr auto nPayload = std::size_t(200u);
+    constexpr auto nFloat = std::size_t(16000u);
+
+    const auto path = makeCachePath("PayloadCacheBenchmark.cache");
+    const auto fetchAll = [&](gfx::GFXPayloadCache& cache) {
+        auto sum = 0.f;
+        for (std::size_t i = 0u; i < nPayload; ++i) {
+            const auto payload = cache.fetch<float>(
+                gfx::GFXContentKey::make<VertexTag>(i),
+                [i] { return generate( nFloat, static_cast<float>(i) ); }
+            );
+            sum += payload.back();
+        }
+        return sum;
+    };
+
+    {
+        auto timer = Timer<double, std::milli>();
+
+        auto cold = gfx::GFXPayloadCache();
+        cold.open(path);
+        const auto coldSum = fetchAll(cold);
+        const auto coldTime = timer.mark();
+        ASSERT_TRUE( cold.save() );
+
+        timer.mark();
+        auto warm = gfx::GFXPayloadCache();
+        warm.open(path);
+        const auto warmSum = fetchAll(warm);
+        const auto warmTime = timer.mark();
+
+        EXPECT_EQ(coldSum, warmSum);
+        EXPECT_EQ(cold.nMiss(), nPayload);
+        EXPECT_EQ(warm.nHit(), nPayload);
+
+        std::cout << nPayload << " payloads of " << nFloat << " floats\n"
+            << "    generated: " << coldTime.count() << "ms\n"
+            << "    mapped: " << warmTime.count() << "ms\n";
+        RecordProperty( "GeneratedMs", std::to_string( coldTime.count() ) );
+        RecordProperty( "MappedMs", std::to_string( warmTime.count() ) );
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,209 @@
+#include <array>
+#include <vector>
+#include <string_view>
+#include <filesystem>
+#include <optional>
+#include <utility>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "MockContext.hpp"
+
+#include <d3dcompiler.h>
+
+#include "GFX/Core/Pipeline.hpp"
+#include "GFX/Core/Factory.hpp"
+#include "GFX/PipelineObjects/Shader.hpp"
+#include "GFX/PipelineObjects/PipelineStateObject.hpp"
+
+using gfx::po::PipelineStateDesc;
+using gfx::po::PipelineStateObject;
+
+namespace {
+
+constexpr std::string_view vertexShaderSource =
+    "float4 main(float3 pos : Position) : SV_Position"
+    "{ return float4(pos, 1.f); }";
+constexpr std::string_view pixelShaderSource =
+    "float4 main() : SV_Target { return float4(1.f, 1.f, 1.f, 1.f); }";
+
+const auto inputElemDescs = std::array<D3D11_INPUT_ELEMENT_DESC, 1u>{
+    D3D11_INPUT_ELEMENT_DESC{ .SemanticName = "Position",
+        .SemanticIndex = 0,
+        .Format = DXGI_FORMAT_R32G32B32_FLOAT,
+        .InputSlot = 0,
+        .AlignedByteOffset = 0,
+        .InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA,
+        .InstanceDataStepRate = 0
+    }
+};
+
+constexpr auto fullViewport = D3D11_VIEWPORT{
+    .TopLeftX = 0.f, .TopLeftY = 0.f, .Width = 800.f, .Height = 600.f,
+    .MinDepth = 0.f, .MaxDepth = 1.f
+};
+
+constexpr auto halfViewport = D3D11_VIEWPORT{
+    .TopLeftX = 0.f, .TopLeftY = 0.f, .Width = 400.f, .Height = 600.f,
+    .MinDepth = 0.f, .MaxDepth = 1.f
+};
+
+// shaders are read from compiled files, so the sources are compiled to ones.
+// empty where no compiler is available.
+std::filesystem::path compileShader( std::string_view source,
+    const char* target, const wchar_t* fileName
+) {
+    auto pBlob = wrl::ComPtr<ID3DBlob>();
+    if ( FAILED( D3DCompile( source.data(), source.size(), nullptr, nullptr,
+        nullptr, "main", target, 0u, 0u, &pBlob, nullptr
+    ) ) ) {
+        return {};
+    }
+
+    const auto path = std::filesystem::temp_directory_path()/fileName;
+    if ( FAILED( D3DWriteBlobToFile( pBlob.Get(), path.c_str(), TRUE ) ) ) {
+        return {};
+    }
+    return path;
+}
+
+// a device with the shaders every state object here is made of.
+struct Fixture {
+    Fixture()
+        : factory( makeWarpDevice() ), vertexShader(), pixelShader() {
+        if ( !factory.device() ) {
+            return;
+        }
+
+        const auto vsPath = compileShader( vertexShaderSource, "vs_4_0",
+            L"PipelineStateObjectTestVS.cso"
+        );
+        const auto psPath = compileShader( pixelShaderSource, "ps_4_0",
+            L"PipelineStateObjectTestPS.cso"
+        );
+        if ( vsPath.empty() || psPath.empty() ) {
+            return;
+        }
+
+        vertexShader.emplace(factory, inputElemDescs, vsPath);
+        pixelShader.emplace(factory, psPath);
+    }
+
+    gfx::GFXFactory factory;
+    std::optional<gfx::po::VertexShader> vertexShader;
+    std::optional<gfx::po::PixelShader> pixelShader;
+
+    bool ready() const noexcept {
+        return vertexShader.has_value() && pixelShader.has_value();
+    }
+
+    PipelineStateObject makeState( D3D11_PRIMITIVE_TOPOLOGY topology,
+        const D3D11_VIEWPORT& viewport,
+        wrl::ComPtr<ID3D11RasterizerState> pRasterizerState = nullptr
+    ) const {
+        return PipelineStateObject( vertexShader.value(), pixelShader.value(),
+            PipelineStateDesc{
+                .topology = topology,
+                .viewport = viewport,
+                .pRasterizerState = std::move(pRasterizerState)
+            }
+        );
+    }
+};
+
+using Calls = std::vector<std::string_view>;
+
+}   // namespace
+
+// bound again, the state object is compared as a whole, not part by part.
+TEST(PipelineStateObject, RebindIsOneCompare)
+{
+    const auto fixture = Fixture();
+    if ( !fixture.ready() ) {
+        GTEST_SKIP() << "no WARP device or shader compiler";
+    }
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    auto state = fixture.makeState( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+        fullViewport
+    );
+
+    pipeline.bind(&state);
+    pipeline.advanceFrame();
+    EXPECT_EQ( context.stateBinds, ( Calls{
+        "VSSetShader", "IASetInputLayout", "PSSetShader",
+        "IASetPrimitiveTopology", "RSSetViewports", "RSSetState",
+        "OMSetBlendState", "OMSetDepthStencilState"
+    } ) );
+    // the seven parts and the state object itself.
+    EXPECT_EQ(pipeline.state().frameCounters().nBind, 8u);
+
+    context.stateBinds.clear();
+    for (std::size_t i = 0u; i < 3u; ++i) {
+        pipeline.bind(&state);
+    }
+    pipeline.advanceFrame();
+
+    EXPECT_TRUE( context.stateBinds.empty() );
+    EXPECT_EQ(pipeline.state().frameCounters().nBind, 0u);
+    EXPECT_EQ(pipeline.state().frameCounters().nElided, 3u);
+}
+
+TEST(PipelineStateObject, SwitchPushesDifferingParts)
+{
+    const auto fixture = Fixture();
+    if ( !fixture.ready() ) {
+        GTEST_SKIP() << "no WARP device or shader compiler";
+    }
+
+    const auto rasterizerDesc = D3D11_RASTERIZER_DESC{
+        .FillMode = D3D11_FILL_SOLID,
+        .CullMode = D3D11_CULL_NONE,
+        .DepthClipEnable = TRUE
+    };
+    auto pRasterizerState = wrl::ComPtr<ID3D11RasterizerState>();
+    ASSERT_TRUE( SUCCEEDED( fixture.factory.device()->CreateRasterizerState(
+        &rasterizerDesc, &pRasterizerState
+    ) ) );
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    auto triangles = fixture.makeState( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+        fullViewport
+    );
+    auto lines = fixture.makeState( D3D11_PRIMITIVE_TOPOLOGY_LINELIST,
+        fullViewport
+    );
+    auto unculled = fixture.makeState( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+        halfViewport, pRasterizerState
+    );
+
+    pipeline.bind(&triangles);
+    pipeline.advanceFrame();
+
+    const auto switchTo = [&](PipelineStateObject& state) {
+        context.stateBinds.clear();
+        pipeline.bind(&state);
+        pipeline.advanceFrame();
+        return context.stateBinds;
+    };
+
+    EXPECT_EQ( switchTo(lines), Calls{ "IASetPrimitiveTopology" } );
+    // the part that differs and the state object, the rest elided.
+    EXPECT_EQ(pipeline.state().frameCounters().nBind, 2u);
+    EXPECT_EQ(pipeline.state().frameCounters().nElided, 6u);
+
+    EXPECT_EQ( switchTo(unculled), ( Calls{
+        "IASetPrimitiveTopology", "RSSetViewports", "RSSetState"
+    } ) );
+    EXPECT_EQ( switchTo(triangles), ( Calls{
+        "RSSetViewports", "RSSetState"
+    } ) );
+    EXPECT_TRUE( switchTo(triangles).empty() );
+}
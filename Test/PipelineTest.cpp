@@ -0,0 +1,96 @@
+#include <vector>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "MockContext.hpp"
+
+#include "GFX/Core/Pipeline.hpp"
+#include "GFX/Core/Factory.hpp"
+#include "GFX/PipelineObjects/Buffer.hpp"
+
+namespace {
+
+using CBuf = gfx::po::VSCBuffer<dx::XMFLOAT4>;
+
+CBuf makeCBuf(gfx::GFXFactory factory) {
+    return CBuf( factory, D3D11_USAGE_DEFAULT, 0u,
+        std::vector<dx::XMFLOAT4>( 1u, dx::XMFLOAT4() )
+    );
+}
+
+}   // namespace
+
+TEST(Pipeline, ElidesRebind)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    auto first = makeCBuf(factory);
+    auto second = makeCBuf(factory);
+
+    pipeline.bind(&first);
+    pipeline.bind(&first);
+    pipeline.bind(&second);
+    pipeline.bind(&second);
+    pipeline.bind(&first);
+    pipeline.advanceFrame();
+
+    const auto expected = std::vector<ID3D11Buffer*>{
+        first.data().Get(), second.data().Get(), first.data().Get()
+    };
+    EXPECT_EQ(context.vsCBuffers, expected);
+    EXPECT_EQ(pipeline.state().frameCounters().nBind, 3u);
+    EXPECT_EQ(pipeline.state().frameCounters().nElided, 2u);
+
+    // a copy shares the shadow, what one bound the other elides.
+    auto copy = pipeline;
+    copy.bind(&first);
+    copy.advanceFrame();
+    EXPECT_EQ(context.vsCBuffers.size(), 3u);
+    EXPECT_EQ(pipeline.state().frameCounters().nElided, 1u);
+    EXPECT_EQ(pipeline.state().totalCounters().nElided, 3u);
+}
+
+// a copy of the pipeline follows it to a new context,
+// and doesn't elide binds against the old context's shadow.
+TEST(Pipeline, CopiesFollowSetContext)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto oldContext = MockContext();
+    auto newContext = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&oldContext)
+    );
+    auto copy = pipeline;
+    auto cbuf = makeCBuf(factory);
+
+    pipeline.bind(&cbuf);
+    pipeline.setContext( wrl::ComPtr<ID3D11DeviceContext>(&newContext) );
+
+    EXPECT_EQ( copy.context().Get(), &newContext );
+    copy.bind(&cbuf);
+    copy.bind(&cbuf);
+    copy.advanceFrame();
+
+    EXPECT_EQ(oldContext.vsCBuffers.size(), 1u);
+    EXPECT_EQ( newContext.vsCBuffers,
+        std::vector<ID3D11Buffer*>{ cbuf.data().Get() }
+    );
+    EXPECT_EQ(pipeline.state().frameCounters().nBind, 1u);
+    EXPECT_EQ(pipeline.state().frameCounters().nElided, 1u);
+
+    // so does the upload ring.
+    pipeline.setUploadRing( std::make_shared<gfx::GFXUploadRing>(factory) );
+    EXPECT_EQ( copy.uploadRing(), pipeline.uploadRing() );
+}
@@ -0,0 +1,114 @@
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "RadixSort.hpp"
+#include "Timer.hpp"
+
+namespace {
+
+struct Entry {
+    std::uint64_t key;
+    std::uint32_t idx;
+};
+
+// laid out like draw sort keys: | type 8 | material 20 | buffer 20 | depth 16 |
+// with few types, materials and buffers, and depth varying the most.
+std::vector<Entry> makeDrawKeys(std::size_t n, std::uint32_t seed) {
+    auto rng = std::mt19937(seed);
+    auto type = std::uniform_int_distribution<std::uint64_t>(0u, 3u);
+    auto material = std::uniform_int_distribution<std::uint64_t>(0u, 63u);
+    auto buffer = std::uniform_int_distribution<std::uint64_t>(0u, 255u);
+    auto depth = std::uniform_int_distribution<std::uint64_t>(0u, 0xffffu);
+
+    auto ret = std::vector<Entry>(n);
+    for (std::size_t i = 0u; i < n; ++i) {
+        ret[i] = Entry{
+            .key = type(rng) << 56u | material(rng) << 36u
+                | buffer(rng) << 16u | depth(rng),
+            .idx = static_cast<std::uint32_t>(i)
+        };
+    }
+    return ret;
+}
+
+}   // namespace
+
+TEST(RadixSort, MatchesStableSort)
+{
+    auto entries = makeDrawKeys(10000u, 42u);
+    auto expected = entries;
+    auto scratch = std::vector<Entry>();
+
+    radixSort( entries, scratch, &Entry::key );
+    std::ranges::stable_sort( expected, std::less<>{}, &Entry::key );
+
+    ASSERT_EQ( entries.size(), expected.size() );
+    for (std::size_t i = 0u; i < entries.size(); ++i) {
+        EXPECT_EQ(entries[i].key, expected[i].key);
+        EXPECT_EQ(entries[i].idx, expected[i].idx);
+    }
+}
+
+TEST(RadixSort, EqualKeysKeepOrder)
+{
+    auto entries = std::vector<Entry>();
+    for (std::uint32_t i = 0u; i < 100u; ++i) {
+        entries.push_back( Entry{ .key = 7u, .idx = i } );
+    }
+    auto scratch = std::vector<Entry>();
+
+    radixSort( entries, scratch, &Entry::key );
+
+    for (std::uint32_t i = 0u; i < 100u; ++i) {
+        EXPECT_EQ(entries[i].idx, i);
+    }
+}
+
+// draws of a frame sorted by their keys, against std::sort.
+TEST(RadixSortBenchmark, DrawKeysAgainstSort)
+{
+    constexpr auto nRepeat = std::size_t(20u);
+
+    for (const auto nDraw : { std::size_t(1000u), std::size_t(10000u),
+        std::size_t(100000u) }
+    ) {
+        const auto source = makeDrawKeys(nDraw, 42u);
+        auto entries = std::vector<Entry>();
+        auto scratch = std::vector<Entry>();
+
+        auto timer = Timer<double, std::milli>();
+        for (std::size_t i = 0u; i < nRepeat; ++i) {
+            entries = source;
+            radixSort( entries, scratch, &Entry::key );
+        }
+        const auto radixTime = timer.mark() / nRepeat;
+        const auto radixSorted = entries;
+
+        timer.mark();
+        for (std::size_t i = 0u; i < nRepeat; ++i) {
+            entries = source;
+            std::ranges::sort( entries, std::less<>{}, &Entry::key );
+        }
+        const auto sortTime = timer.mark() / nRepeat;
+
+        EXPECT_TRUE( std::ranges::equal( radixSorted, entries, {},
+            &Entry::key, &Entry::key
+        ) );
+
+        std::cout << nDraw << " draw keys\n"
+            << "    radixSort: " << radixTime.count() << "ms\n"
+            << "    std::sort: " << sortTime.count() << "ms\n";
+        RecordProperty( "RadixSortMs" + std::to_string(nDraw),
+            std::to_string( radixTime.count() )
+        );
+        RecordProperty( "SortMs" + std::to_string(nDraw),
+            std::to_string( sortTime.count() )
+        );
+    }
+}
@@ -0,0 +1,112 @@
+#include <vector>
+#include <utility>
+#include <cstring>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "MockContext.hpp"
+
+#include "GFX/Core/Pipeline.hpp"
+#include "GFX/Core/Factory.hpp"
+#include "GFX/PipelineObjects/Buffer.hpp"
+
+namespace {
+
+using ColorCBuf = gfx::po::ShadowedCBuffer<
+    gfx::po::PSCBuffer<dx::XMFLOAT4>
+>;
+
+const auto red = dx::XMFLOAT4(1.f, 0.f, 0.f, 1.f);
+const auto green = dx::XMFLOAT4(0.f, 1.f, 0.f, 1.f);
+
+// created holding red, as dynamic buffers are written by map
+// and default ones through the upload queue.
+ColorCBuf makeCBuf(gfx::GFXFactory factory, D3D11_USAGE usage) {
+    return ColorCBuf( red, std::move(factory), usage,
+        usage == D3D11_USAGE_DYNAMIC ? D3D11_CPU_ACCESS_WRITE : 0u,
+        std::vector<dx::XMFLOAT4>( 1u, red )
+    );
+}
+
+bool holds(const std::vector<std::byte>& bytes, const dx::XMFLOAT4& value) {
+    return bytes.size() == sizeof(value)
+        && std::memcmp( bytes.data(), &value, sizeof(value) ) == 0;
+}
+
+// closes the frame, for its counters to be read.
+gfx::GFXPipelineCounters counters(gfx::GFXPipeline& pipeline) {
+    pipeline.advanceFrame();
+    return pipeline.state().frameCounters();
+}
+
+}   // namespace
+
+TEST(ShadowedCBuffer, DynamicUploadsOnlyChanges)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    auto cbuf = makeCBuf(factory, D3D11_USAGE_DYNAMIC);
+
+    // what it was created with counts as uploaded.
+    cbuf.update(pipeline, red);
+    cbuf.update(pipeline, red);
+    auto frame = counters(pipeline);
+    EXPECT_TRUE( context.maps.empty() );
+    EXPECT_EQ(frame.nUpload, 0u);
+    EXPECT_EQ(frame.nUploadSkipped, 2u);
+
+    cbuf.update(pipeline, green);
+    cbuf.update(pipeline, green);
+    frame = counters(pipeline);
+    ASSERT_EQ(context.maps.size(), 1u);
+    EXPECT_EQ( context.maps[0].pResource, cbuf.data().Get() );
+    EXPECT_EQ(context.maps[0].mapType, D3D11_MAP_WRITE_DISCARD);
+    EXPECT_TRUE( holds(context.mapped, green) );
+    EXPECT_TRUE( context.updates.empty() );
+    EXPECT_EQ(frame.nUpload, 1u);
+    EXPECT_EQ(frame.nUploadSkipped, 1u);
+}
+
+TEST(ShadowedCBuffer, DefaultStagesOnlyChanges)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    auto cbuf = makeCBuf(factory, D3D11_USAGE_DEFAULT);
+
+    cbuf.update(pipeline, red);
+    EXPECT_TRUE( pipeline.uploadQueue().empty() );
+    pipeline.flushUploads();
+    auto frame = counters(pipeline);
+    EXPECT_TRUE( context.updates.empty() );
+    EXPECT_EQ(frame.nUpload, 0u);
+    EXPECT_EQ(frame.nUploadSkipped, 1u);
+
+    cbuf.update(pipeline, green);
+    cbuf.update(pipeline, green);
+    pipeline.flushUploads();
+    frame = counters(pipeline);
+    // written whole, without a box.
+    ASSERT_EQ(context.updates.size(), 1u);
+    EXPECT_EQ( context.updates[0].pResource, cbuf.data().Get() );
+    EXPECT_FALSE(context.updates[0].bBox);
+    EXPECT_TRUE( holds(context.updates[0].bytes, green) );
+    EXPECT_TRUE( context.maps.empty() );
+    EXPECT_EQ(frame.nUpload, 1u);
+    EXPECT_EQ(frame.nUploadSkipped, 1u);
+    EXPECT_EQ(pipeline.uploadQueue().frameCounters().nUpload, 1u);
+}
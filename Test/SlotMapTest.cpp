@@ -0,0 +1,158 @@
+#include <map>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <iostream>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "SlotMap.hpp"
+#include "Timer.hpp"
+
+TEST(SlotMap, EmplaceFind)
+{
+    auto slotMap = SlotMap<int>();
+    const auto key1 = slotMap.emplace(1);
+    const auto key2 = slotMap.emplace(2);
+
+    ASSERT_NE(slotMap.find(key1), nullptr);
+    ASSERT_NE(slotMap.find(key2), nullptr);
+    EXPECT_EQ(*slotMap.find(key1), 1);
+    EXPECT_EQ(*slotMap.find(key2), 2);
+    EXPECT_EQ(slotMap.size(), 2u);
+}
+
+TEST(SlotMap, StaleKey)
+{
+    auto slotMap = SlotMap<int>();
+    const auto key = slotMap.emplace(1);
+    EXPECT_TRUE( slotMap.erase(key) );
+
+    // the slot is reused with a newer generation.
+    const auto reused = slotMap.emplace(2);
+    EXPECT_EQ(reused.index, key.index);
+    EXPECT_NE(reused.generation, key.generation);
+    EXPECT_EQ(slotMap.find(key), nullptr);
+    EXPECT_FALSE( slotMap.erase(key) );
+    EXPECT_EQ(*slotMap.find(reused), 2);
+}
+
+TEST(SlotMap, EraseKeepsOthers)
+{
+    auto slotMap = SlotMap<int>();
+    auto keys = std::vector<SlotMapKey>();
+    for (int i = 0; i < 100; ++i) {
+        keys.push_back( slotMap.emplace(i) );
+    }
+
+    for (int i = 0; i < 100; i += 3) {
+        EXPECT_TRUE( slotMap.erase(keys[i]) );
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            EXPECT_FALSE( slotMap.contains(keys[i]) );
+        }
+        else {
+            ASSERT_TRUE( slotMap.contains(keys[i]) );
+            EXPECT_EQ(slotMap.at(keys[i]), i);
+        }
+    }
+
+    for (std::size_t i = 0u; i < slotMap.size(); ++i) {
+        EXPECT_EQ( *slotMap.find( slotMap.keyAt(i) ), *(slotMap.begin() + i) );
+    }
+}
+
+namespace {
+
+// erases another element of the map it lives in when destroyed.
+struct Reentering {
+    Reentering(SlotMap<Reentering>* pMap, SlotMapKey victim)
+        : pMap(pMap), victim(victim) {}
+
+    Reentering(Reentering&& other) noexcept
+        : pMap(other.pMap), victim(other.victim) {
+        other.pMap = nullptr;
+    }
+
+    Reentering& operator=(Reentering&& other) noexcept {
+        std::swap(pMap, other.pMap);
+        std::swap(victim, other.victim);
+        return *this;
+    }
+
+    ~Reentering() {
+        if (pMap) {
+            pMap->erase(victim);
+        }
+    }
+
+    SlotMap<Reentering>* pMap;
+    SlotMapKey victim;
+};
+
+}   // namespace
+
+TEST(SlotMap, ReenteringDestructor)
+{
+    auto slotMap = SlotMap<Reentering>();
+    const auto victim = slotMap.emplace(nullptr, SlotMapKey());
+    const auto bystander = slotMap.emplace(nullptr, SlotMapKey());
+    const auto eraser = slotMap.emplace(&slotMap, victim);
+
+    EXPECT_TRUE( slotMap.erase(eraser) );
+    EXPECT_FALSE( slotMap.contains(eraser) );
+    EXPECT_FALSE( slotMap.contains(victim) );
+    ASSERT_TRUE( slotMap.contains(bystander) );
+    EXPECT_EQ(slotMap.size(), 1u);
+    EXPECT_EQ(slotMap.keyAt(0u), bystander);
+}
+
+// random lookups over many resources, against the std::map it replaced.
+TEST(SlotMapBenchmark, LookupAgainstMap)
+{
+    constexpr auto nElement = std::size_t(10000u);
+    constexpr auto nLookup = std::size_t(1000000u);
+
+    auto slotMap = SlotMap<std::uint64_t>();
+    auto treeMap = std::map<SlotMapKey, std::uint64_t>();
+    auto keys = std::vector<SlotMapKey>();
+    slotMap.reserve(nElement);
+
+    for (std::size_t i = 0u; i < nElement; ++i) {
+        const auto key = slotMap.emplace(i);
+        treeMap.emplace(key, i);
+        keys.push_back(key);
+    }
+
+    auto order = std::vector<std::size_t>(nLookup);
+    auto rng = std::mt19937(42u);
+    auto dist = std::uniform_int_distribution<std::size_t>(0u, nElement - 1u);
+    for (auto& idx : order) {
+        idx = dist(rng);
+    }
+
+    auto timer = Timer<double, std::milli>();
+
+    auto sumSlotMap = std::uint64_t(0u);
+    for (auto idx : order) {
+        sumSlotMap += *slotMap.find(keys[idx]);
+    }
+    const auto slotMapTime = timer.mark();
+
+    auto sumTreeMap = std::uint64_t(0u);
+    for (auto idx : order) {
+        sumTreeMap += treeMap.find(keys[idx])->second;
+    }
+    const auto treeMapTime = timer.mark();
+
+    EXPECT_EQ(sumSlotMap, sumTreeMap);
+
+    std::cout << nLookup << " lookups over " << nElement << " elements\n"
+        << "    SlotMap: " << slotMapTime.count() << "ms\n"
+        << "    std::map: " << treeMapTime.count() << "ms\n";
+    RecordProperty( "SlotMapMs", std::to_string( slotMapTime.count() ) );
+    RecordProperty( "MapMs", std::to_string( treeMapTime.count() ) );
+}
@@ -0,0 +1,226 @@
+#include <vector>
+#include <deque>
+#include <random>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Scenery/SortedRun.hpp"
+
+using gfx::scenery::SortedRun;
+
+namespace {
+
+struct Item {
+    std::uint64_t key;
+
+    std::uint64_t sortKey() const noexcept {
+        return key;
+    }
+};
+
+// items live in a deque, so adding more doesn't move them.
+struct Fixture {
+    std::deque<Item> storage;
+    SortedRun<Item> run;
+    std::size_t nPrepared = 0u;
+
+    Item* add(std::uint64_t key) {
+        storage.push_back( Item{ .key = key } );
+        run.add( &storage.back() );
+        return &storage.back();
+    }
+
+    void rekey(Item* item, std::uint64_t key) {
+        item->key = key;
+        run.keyChanged(item);
+    }
+
+    void repair() {
+        run.repair( [this](Item*) { ++nPrepared; } );
+    }
+};
+
+bool sortedByKey(const SortedRun<Item>& run) {
+    return std::ranges::is_sorted( run.items(), std::ranges::less(),
+        &Item::sortKey
+    );
+}
+
+bool holds(const SortedRun<Item>& run, const Item* item) {
+    return std::ranges::find( run.items(), item ) != run.items().end();
+}
+
+}   // namespace
+
+TEST(SortedRun, SortsAdded)
+{
+    auto rng = std::mt19937(1u);
+    auto fixture = Fixture();
+    for (std::size_t i = 0u; i < 1000u; ++i) {
+        fixture.add( rng() % 64u );
+    }
+
+    EXPECT_FALSE( fixture.run.sorted() );
+    fixture.repair();
+    EXPECT_TRUE( fixture.run.sorted() );
+    EXPECT_TRUE( sortedByKey(fixture.run) );
+    EXPECT_EQ( fixture.run.size(), 1000u );
+    EXPECT_EQ( fixture.run.nLastRepaired(), 1000u );
+    EXPECT_EQ( fixture.nPrepared, 1000u );
+}
+
+TEST(SortedRun, StaticRunNotResorted)
+{
+    auto fixture = Fixture();
+    for (std::uint64_t key = 0u; key < 100u; ++key) {
+        fixture.add( (key * 37u) % 100u );
+    }
+    fixture.repair();
+
+    const auto before = std::vector<Item*>(
+        fixture.run.items().begin(), fixture.run.items().end()
+    );
+    fixture.nPrepared = 0u;
+
+    for (std::size_t frame = 0u; frame < 10u; ++frame) {
+        fixture.repair();
+        EXPECT_EQ( fixture.run.nLastRepaired(), 0u );
+    }
+    EXPECT_EQ( fixture.nPrepared, 0u );
+    EXPECT_TRUE( std::ranges::equal( fixture.run.items(), before ) );
+}
+
+TEST(SortedRun, RepairsInsert)
+{
+    auto fixture = Fixture();
+    for (std::uint64_t key = 0u; key < 100u; key += 2u) {
+        fixture.add(key);
+    }
+    fixture.repair();
+
+    // between, before and after the sorted run, and equal to a key in it.
+    const auto added = std::vector<Item*>{
+        fixture.add(51u), fixture.add(0u), fixture.add(1000u), fixture.add(40u)
+    };
+    fixture.nPrepared = 0u;
+    fixture.repair();
+
+    EXPECT_EQ( fixture.run.nLastRepaired(), added.size() );
+    EXPECT_EQ( fixture.nPrepared, added.size() );
+    EXPECT_EQ( fixture.run.size(), 54u );
+    EXPECT_TRUE( sortedByKey(fixture.run) );
+    for (const auto item : added) {
+        EXPECT_TRUE( holds(fixture.run, item) );
+    }
+
+    // what was in the run stays ahead of what joins with an equal key.
+    const auto items = fixture.run.items();
+    EXPECT_EQ( items.front(), &fixture.storage[0] );
+    EXPECT_EQ( items[1], added[1] );
+    EXPECT_EQ( items.back(), added[2] );
+}
+
+TEST(SortedRun, RepairsRemove)
+{
+    auto fixture = Fixture();
+    auto items = std::vector<Item*>();
+    for (std::uint64_t key = 0u; key < 50u; ++key) {
+        items.push_back( fixture.add(49u - key) );
+    }
+    fixture.repair();
+
+    fixture.run.remove( items[10] );
+    fixture.run.remove( items[20] );
+    // removed while pending, it isn't merged back.
+    fixture.rekey( items[30], 1000u );
+    fixture.run.remove( items[30] );
+
+    EXPECT_TRUE( fixture.run.sorted() );
+    fixture.repair();
+    EXPECT_EQ( fixture.run.nLastRepaired(), 0u );
+    EXPECT_EQ( fixture.run.size(), 47u );
+    EXPECT_TRUE( sortedByKey(fixture.run) );
+    EXPECT_FALSE( holds(fixture.run, items[10]) );
+    EXPECT_FALSE( holds(fixture.run, items[20]) );
+    EXPECT_FALSE( holds(fixture.run, items[30]) );
+}
+
+TEST(SortedRun, RepairsKeyChange)
+{
+    auto fixture = Fixture();
+    auto items = std::vector<Item*>();
+    for (std::uint64_t key = 0u; key < 50u; ++key) {
+        items.push_back( fixture.add(key * 10u) );
+    }
+    fixture.repair();
+
+    fixture.rekey( items[0], 495u );
+    fixture.rekey( items[49], 5u );
+    fixture.rekey( items[25], 251u );
+    // reported twice, sorted once.
+    fixture.rekey( items[25], 125u );
+    fixture.nPrepared = 0u;
+    fixture.repair();
+
+    EXPECT_EQ( fixture.run.nLastRepaired(), 3u );
+    EXPECT_EQ( fixture.run.size(), 50u );
+    EXPECT_TRUE( sortedByKey(fixture.run) );
+    EXPECT_EQ( fixture.run.items()[0], items[49] );
+    EXPECT_EQ( fixture.run.items()[49], items[0] );
+}
+
+// preparing an item may change another's key.
+TEST(SortedRun, PrepareMayReportMore)
+{
+    auto fixture = Fixture();
+    const auto first = fixture.add(10u);
+    const auto second = fixture.add(20u);
+    fixture.repair();
+
+    fixture.rekey(first, 30u);
+    fixture.run.repair( [&](Item* item) {
+        if (item == first) {
+            fixture.rekey(second, 40u);
+        }
+    } );
+
+    EXPECT_EQ( fixture.run.nLastRepaired(), 2u );
+    EXPECT_TRUE( fixture.run.sorted() );
+    EXPECT_EQ( fixture.run.items()[0], first );
+    EXPECT_EQ( fixture.run.items()[1], second );
+}
+
+// random edits against sorting everything from scratch.
+TEST(SortedRun, MatchesFullSort)
+{
+    auto rng = std::mt19937(7u);
+    auto fixture = Fixture();
+    auto live = std::vector<Item*>();
+
+    for (std::size_t frame = 0u; frame < 200u; ++frame) {
+        for (std::size_t i = rng() % 8u; i > 0u; --i) {
+            live.push_back( fixture.add( rng() % 256u ) );
+        }
+        for (std::size_t i = rng() % 8u; i > 0u && !live.empty(); --i) {
+            fixture.rekey( live[ rng() % live.size() ], rng() % 256u );
+        }
+        for (std::size_t i = rng() % 4u; i > 0u && !live.empty(); --i) {
+            const auto pos = live.begin() + rng() % live.size();
+            fixture.run.remove(*pos);
+            live.erase(pos);
+        }
+        fixture.repair();
+
+        ASSERT_TRUE( sortedByKey(fixture.run) );
+        auto expected = live;
+        auto actual = std::vector<Item*>(
+            fixture.run.items().begin(), fixture.run.items().end()
+        );
+        std::ranges::sort(expected);
+        std::ranges::sort(actual);
+        ASSERT_EQ(actual, expected);
+    }
+}
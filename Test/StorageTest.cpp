@@ -0,0 +1,453 @@
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "GFX/Core/Storage.hpp"
+#include "Timer.hpp"
+
+namespace {
+
+// holds nothing but claims bytes, so that the budget has something to count.
+class FakeResource : public gfx::po::IPipelineObject {
+public:
+    FakeResource(std::string name, std::size_t bytes)
+        : name_( std::move(name) ), bytes_(bytes) {}
+
+    std::size_t footprint() const noexcept override {
+        return bytes_;
+    }
+
+    const std::string& name() const noexcept {
+        return name_;
+    }
+
+private:
+    void bind(gfx::GFXPipeline&) override {}
+
+    std::string name_;
+    std::size_t bytes_;
+};
+
+// owns what a worker generated for it, as a vertex buffer would.
+class FakeMesh : public gfx::po::IPipelineObject {
+public:
+    explicit FakeMesh(std::vector<float> vertices)
+        : vertices_( std::move(vertices) ) {}
+
+    std::size_t footprint() const noexcept override {
+        return vertices_.size() * sizeof(float);
+    }
+
+private:
+    void bind(gfx::GFXPipeline&) override {}
+
+    std::vector<float> vertices_;
+};
+
+struct FakeTag {};
+struct RecachedTag {};
+
+// stands in for tesselating a sphere, the costly part of a load.
+std::vector<float> generateVertices(std::size_t nVertex) {
+    auto ret = std::vector<float>();
+    ret.reserve(nVertex * 3u);
+    for (std::size_t i = 0u; i < nVertex; ++i) {
+        const auto theta = static_cast<float>(i) * 0.01f;
+        ret.push_back( std::sin(theta) * std::cos(theta * 0.5f) );
+        ret.push_back( std::cos(theta) );
+        ret.push_back( std::sin(theta) * std::sin(theta * 0.5f) );
+    }
+    return ret;
+}
+
+// reads the resources as the renderer does for the frame,
+// which keeps them from being evicted when the frame closes.
+void touch(gfx::GFXStorage& storage, gfx::GFXRes& res) {
+    ASSERT_TRUE( storage.get( res.id() ).has_value() );
+}
+
+}   // namespace
+
+TEST(Storage, EvictsColdestOverBudget)
+{
+    auto storage = gfx::GFXStorage();
+    storage.setBudget(3000u);
+
+    auto cold = gfx::GFXRes::makeLoaded<FakeResource>(storage, "cold", 1000u);
+    auto hot1 = gfx::GFXRes::makeLoaded<FakeResource>(storage, "hot1", 1000u);
+    auto hot2 = gfx::GFXRes::makeLoaded<FakeResource>(storage, "hot2", 1000u);
+    auto hot3 = gfx::GFXRes::makeLoaded<FakeResource>(storage, "hot3", 1000u);
+    EXPECT_EQ(storage.usage(), 4000u);
+
+    // what was loaded during the closed frame counts as used.
+    storage.advanceFrame();
+    EXPECT_EQ(storage.usage(), 4000u);
+    EXPECT_EQ(storage.frameCounters().nEvict, 0u);
+
+    touch(storage, hot1);
+    touch(storage, hot2);
+    touch(storage, hot3);
+    const auto staleID = cold.id();
+    storage.advanceFrame();
+
+    EXPECT_EQ(storage.usage(), 3000u);
+    EXPECT_EQ(storage.frameCounters().nEvict, 1u);
+    EXPECT_FALSE( cold.valid() );
+    EXPECT_TRUE( hot1.valid() );
+    EXPECT_TRUE( hot2.valid() );
+    EXPECT_TRUE( hot3.valid() );
+    EXPECT_FALSE( storage.get(staleID).has_value() );
+
+    // an ID taken again rebuilds the resource.
+    touch(storage, cold);
+    EXPECT_TRUE( cold.valid() );
+    EXPECT_EQ( cold.as<FakeResource>().name(), "cold" );
+    EXPECT_EQ(storage.usage(), 4000u);
+
+    // over budget again, but everything is in use.
+    touch(storage, hot1);
+    touch(storage, hot2);
+    touch(storage, hot3);
+    storage.advanceFrame();
+    EXPECT_EQ(storage.usage(), 4000u);
+    EXPECT_EQ(storage.frameCounters().nReconstruct, 1u);
+    EXPECT_EQ(storage.frameCounters().nEvict, 0u);
+}
+
+TEST(Storage, PinnedNeverEvicted)
+{
+    auto storage = gfx::GFXStorage();
+    storage.setBudget(0u);
+
+    auto pinned = gfx::GFXRes::makeLoaded<FakeResource>(storage, "pinned", 1000u);
+    auto unpinned = gfx::GFXRes::makeLoaded<FakeResource>(storage, "unpinned", 1000u);
+    pinned.pin();
+
+    storage.advanceFrame();
+    storage.advanceFrame();
+
+    EXPECT_TRUE( pinned.valid() );
+    EXPECT_FALSE( unpinned.valid() );
+    EXPECT_EQ(storage.usage(), 1000u);
+
+    pinned.unpin();
+    storage.advanceFrame();
+    EXPECT_FALSE( pinned.valid() );
+    EXPECT_EQ(storage.usage(), 0u);
+}
+
+TEST(Storage, SharedRebuiltOnceAfterEviction)
+{
+    auto storage = gfx::GFXStorage();
+    const auto key = gfx::GFXContentKey::make<FakeResource>(1, 2, 3);
+
+    auto first = gfx::GFXRes::makeShared<FakeResource>(storage, key, "shared", 1000u);
+    auto second = gfx::GFXRes::makeShared<FakeResource>(storage, key, "shared", 1000u);
+    EXPECT_EQ( first.id(), second.id() );
+    EXPECT_EQ(storage.usage(), 1000u);
+
+    storage.setBudget(0u);
+    storage.advanceFrame();
+    storage.advanceFrame();
+
+    EXPECT_FALSE( first.valid() );
+    EXPECT_FALSE( second.valid() );
+    EXPECT_EQ(storage.usage(), 0u);
+
+    // the second picks up what the first rebuilt.
+    storage.setBudget(std::nullopt);
+    touch(storage, second);
+    touch(storage, first);
+    EXPECT_EQ( first.id(), second.id() );
+    EXPECT_EQ(storage.usage(), 1000u);
+}
+
+TEST(Storage, CachedRebuiltAfterEviction)
+{
+    auto storage = gfx::GFXStorage();
+    auto cached = gfx::GFXRes::makeCached<FakeResource>( storage, FakeTag{},
+        "cached", 1000u
+    );
+    ASSERT_TRUE( storage.get<FakeTag>().has_value() );
+
+    storage.setBudget(0u);
+    storage.advanceFrame();
+    storage.advanceFrame();
+    EXPECT_FALSE( cached.valid() );
+    EXPECT_FALSE( storage.get<FakeTag>().has_value() );
+
+    touch(storage, cached);
+    EXPECT_TRUE( storage.get<FakeTag>().has_value() );
+    EXPECT_EQ( cached.as<FakeResource>().name(), "cached" );
+}
+
+TEST(Storage, RebuildOutlivesArguments)
+{
+    auto storage = gfx::GFXStorage();
+    auto res = gfx::GFXRes();
+
+    {
+        auto name = std::string("a name too long for small string optimization");
+        auto bytes = std::size_t(1000u);
+        res = gfx::GFXRes::makeLoaded<FakeResource>(storage, name, bytes);
+    }
+
+    storage.unload( res.id() );
+    storage.advanceFrame();
+
+    EXPECT_EQ( res.as<FakeResource>().name(),
+        "a name too long for small string optimization"
+    );
+    EXPECT_EQ( res.as<FakeResource>().footprint(), 1000u );
+}
+
+TEST(Storage, AsyncLoadPickedUpByShared)
+{
+    auto storage = gfx::GFXStorage();
+    const auto key = gfx::GFXContentKey::make<FakeMesh>(100);
+
+    auto load = storage.loadAsync<FakeMesh>( key,
+        [] { return generateVertices(100u); }
+    );
+    storage.waitAsync();
+    ASSERT_TRUE( load.ready() );
+
+    auto res = gfx::GFXRes::makeShared<FakeMesh>( storage, key,
+        generateVertices(100u)
+    );
+    EXPECT_EQ( res.id(), load.id() );
+    EXPECT_EQ( storage.usage(), 100u * 3u * sizeof(float) );
+}
+
+// resources of mixed sizes, generated on the loading thread
+// against generated by the storage's workers.
+TEST(StorageBenchmark, AsyncLoad)
+{
+    constexpr auto nResource = std::size_t(1000u);
+    constexpr std::size_t nVertices[] = { 1000u, 4000u, 16000u };
+
+    const auto nVertex = [&](std::size_t i) {
+        return nVertices[ i % std::size(nVertices) ];
+    };
+
+    auto timer = Timer<double, std::milli>();
+
+    auto syncStorage = gfx::GFXStorage();
+    auto syncRes = std::vector<gfx::GFXRes>();
+    syncRes.reserve(nResource);
+    for (std::size_t i = 0u; i < nResource; ++i) {
+        syncRes.push_back( gfx::GFXRes::makeShared<FakeMesh>( syncStorage,
+            gfx::GFXContentKey::make<FakeMesh>(i),
+            generateVertices( nVertex(i) )
+        ) );
+    }
+    const auto syncTime = timer.mark();
+
+    auto asyncStorage = gfx::GFXStorage();
+    auto loads = std::vector<gfx::GFXAsyncLoad>();
+    loads.reserve(nResource);
+    for (std::size_t i = 0u; i < nResource; ++i) {
+        loads.push_back( asyncStorage.loadAsync<FakeMesh>(
+            gfx::GFXContentKey::make<FakeMesh>(i),
+            [n = nVertex(i)] { return generateVertices(n); }
+        ) );
+    }
+    asyncStorage.waitAsync();
+    const auto asyncTime = timer.mark();
+
+    for (const auto& load : loads) {
+        ASSERT_TRUE( load.ready() );
+    }
+    EXPECT_EQ( asyncStorage.usage(), syncStorage.usage() );
+
+    std::cout << nResource << " resources loaded\n"
+        << "    synchronous: " << syncTime.count() << "ms\n"
+        << "    asynchronous (" << std::thread::hardware_concurrency()
+        << " hardware threads): " << asyncTime.count() << "ms\n";
+    RecordProperty( "SyncMs", std::to_string( syncTime.count() ) );
+    RecordProperty( "AsyncMs", std::to_string( asyncTime.count() ) );
+}
+
+// readers go through the read table while the writer unloads resources
+// and loads others into the slots released, all within one frame.
+// a reader must see either nothing or the very resource its key was issued for.
+TEST(Storage, ConcurrentReadsWhileLoading)
+{
+    constexpr auto nResource = std::size_t(256u);
+    constexpr auto nFrame = std::size_t(50u);
+    constexpr auto nReader = std::size_t(4u);
+
+    auto storage = gfx::GFXStorage();
+    auto serial = std::size_t(1u);
+    auto live = std::vector< std::pair<gfx::GFXStorage::ID, std::size_t> >();
+
+    const auto load = [&] {
+        const auto bytes = serial++;
+        return std::pair( storage.load<FakeResource>(nullptr, "", bytes).id,
+            bytes
+        );
+    };
+
+    for (std::size_t i = 0u; i < nResource; ++i) {
+        live.push_back( load() );
+    }
+
+    auto nMismatch = std::atomic<std::size_t>(0u);
+    auto nFound = std::atomic<std::size_t>(0u);
+
+    for (std::size_t frame = 0u; frame < nFrame; ++frame) {
+        const auto issued = live;
+        auto bDone = std::atomic<bool>(false);
+
+        auto readers = std::vector<std::thread>();
+        for (std::size_t i = 0u; i < nReader; ++i) {
+            // at least one pass, however late the reader is scheduled.
+            readers.emplace_back( [&] {
+                do {
+                    for (const auto& [id, bytes] : issued) {
+                        if ( auto bindee = storage.get(id) ) {
+                            nFound.fetch_add(1u, std::memory_order_relaxed);
+                            if ( bindee.value()->footprint() != bytes ) {
+                                nMismatch.fetch_add(1u, std::memory_order_relaxed);
+                            }
+                        }
+                    }
+                } while ( !bDone.load(std::memory_order_acquire) );
+            } );
+        }
+
+        // every slot released is taken again at once with a newer generation.
+        for (std::size_t i = 0u; i < nResource; i += 2u) {
+            storage.unload(live[i].first);
+            live[i] = load();
+        }
+
+        bDone.store(true, std::memory_order_release);
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        // no reader may be inside get() while the frame closes.
+        storage.advanceFrame();
+    }
+
+    EXPECT_GT(nFound.load(), 0u);
+    EXPECT_EQ(nMismatch.load(), 0u);
+    EXPECT_EQ(storage.usage(), [&] {
+        auto ret = std::size_t(0u);
+        for (const auto& [_, bytes] : live) {
+            ret += bytes;
+        }
+        return ret;
+    }());
+}
+
+// readers look the tag up without locks while it is cached again and again.
+TEST(Storage, TaggedReadsWhileRecaching)
+{
+    constexpr auto nRecache = std::size_t(2000u);
+    constexpr auto nReader = std::size_t(4u);
+
+    auto storage = gfx::GFXStorage();
+    EXPECT_FALSE( storage.get<RecachedTag>().has_value() );
+
+    auto id = storage.cache<FakeResource>( nullptr, RecachedTag{}, "", 1u ).id;
+
+    auto bDone = std::atomic<bool>(false);
+    auto nFound = std::atomic<std::size_t>(0u);
+    auto nBad = std::atomic<std::size_t>(0u);
+
+    auto readers = std::vector<std::thread>();
+    for (std::size_t i = 0u; i < nReader; ++i) {
+        readers.emplace_back( [&] {
+            do {
+                if ( auto bindee = storage.get<RecachedTag>() ) {
+                    nFound.fetch_add(1u, std::memory_order_relaxed);
+                    const auto bytes = bindee.value()->footprint();
+                    if (bytes == 0u || bytes > nRecache) {
+                        nBad.fetch_add(1u, std::memory_order_relaxed);
+                    }
+                }
+            } while ( !bDone.load(std::memory_order_acquire) );
+        } );
+    }
+
+    for (std::size_t i = 2u; i <= nRecache; ++i) {
+        storage.unload(id);
+        id = storage.cache<FakeResource>( nullptr, RecachedTag{}, "", i ).id;
+    }
+
+    bDone.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_GT(nFound.load(), 0u);
+    EXPECT_EQ(nBad.load(), 0u);
+    ASSERT_TRUE( storage.get<RecachedTag>().has_value() );
+    EXPECT_EQ( storage.get<RecachedTag>().value()->footprint(), nRecache );
+    EXPECT_EQ( storage.get(id), storage.get<RecachedTag>() );
+}
+
+// lookups per millisecond as readers are added, over the same resources.
+TEST(StorageBenchmark, ReadScaling)
+{
+    constexpr auto nResource = std::size_t(10000u);
+    constexpr auto nLookup = std::size_t(1000000u);
+
+    auto storage = gfx::GFXStorage();
+    auto ids = std::vector<gfx::GFXStorage::ID>();
+    for (std::size_t i = 0u; i < nResource; ++i) {
+        ids.push_back( storage.load<FakeResource>(nullptr, "", i).id );
+    }
+
+    auto order = std::vector<std::size_t>(nLookup);
+    auto rng = std::mt19937(42u);
+    auto dist = std::uniform_int_distribution<std::size_t>(0u, nResource - 1u);
+    for (auto& idx : order) {
+        idx = dist(rng);
+    }
+
+    std::cout << nLookup << " lookups per reader over "
+        << nResource << " resources\n";
+
+    for (std::size_t nReader = 1u; nReader <= 8u; nReader *= 2u) {
+        auto nFound = std::atomic<std::size_t>(0u);
+        auto timer = Timer<double, std::milli>();
+
+        auto readers = std::vector<std::thread>();
+        for (std::size_t i = 0u; i < nReader; ++i) {
+            readers.emplace_back( [&] {
+                auto found = std::size_t(0u);
+                for (auto idx : order) {
+                    found += storage.get(ids[idx]).has_value();
+                }
+                nFound.fetch_add(found, std::memory_order_relaxed);
+            } );
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        const auto elapsed = timer.mark();
+        EXPECT_EQ(nFound.load(), nLookup * nReader);
+
+        const auto throughput = static_cast<double>(nLookup * nReader)
+            / elapsed.count();
+        std::cout << "    " << nReader << " readers: "
+            << throughput << " lookups/ms\n";
+        RecordProperty( "LookupsPerMs" + std::to_string(nReader),
+            std::to_string(throughput)
+        );
+
+        storage.advanceFrame();
+    }
+}
@@ -0,0 +1,190 @@
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "MockContext.hpp"
+
+#include "GFX/Core/UploadQueue.hpp"
+
+namespace {
+
+constexpr UINT bufferSize = 64u;
+
+wrl::ComPtr<ID3D11Buffer> makeBuffer(ID3D11Device* pDevice) {
+    const auto desc = D3D11_BUFFER_DESC{
+        .ByteWidth = bufferSize,
+        .Usage = D3D11_USAGE_DEFAULT,
+        .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+        .CPUAccessFlags = 0u,
+        .MiscFlags = 0u,
+        .StructureByteStride = 0u
+    };
+    auto pBuffer = wrl::ComPtr<ID3D11Buffer>();
+    pDevice->CreateBuffer(&desc, nullptr, &pBuffer);
+    return pBuffer;
+}
+
+std::vector<std::byte> makeBytes(std::size_t size, unsigned char value) {
+    return std::vector<std::byte>( size, std::byte(value) );
+}
+
+// bytes [first, last) of an update all hold value.
+bool holds( const MockContext::UpdateCall& update,
+    std::size_t first, std::size_t last, unsigned char value
+) {
+    return std::all_of( update.bytes.begin() + first, update.bytes.begin() + last,
+        [value](std::byte b) { return b == std::byte(value); }
+    );
+}
+
+}   // namespace
+
+TEST(UploadQueue, OverlappingWritesMerge)
+{
+    const auto pDevice = makeWarpDevice();
+    if (!pDevice) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto queue = gfx::GFXUploadQueue();
+    const auto pBuffer = makeBuffer( pDevice.Get() );
+
+    queue.stage( pBuffer, 0u, makeBytes(16u, 1u) );
+    queue.stage( pBuffer, 8u, makeBytes(16u, 2u) );
+    queue.flush(&context);
+
+    ASSERT_EQ(context.updates.size(), 1u);
+    const auto& update = context.updates[0];
+    ASSERT_TRUE(update.bBox);
+    EXPECT_EQ(update.box.left, 0u);
+    EXPECT_EQ(update.box.right, 24u);
+    ASSERT_EQ(update.bytes.size(), 24u);
+    EXPECT_TRUE( holds(update, 0u, 8u, 1u) );
+    // the later write wins.
+    EXPECT_TRUE( holds(update, 8u, 24u, 2u) );
+    EXPECT_TRUE( queue.empty() );
+}
+
+TEST(UploadQueue, AdjacentWritesMerge)
+{
+    const auto pDevice = makeWarpDevice();
+    if (!pDevice) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto queue = gfx::GFXUploadQueue();
+    const auto pBuffer = makeBuffer( pDevice.Get() );
+
+    queue.stage( pBuffer, 16u, makeBytes(16u, 2u) );
+    queue.stage( pBuffer, 0u, makeBytes(16u, 1u) );
+    // apart from both, stays on its own.
+    queue.stage( pBuffer, 48u, makeBytes(8u, 3u) );
+    queue.flush(&context);
+
+    ASSERT_EQ(context.updates.size(), 2u);
+    const auto merged = std::ranges::find_if( context.updates,
+        [](const auto& update) { return update.box.left == 0u; }
+    );
+    ASSERT_NE( merged, context.updates.end() );
+    EXPECT_EQ(merged->box.right, 32u);
+    EXPECT_TRUE( holds(*merged, 0u, 16u, 1u) );
+    EXPECT_TRUE( holds(*merged, 16u, 32u, 2u) );
+
+    const auto apart = std::ranges::find_if( context.updates,
+        [](const auto& update) { return update.box.left == 48u; }
+    );
+    ASSERT_NE( apart, context.updates.end() );
+    EXPECT_EQ(apart->box.right, 56u);
+}
+
+TEST(UploadQueue, SeparateBuffersStaySeparate)
+{
+    const auto pDevice = makeWarpDevice();
+    if (!pDevice) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto queue = gfx::GFXUploadQueue();
+    const auto pFirst = makeBuffer( pDevice.Get() );
+    const auto pSecond = makeBuffer( pDevice.Get() );
+
+    queue.stage( pFirst, 0u, makeBytes(16u, 1u) );
+    queue.stage( pSecond, 0u, makeBytes(16u, 2u) );
+    queue.flush(&context);
+
+    ASSERT_EQ(context.updates.size(), 2u);
+    for (const auto& update : context.updates) {
+        EXPECT_EQ(update.box.right, 16u);
+        EXPECT_TRUE( holds( update, 0u, 16u,
+            update.pResource == pFirst.Get() ? 1u : 2u
+        ) );
+    }
+    EXPECT_NE(context.updates[0].pResource, context.updates[1].pResource);
+}
+
+TEST(UploadQueue, WholeWriteHasNoBox)
+{
+    const auto pDevice = makeWarpDevice();
+    if (!pDevice) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto queue = gfx::GFXUploadQueue();
+    const auto pBuffer = makeBuffer( pDevice.Get() );
+
+    queue.stage( pBuffer, 0u, makeBytes(bufferSize, 1u) );
+    queue.flush(&context);
+
+    ASSERT_EQ(context.updates.size(), 1u);
+    EXPECT_FALSE(context.updates[0].bBox);
+    EXPECT_EQ(context.updates[0].bytes.size(), bufferSize);
+}
+
+TEST(UploadQueue, Counters)
+{
+    const auto pDevice = makeWarpDevice();
+    if (!pDevice) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto queue = gfx::GFXUploadQueue();
+    const auto pFirst = makeBuffer( pDevice.Get() );
+    const auto pSecond = makeBuffer( pDevice.Get() );
+
+    // 3 writes, 2 once merged.
+    queue.stage( pFirst, 0u, makeBytes(16u, 1u) );
+    queue.stage( pFirst, 8u, makeBytes(16u, 2u) );
+    queue.stage( pSecond, 0u, makeBytes(8u, 3u) );
+    queue.flush(&context);
+
+    // nothing is closed until the frame is.
+    EXPECT_EQ(queue.frameCounters().nStaged, 0u);
+    queue.advanceFrame();
+
+    auto frame = queue.frameCounters();
+    EXPECT_EQ(frame.nStaged, 3u);
+    EXPECT_EQ(frame.nUpload, 2u);
+    EXPECT_EQ(frame.nByte, 24u + 8u);
+
+    queue.stage( pSecond, 0u, makeBytes(bufferSize, 4u) );
+    queue.flush(&context);
+    queue.advanceFrame();
+
+    frame = queue.frameCounters();
+    EXPECT_EQ(frame.nStaged, 1u);
+    EXPECT_EQ(frame.nUpload, 1u);
+    EXPECT_EQ(frame.nByte, bufferSize);
+
+    const auto total = queue.totalCounters();
+    EXPECT_EQ(total.nStaged, 4u);
+    EXPECT_EQ(total.nUpload, 3u);
+    EXPECT_EQ(total.nByte, 24u + 8u + bufferSize);
+    EXPECT_EQ(context.updates.size(), 3u);
+}
@@ -0,0 +1,192 @@
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "MockContext.hpp"
+
+#include "GFX/Core/UploadRing.hpp"
+#include "GFX/Core/Pipeline.hpp"
+#include "GFX/Core/Storage.hpp"
+#include "GFX/PipelineObjects/Buffer.hpp"
+#include "GFX/Scenery/TransformDrawContexts.hpp"
+
+namespace {
+
+using TransformCBuf = gfx::po::VSCBuffer<dx::XMMATRIX>;
+
+constexpr std::size_t nDraw = 100u;
+
+// one draw's transform, padded to a whole entry when staged.
+const auto transformBytes = std::vector<std::byte>(sizeof(dx::XMMATRIX));
+
+bool noOverwriteSupported(gfx::GFXFactory factory) {
+    auto options = D3D11_FEATURE_DATA_D3D11_OPTIONS{};
+    return SUCCEEDED( factory.device()->CheckFeatureSupport(
+        D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options)
+    ) ) && options.MapNoOverwriteOnDynamicConstantBuffer;
+}
+
+void stageFrame(gfx::GFXUploadRing& ring, std::size_t n) {
+    ring.beginStaging();
+    for (std::size_t i = 0u; i < n; ++i) {
+        ring.stage(transformBytes);
+    }
+}
+
+}   // namespace
+
+TEST(UploadRing, OneMapPerFrame)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    auto ring = gfx::GFXUploadRing(factory);
+
+    for (std::size_t frame = 0u; frame < 3u; ++frame) {
+        stageFrame(ring, nDraw);
+        ring.upload(pipeline);
+
+        // taken back in the staged order, each at its own aligned entry.
+        auto firstConstant = ring.take().value().firstConstant;
+        for (std::size_t i = 1u; i < nDraw; ++i) {
+            const auto alloc = ring.take();
+            ASSERT_TRUE( alloc.has_value() );
+            EXPECT_EQ( alloc->firstConstant,
+                firstConstant + gfx::GFXUploadRing::alignment / 16u
+            );
+            EXPECT_EQ(alloc->nConstant, gfx::GFXUploadRing::alignment / 16u);
+            firstConstant = alloc->firstConstant;
+        }
+        EXPECT_FALSE( ring.take().has_value() );
+    }
+
+    EXPECT_EQ(context.maps.size(), 3u);
+    EXPECT_EQ(ring.nMap(), 3u);
+}
+
+TEST(UploadRing, DiscardsOnlyOnWrapAround)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    // room for two frames of 6 entries, the third wraps around.
+    auto ring = gfx::GFXUploadRing( factory, 16u * gfx::GFXUploadRing::alignment );
+
+    for (std::size_t frame = 0u; frame < 3u; ++frame) {
+        stageFrame(ring, 6u);
+        ring.upload(pipeline);
+    }
+
+    ASSERT_EQ(context.maps.size(), 3u);
+    EXPECT_EQ(context.maps[0].mapType, D3D11_MAP_WRITE_DISCARD);
+    EXPECT_EQ( context.maps[1].mapType, noOverwriteSupported(factory)
+        ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD
+    );
+    EXPECT_EQ(context.maps[2].mapType, D3D11_MAP_WRITE_DISCARD);
+}
+
+TEST(UploadRing, GrowsForLargeFrame)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    auto ring = gfx::GFXUploadRing( factory, 4u * gfx::GFXUploadRing::alignment );
+
+    stageFrame(ring, nDraw);
+    ring.upload(pipeline);
+
+    EXPECT_GE(ring.capacity(), nDraw * gfx::GFXUploadRing::alignment);
+    EXPECT_EQ(context.maps.size(), 1u);
+    for (std::size_t i = 0u; i < nDraw; ++i) {
+        EXPECT_TRUE( ring.take().has_value() );
+    }
+}
+
+// draw contexts map the transform cbuffer per draw without the ring,
+// and once per frame with it.
+TEST(UploadRing, TransformMapsPerFrame)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto storage = gfx::GFXStorage();
+    auto transformCBuf = gfx::GFXRes::makeLoaded<TransformCBuf>( storage,
+        factory, D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE,
+        std::vector<dx::XMMATRIX>( 1u, dx::XMMatrixIdentity() )
+    );
+    auto mapper = gfx::scenery::MapTransformGPU(storage);
+    mapper.setTCBufID( transformCBuf.id() );
+
+    auto context = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+
+    for (std::size_t i = 0u; i < nDraw; ++i) {
+        mapper.beforeDrawCall(pipeline);
+    }
+    EXPECT_EQ(context.maps.size(), nDraw);
+
+    context.maps.clear();
+    auto pRing = std::make_shared<gfx::GFXUploadRing>(factory);
+    pipeline.setUploadRing(pRing);
+
+    pRing->beginStaging();
+    for (std::size_t i = 0u; i < nDraw; ++i) {
+        mapper.beforeDrawCall(pipeline);
+    }
+    pRing->upload(pipeline);
+    for (std::size_t i = 0u; i < nDraw; ++i) {
+        mapper.beforeDrawCall(pipeline);
+    }
+
+    EXPECT_EQ(context.maps.size(), 1u);
+    EXPECT_FALSE( pRing->take().has_value() );
+}
+
+TEST(UploadRing, NewContextGetsNewRing)
+{
+    const auto factory = gfx::GFXFactory( makeWarpDevice() );
+    if ( !factory.device() ) {
+        GTEST_SKIP() << "no WARP device";
+    }
+
+    auto context = MockContext();
+    auto otherContext = MockContext();
+    auto pipeline = gfx::GFXPipeline(
+        wrl::ComPtr<ID3D11DeviceContext>(&context)
+    );
+    pipeline.setUploadRing( std::make_shared<gfx::GFXUploadRing>(factory) );
+
+    auto copied = pipeline;
+    EXPECT_EQ( copied.uploadRing(), pipeline.uploadRing() );
+
+    copied.setContext( wrl::ComPtr<ID3D11DeviceContext>(&otherContext) );
+    ASSERT_NE( copied.uploadRing(), nullptr );
+    EXPECT_NE( copied.uploadRing(), pipeline.uploadRing() );
+    EXPECT_EQ( copied.uploadRing()->capacity(),
+        pipeline.uploadRing()->capacity()
+    );
+}
@@ -0,0 +1,101 @@
+#ifndef __FixedVector
+#define __FixedVector
+
+#include <array>
+#include <initializer_list>
+#include <algorithm>
+#include <stdexcept>
+#include <concepts>
+#include <cstddef>
+#include <cassert>
+
+// vector of at most N elements stored inline,
+// so copying or building one never touches the heap.
+// elements beyond size() stay default constructed.
+template <class T, std::size_t N>
+    requires std::default_initializable<T> && std::copyable<T>
+class FixedVector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr FixedVector() noexcept
+        : elems_(), size_(0u) {}
+
+    constexpr FixedVector(std::initializer_list<T> init)
+        : elems_(), size_( init.size() ) {
+        if (init.size() > N) {
+            throw std::length_error("FixedVector exceeded its capacity.");
+        }
+        std::ranges::copy(init, elems_.begin());
+    }
+
+    constexpr void push_back(const T& elem) {
+        assert(size_ < N);
+        elems_[size_++] = elem;
+    }
+
+    constexpr void clear() noexcept {
+        size_ = 0u;
+    }
+
+    constexpr T& operator[](size_type idx) noexcept {
+        assert(idx < size_);
+        return elems_[idx];
+    }
+
+    constexpr const T& operator[](size_type idx) const noexcept {
+        assert(idx < size_);
+        return elems_[idx];
+    }
+
+    constexpr T* data() noexcept {
+        return elems_.data();
+    }
+
+    constexpr const T* data() const noexcept {
+        return elems_.data();
+    }
+
+    constexpr iterator begin() noexcept {
+        return data();
+    }
+
+    constexpr const_iterator begin() const noexcept {
+        return data();
+    }
+
+    constexpr iterator end() noexcept {
+        return data() + size_;
+    }
+
+    constexpr const_iterator end() const noexcept {
+        return data() + size_;
+    }
+
+    constexpr size_type size() const noexcept {
+        return size_;
+    }
+
+    static constexpr size_type capacity() noexcept {
+        return N;
+    }
+
+    constexpr bool empty() const noexcept {
+        return size_ == 0u;
+    }
+
+    friend constexpr bool operator==( const FixedVector& lhs,
+        const FixedVector& rhs
+    ) noexcept {
+        return std::ranges::equal(lhs, rhs);
+    }
+
+private:
+    std::array<T, N> elems_;
+    size_type size_;
+};
+
+#endif  // __FixedVector
@@ -0,0 +1,83 @@
+#ifndef __RadixSort
+#define __RadixSort
+
+#include <vector>
+#include <array>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include <concepts>
+#include <functional>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+
+// stable LSD radix sort on 64-bit keys, one byte per pass.
+// a pass is skipped when every key shares its byte,
+// so keys with few varying bits cost few linear passes.
+// scratch must be as large as data, its contents are left unspecified.
+template <class T, class KeyFn>
+    requires std::convertible_to< std::invoke_result_t<KeyFn&, const T&>,
+        std::uint64_t >
+void radixSort(std::span<T> data, std::span<T> scratch, KeyFn key) {
+    static constexpr std::size_t nBucket = 0x100u;
+    static constexpr std::size_t nPass = sizeof(std::uint64_t);
+
+    assert( scratch.size() >= data.size() );
+    if (data.size() < 2u) {
+        return;
+    }
+
+    // histograms of every pass in one read of the keys.
+    auto counts = std::array< std::array<std::size_t, nBucket>, nPass >{};
+    auto keysOr = std::uint64_t(0u);
+    auto keysAnd = ~std::uint64_t(0u);
+
+    for (const auto& elem : data) {
+        const auto k = static_cast<std::uint64_t>( std::invoke(key, elem) );
+        keysOr |= k;
+        keysAnd &= k;
+        for (std::size_t pass = 0u; pass < nPass; ++pass) {
+            ++counts[pass][ (k >> (pass * 8u)) & 0xffu ];
+        }
+    }
+
+    const auto varying = keysOr ^ keysAnd;
+    auto src = data;
+    auto dst = scratch.first( data.size() );
+
+    for (std::size_t pass = 0u; pass < nPass; ++pass) {
+        const auto shift = pass * 8u;
+        if ( ( (varying >> shift) & 0xffu ) == 0u ) {
+            continue;
+        }
+
+        auto offsets = std::array<std::size_t, nBucket>{};
+        auto sum = std::size_t(0u);
+        for (std::size_t bucket = 0u; bucket < nBucket; ++bucket) {
+            offsets[bucket] = sum;
+            sum += counts[pass][bucket];
+        }
+
+        for (auto& elem : src) {
+            const auto k = static_cast<std::uint64_t>( std::invoke(key, elem) );
+            dst[ offsets[ (k >> shift) & 0xffu ]++ ] = std::move(elem);
+        }
+
+        std::swap(src, dst);
+    }
+
+    // odd number of passes left the result in scratch.
+    if ( src.data() != data.data() ) {
+        std::ranges::move(src, data.begin());
+    }
+}
+
+template <class T, class KeyFn>
+void radixSort(std::vector<T>& data, std::vector<T>& scratch, KeyFn key) {
+    scratch.resize( data.size() );
+    radixSort( std::span<T>(data), std::span<T>(scratch), std::move(key) );
+}
+
+#endif  // __RadixSort
@@ -0,0 +1,204 @@
+#ifndef __SlotMap
+#define __SlotMap
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <compare>
+#include <cassert>
+
+// handle of an element stored in SlotMap.
+// generation is bumped each time a slot is released,
+// so a key which outlived its element never matches again.
+struct SlotMapKey {
+    using Index = std::uint32_t;
+    using Generation = std::uint32_t;
+
+    static constexpr Index nullIndex = std::numeric_limits<Index>::max();
+
+    constexpr SlotMapKey() noexcept
+        : index(nullIndex), generation(0u) {}
+
+    constexpr SlotMapKey(Index idx, Generation gen) noexcept
+        : index(idx), generation(gen) {}
+
+    constexpr bool null() const noexcept {
+        return index == nullIndex;
+    }
+
+    friend constexpr auto operator<=>(const SlotMapKey& lhs,
+        const SlotMapKey& rhs) noexcept = default;
+
+    Index index;
+    Generation generation;
+};
+
+// dense, generation-checked handle table.
+// - slots_ maps a key to the position of its element in dense_.
+// - dense_ keeps elements contiguous, erasing swaps with the last one.
+// - released slots are chained through Slot::idxDense as a free list.
+template <class T>
+class SlotMap {
+private:
+    using Index = SlotMapKey::Index;
+    using Generation = SlotMapKey::Generation;
+
+    struct Slot {
+        Index idxDense;     // next free slot while the slot is released
+        Generation generation;
+    };
+
+public:
+    using key_type = SlotMapKey;
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    SlotMap()
+        : slots_(), dense_(), owners_(),
+        freeHead_(key_type::nullIndex) {}
+
+    template <class ... Args>
+    key_type emplace(Args&& ... args) {
+        // a fresh slot goes to the free list first,
+        // so a throwing construction leaves nothing to roll back but owners_.
+        if (freeHead_ == key_type::nullIndex) {
+            slots_.push_back( Slot{ .idxDense = key_type::nullIndex, .generation = 0u } );
+            freeHead_ = static_cast<Index>( slots_.size() - 1u );
+        }
+
+        const auto idxSlot = freeHead_;
+        const auto idxDense = static_cast<Index>( dense_.size() );
+
+        owners_.push_back(idxSlot);
+        try {
+            dense_.emplace_back( std::forward<Args>(args)... );
+        }
+        catch (...) {
+            owners_.pop_back();
+            throw;
+        }
+
+        auto& slot = slots_[idxSlot];
+        freeHead_ = slot.idxDense;
+        slot.idxDense = idxDense;
+
+        return key_type(idxSlot, slot.generation);
+    }
+
+    T* find(const key_type& key) noexcept {
+        if ( !valid(key) ) [[unlikely]] {
+            return nullptr;
+        }
+        return &dense_[ slots_[key.index].idxDense ];
+    }
+
+    const T* find(const key_type& key) const noexcept {
+        return const_cast<SlotMap*>(this)->find(key);
+    }
+
+    T& at(const key_type& key) noexcept {
+        assert( valid(key) );
+        return dense_[ slots_[key.index].idxDense ];
+    }
+
+    const T& at(const key_type& key) const noexcept {
+        return const_cast<SlotMap*>(this)->at(key);
+    }
+
+    bool contains(const key_type& key) const noexcept {
+        return valid(key);
+    }
+
+    bool erase(const key_type& key) {
+        if ( !valid(key) ) {
+            return false;
+        }
+
+        auto& slot = slots_[key.index];
+        const auto idxDense = slot.idxDense;
+        const auto idxLast = static_cast<Index>( dense_.size() - 1u );
+
+        if (idxDense != idxLast) {
+            using std::swap;
+            swap( dense_[idxDense], dense_[idxLast] );
+            owners_[idxDense] = owners_[idxLast];
+            slots_[ owners_[idxDense] ].idxDense = idxDense;
+        }
+
+        ++slot.generation;
+        slot.idxDense = freeHead_;
+        freeHead_ = key.index;
+
+        // the element is moved out and destroyed after the map is consistent,
+        // so that its destructor may reenter.
+        {
+            [[maybe_unused]] auto erased = std::move( dense_.back() );
+            dense_.pop_back();
+            owners_.pop_back();
+        }
+
+        return true;
+    }
+
+    // key of the element at the given dense position.
+    key_type keyAt(size_type idxDense) const noexcept {
+        assert(idxDense < dense_.size());
+        const auto idxSlot = owners_[idxDense];
+        return key_type( idxSlot, slots_[idxSlot].generation );
+    }
+
+    void reserve(size_type n) {
+        slots_.reserve(n);
+        dense_.reserve(n);
+        owners_.reserve(n);
+    }
+
+    void clear() noexcept {
+        while ( !dense_.empty() ) {
+            erase( keyAt(dense_.size() - 1u) );
+        }
+    }
+
+    size_type size() const noexcept {
+        return dense_.size();
+    }
+
+    bool empty() const noexcept {
+        return dense_.empty();
+    }
+
+    iterator begin() noexcept {
+        return dense_.begin();
+    }
+
+    const_iterator begin() const noexcept {
+        return dense_.begin();
+    }
+
+    iterator end() noexcept {
+        return dense_.end();
+    }
+
+    const_iterator end() const noexcept {
+        return dense_.end();
+    }
+
+private:
+    bool valid(const key_type& key) const noexcept {
+        return key.index < slots_.size()
+            && slots_[key.index].generation == key.generation
+            && slots_[key.index].idxDense < dense_.size()
+            && owners_[ slots_[key.index].idxDense ] == key.index;
+    }
+
+    std::vector<Slot> slots_;
+    std::vector<T> dense_;
+    std::vector<Index> owners_;     // dense position -> slot
+    Index freeHead_;
+};
+
+#endif  // __SlotMap
@@ -0,0 +1,96 @@
+#ifndef __ThreadPool
+#define __ThreadPool
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+// fixed-size pool of worker threads consuming a FIFO task queue.
+// destruction waits for running tasks, queued ones are dropped
+// and their futures report std::future_error(broken_promise).
+class ThreadPool {
+public:
+    explicit ThreadPool(
+        std::size_t nThreads = std::max(1u, std::thread::hardware_concurrency())
+    ) : workers_(), tasks_(), mutex_(), cv_(), bStop_(false) {
+        workers_.reserve(nThreads);
+        for (std::size_t i = 0u; i < nThreads; ++i) {
+            workers_.emplace_back( [this]() { work(); } );
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            bStop_ = true;
+        }
+        cv_.notify_all();
+
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <class Fn>
+    auto submit(Fn&& fn) -> std::future< std::invoke_result_t<std::decay_t<Fn>> > {
+        using Result = std::invoke_result_t<std::decay_t<Fn>>;
+
+        // std::function requires copyable callables.
+        auto task = std::make_shared< std::packaged_task<Result()> >(
+            std::forward<Fn>(fn)
+        );
+        auto ret = task->get_future();
+
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.emplace( [task]() { (*task)(); } );
+        }
+        cv_.notify_one();
+
+        return ret;
+    }
+
+    std::size_t size() const noexcept {
+        return workers_.size();
+    }
+
+private:
+    void work() {
+        for (;;) {
+            auto task = std::function<void()>();
+
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait( lock, [this]() { return bStop_ || !tasks_.empty(); } );
+
+                if (bStop_) {
+                    return;
+                }
+
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue< std::function<void()> > tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool bStop_;
+};
+
+#endif  // __ThreadPool